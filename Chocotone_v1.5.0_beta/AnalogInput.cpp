@@ -1,14 +1,40 @@
 #include "AnalogInput.h"
 #include "BleMidi.h"
 #include "Globals.h"
+#include "LedMeter.h"
+#include "MidiCoalescer.h"
+#include "AnalogTrace.h"
 #include "Storage.h"
 #include "SysexScrollData.h"
 #include "UI_Display.h"
 #include <Arduino.h>
 
+// Debug logging helper - only prints when DEBUG_MIDI is defined
+#ifdef DEBUG_MIDI
+#define DBG_MIDI(...) Serial.printf(__VA_ARGS__)
+#else
+#define DBG_MIDI(...) ((void)0)
+#endif
+
 // Global array
 AnalogInputConfig analogInputs[MAX_ANALOG_INPUTS];
 
+// Processing clock - millis() normally, the trace clock during replay
+static bool replayClockActive = false;
+static unsigned long replayClockMs = 0;
+bool analogDryRun = false; // Replay: count outputs instead of sending
+uint32_t analogEmitCount = 0;
+volatile bool analogMeterDirty = false;
+
+unsigned long ainMillis() {
+  return replayClockActive ? replayClockMs : millis();
+}
+
+void setAnalogReplayClock(bool active, unsigned long nowMs) {
+  replayClockActive = active;
+  replayClockMs = nowMs;
+}
+
 uint16_t readOversampled(uint8_t pin) {
   uint32_t sum = 0;
   for (int i = 0; i < OVERSAMPLE_COUNT; i++) {
@@ -59,6 +85,8 @@ void setupAnalogInputs() {
         cfg.smoothedValue = readOversampled(cfg.pin);
       }
       cfg.lastMidiValue = 255;
+      cfg.lastHiResValue = 0xFFFF;
+      memset(cfg.lastScrollIndex, 255, sizeof(cfg.lastScrollIndex));
       cfg.switchState = false;
       cfg.peakValue = 0;
       cfg.isPeakScanning = false;
@@ -84,8 +112,22 @@ bool readMuxDigital(uint8_t channel) {
   return digitalRead(systemConfig.multiplexer.signalPin);
 }
 
+// Expand a 7-bit value to 14 bits (bit-replicated so 127 -> 16383)
+static inline uint16_t expand7to14(uint8_t v) { return (v << 7) | v; }
+
+static bool hasHiResOutput(const AnalogInputConfig &cfg) {
+  for (int i = 0; i < cfg.messageCount; i++) {
+    if (cfg.messages[i].type == CC_14BIT || cfg.messages[i].type == NRPN)
+      return true;
+  }
+  return false;
+}
+
 // Logic to trigger actions based on value/velocity
-void triggerAnalogActions(AnalogInputConfig &cfg, int value, int velocity) {
+// hiRes: full-resolution position (0-AIN_HIRES_MAX) for continuous inputs,
+// -1 for switch/piezo (derived from value)
+void triggerAnalogActions(AnalogInputConfig &cfg, int value, int velocity,
+                          int hiRes = -1) {
   int valuePct = map(value, 0, 127, 0, 100);
 
   for (int i = 0; i < cfg.messageCount; i++) {
@@ -95,6 +137,16 @@ void triggerAnalogActions(AnalogInputConfig &cfg, int value, int velocity) {
     if (valuePct < msg.minInput || valuePct > msg.maxInput)
       continue;
 
+    bool isHiResMsg = (msg.type == CC_14BIT || msg.type == NRPN);
+    // Hi-res trigger that did not move the 7-bit value: nothing new for
+    // 7-bit messages
+    if (hiRes >= 0 && !isHiResMsg && value == cfg.lastMidiValue)
+      continue;
+
+    analogEmitCount++;
+    if (analogDryRun)
+      continue;
+
     // Dispatch based on type
     int outVal = value;
     if (cfg.inputMode == AIN_MODE_POT || cfg.inputMode == AIN_MODE_FSR) {
@@ -105,10 +157,36 @@ void triggerAnalogActions(AnalogInputConfig &cfg, int value, int velocity) {
     }
     outVal = constrain(outVal, 0, 127);
 
+    // Continuous sweeps go through the coalescer (last value wins);
+    // switches keep every edge
+    bool continuous =
+        cfg.inputMode == AIN_MODE_POT || cfg.inputMode == AIN_MODE_FSR;
+
     switch (msg.type) {
     case CC:
-      sendMidiCC(msg.channel, msg.data1, outVal);
+      if (continuous)
+        queueMidiCC(msg.channel, msg.data1, outVal);
+      else
+        sendMidiCC(msg.channel, msg.data1, outVal);
+      break;
+    case CC_14BIT:
+    case NRPN: {
+      uint16_t out14 = expand7to14(outVal);
+      if (hiRes >= 0) {
+        out14 = map(hiRes, 0, AIN_HIRES_MAX, expand7to14(msg.minOut),
+                    expand7to14(msg.maxOut));
+      }
+      uint16_t param = ((uint16_t)msg.data2 << 7) | msg.data1;
+      if (msg.type == CC_14BIT && continuous)
+        queueMidiCC14(msg.channel, msg.data1, out14);
+      else if (msg.type == CC_14BIT)
+        sendMidiCC14(msg.channel, msg.data1, out14, true);
+      else if (continuous)
+        queueMidiNRPN(msg.channel, param, out14);
+      else
+        sendMidiNRPN(msg.channel, param, out14);
       break;
+    }
     case NOTE_ON: // Piezo triggers Note On
       if (cfg.inputMode == AIN_MODE_PIEZO) {
         sendMidiNoteOn(msg.data1, outVal, msg.channel);
@@ -122,57 +200,33 @@ void triggerAnalogActions(AnalogInputConfig &cfg, int value, int velocity) {
     case SYSEX_SCROLL: {
       // Map analog value to list index
       SysexScrollParamId paramId = (SysexScrollParamId)msg.data1;
-      Serial.printf("SYSEX_SCROLL: paramId=%d, outVal=%d\n", paramId, outVal);
-
       const SysexScrollList *list = getSysexScrollList(paramId);
 
       // Fallback to PITCH_HIGH if list not found (workaround for editor issues)
       if (!list) {
-        Serial.printf(
-            "SYSEX_SCROLL: Fallback to PITCH_HIGH (paramId %d not found)\n",
-            paramId);
-        paramId = SYSEX_PARAM_PITCH_HIGH;
-        list = getSysexScrollList(paramId);
+        DBG_MIDI("SYSEX_SCROLL: Fallback to PITCH_HIGH (paramId %d)\n",
+                 paramId);
+        list = getSysexScrollList(SYSEX_PARAM_PITCH_HIGH);
       }
-
-      if (list && list->msgCount > 0) {
-        // Map outVal (0-127) to list index (0 to msgCount-1)
-        int listIndex = map(outVal, 0, 127, 0, list->msgCount - 1);
-        listIndex = constrain(listIndex, 0, list->msgCount - 1);
-        Serial.printf("SYSEX_SCROLL: listIndex=%d/%d\n", listIndex,
-                      list->msgCount);
-
-        // Get message from PROGMEM
-        uint8_t msgLen = 0;
-        const uint8_t *msgData =
-            getSysexScrollMessage(paramId, listIndex, &msgLen);
-        if (msgData && msgLen > 0) {
-          // Copy from PROGMEM to RAM buffer
-          uint8_t buffer[SYSEX_SCROLL_MSG_MAX_LEN];
-          for (int j = 0; j < msgLen && j < SYSEX_SCROLL_MSG_MAX_LEN; j++) {
-            buffer[j] = pgm_read_byte(msgData + j);
-          }
-          // Find actual SysEx length by locating F7 terminator
-          // Messages are padded to 41 bytes but actual content ends at F7
-          int actualLen = msgLen;
-          for (int k = msgLen - 1; k >= 2; k--) {
-            if (buffer[k] == 0xF7) {
-              actualLen = k + 1; // Include F7
-              break;
-            }
-          }
-
-          // Skip the 8080 header - sendSysex() adds its own
-          if (actualLen > 2) {
-            Serial.printf("SYSEX_SCROLL: Sending %d bytes (skip 8080)\n",
-                          actualLen - 2);
-            sendSysex(buffer + 2, actualLen - 2);
-          }
-        } else {
-          Serial.println("SYSEX_SCROLL: No message data!");
-        }
-      } else {
-        Serial.println("SYSEX_SCROLL: List still not found after fallback!");
+      if (!list || list->msgCount == 0)
+        break;
+
+      // Map outVal (0-127) to list index (0 to msgCount-1)
+      int listIndex = map(outVal, 0, 127, 0, list->msgCount - 1);
+      listIndex = constrain(listIndex, 0, list->msgCount - 1);
+
+      // Many pedal steps land on the same entry - only send index changes
+      if (listIndex == cfg.lastScrollIndex[i])
+        break;
+
+      size_t frameLen = 0;
+      const uint8_t *frame = getSysexScrollFrame(list, listIndex, &frameLen);
+      // Straight from flash, no copy. Remember the index only once it went
+      // out, so an entry dropped while disconnected is sent again.
+      if (frame && sendSysexFramed(frame, frameLen)) {
+        cfg.lastScrollIndex[i] = listIndex;
+        DBG_MIDI("SYSEX_SCROLL: param %d idx %d/%d\n", list->id, listIndex,
+                 list->msgCount);
       }
       break;
     }
@@ -183,6 +237,104 @@ void triggerAnalogActions(AnalogInputConfig &cfg, int value, int velocity) {
   }
 }
 
+// Rebuild the fixed-point scale after minVal/maxVal changed
+static void rebuildScale(AnalogInputConfig &cfg) {
+  cfg.scaleMin = cfg.minVal;
+  cfg.scaleMax = cfg.maxVal;
+  int span = (int)cfg.maxVal - (int)cfg.minVal;
+  cfg.scaleQ12 = span > 0 ? ((uint32_t)AIN_HIRES_MAX << 12) / span : 0;
+}
+
+// Linear position 0-AIN_HIRES_MAX of the smoothed value within minVal/maxVal
+static int scaleToHiRes(AnalogInputConfig &cfg) {
+  if (cfg.scaleMin != cfg.minVal || cfg.scaleMax != cfg.maxVal)
+    rebuildScale(cfg);
+  if (cfg.scaleQ12 == 0)
+    return 0;
+
+  // Smoothed value in Q4 keeps the EMA's sub-count detail for 14-bit output.
+  // x <= span * 16, so x * scaleQ12 <= 16 * 16383 * 4096 fits in 32 bits.
+  int32_t x = (int32_t)(cfg.smoothedValue * 16.0f) - (int32_t)cfg.minVal * 16;
+  int32_t xMax = ((int32_t)cfg.maxVal - (int32_t)cfg.minVal) * 16;
+  x = constrain(x, 0, xMax);
+  return ((uint32_t)x * cfg.scaleQ12 + 0x8000) >> 16;
+}
+
+// Write-behind save of calibration results
+static bool calSavePending = false;
+static unsigned long calSaveDueAt = 0;
+
+void scheduleAnalogCalibrationSave(unsigned long delayMs) {
+  if (replayClockActive)
+    return; // Replay restores the bounds afterwards
+  unsigned long due = millis() + delayMs;
+  if (!calSavePending || (long)(due - calSaveDueAt) < 0)
+    calSaveDueAt = due;
+  calSavePending = true;
+}
+
+void serviceAnalogCalibrationSave() {
+  if (!calSavePending || (long)(millis() - calSaveDueAt) < 0)
+    return;
+  calSavePending = false;
+  saveAnalogInputs();
+}
+
+// Background calibration: bounds grow toward readings that stay outside
+// them (single-sample spikes are ignored) and drift slowly inward while the
+// input is being used, so heel/toe dead zones from temperature drift go away
+static void updateAutoCalibration(AnalogInputConfig &cfg, uint16_t raw) {
+  bool changed = false;
+
+  if (raw < cfg.minVal) {
+    if (++cfg.calLowCount >= AIN_AUTOCAL_CONFIRM) {
+      cfg.minVal -= min((int)(cfg.minVal - raw), AIN_AUTOCAL_MAX_STEP);
+      cfg.calLowCount = 0;
+      changed = true;
+    }
+  } else {
+    cfg.calLowCount = 0;
+  }
+
+  if (raw > cfg.maxVal) {
+    if (++cfg.calHighCount >= AIN_AUTOCAL_CONFIRM) {
+      cfg.maxVal += min((int)(raw - cfg.maxVal), AIN_AUTOCAL_MAX_STEP);
+      cfg.calHighCount = 0;
+      changed = true;
+    }
+  } else {
+    cfg.calHighCount = 0;
+  }
+
+  // Slow decay toward the range actually used in the last period
+  if (raw < cfg.calWindowMin)
+    cfg.calWindowMin = raw;
+  if (raw > cfg.calWindowMax)
+    cfg.calWindowMax = raw;
+  unsigned long now = ainMillis();
+  if (now - cfg.calWindowStart >= AIN_AUTOCAL_DECAY_MS) {
+    bool active = cfg.calWindowMax > cfg.calWindowMin &&
+                  cfg.calWindowMax - cfg.calWindowMin >= AIN_AUTOCAL_ACTIVE_SPAN;
+    if (active && cfg.maxVal - cfg.minVal > AIN_AUTOCAL_MIN_SPAN) {
+      if (cfg.calWindowMax < cfg.maxVal) {
+        cfg.maxVal--;
+        changed = true;
+      }
+      if (cfg.calWindowMin > cfg.minVal &&
+          cfg.maxVal - cfg.minVal > AIN_AUTOCAL_MIN_SPAN) {
+        cfg.minVal++;
+        changed = true;
+      }
+    }
+    cfg.calWindowStart = now;
+    cfg.calWindowMin = 4095;
+    cfg.calWindowMax = 0;
+  }
+
+  if (changed)
+    scheduleAnalogCalibrationSave(AIN_AUTOCAL_SAVE_INTERVAL_MS);
+}
+
 // Processing for Continuous Inputs (Pot, FSR)
 void processContinuous(AnalogInputConfig &cfg, uint16_t raw) {
   // EMA Smoothing
@@ -194,60 +346,82 @@ void processContinuous(AnalogInputConfig &cfg, uint16_t raw) {
     cfg.smoothedValue = 0; // Silence noise
   }
 
-  // Map to MIDI 0-127
-  int mapped = map((int)cfg.smoothedValue, cfg.minVal, cfg.maxVal, 0, 127);
+  // Position 0-AIN_HIRES_MAX at full resolution (quantized to 7 bits only at
+  // the end so 14-bit outputs keep the filtered ADC detail)
+  int hiRes = scaleToHiRes(cfg);
   if (cfg.inverted)
-    mapped = 127 - mapped;
-  mapped = constrain(mapped, 0, 127);
+    hiRes = AIN_HIRES_MAX - hiRes;
 
   // Apply Curves (v1.5)
   if (cfg.actionType == AIN_ACTION_LOG || cfg.actionType == AIN_ACTION_EXP) {
-    float x = (float)mapped / 127.0f;
-    float y = x;
     float k = cfg.curve;
     if (k > 0) {
+      float pos = (float)hiRes / AIN_HIRES_MAX;
       if (cfg.actionType == AIN_ACTION_LOG) {
-        y = log(1.0f + k * x) / log(1.0f + k);
+        pos = log(1.0f + k * pos) / log(1.0f + k);
       } else {
-        y = (exp(k * x) - 1.0f) / (exp(k) - 1.0f);
+        pos = (exp(k * pos) - 1.0f) / (exp(k) - 1.0f);
       }
+      hiRes = (int)(constrain(pos, 0.0f, 1.0f) * AIN_HIRES_MAX + 0.5f);
     }
-    mapped = (int)(y * 127.0f);
   } else if (cfg.actionType == AIN_ACTION_JOYSTICK) {
-    int adc = (int)cfg.smoothedValue;
-    int dz = (cfg.maxVal - cfg.minVal) *
-             (cfg.deadzone / 200.0f); // Half for each side
-    if (adc > cfg.center + dz) {
-      mapped = map(adc, cfg.center + dz, cfg.maxVal, 64, 127);
-    } else if (adc < cfg.center - dz) {
-      mapped = map(adc, cfg.minVal, cfg.center - dz, 0, 64);
+    float pos;
+    float adc = cfg.smoothedValue;
+    float dz = (cfg.maxVal - cfg.minVal) *
+               (cfg.deadzone / 200.0f); // Half for each side
+    float hiEdge = cfg.center + dz;
+    float loEdge = cfg.center - dz;
+    if (adc > hiEdge && cfg.maxVal > hiEdge) {
+      pos = 0.5f + 0.5f * (adc - hiEdge) / (cfg.maxVal - hiEdge);
+    } else if (adc < loEdge && loEdge > cfg.minVal) {
+      pos = 0.5f * (adc - cfg.minVal) / (loEdge - cfg.minVal);
     } else {
-      mapped = 64;
+      pos = 0.5f;
     }
+    pos = constrain(pos, 0.0f, 1.0f);
+    hiRes = (int)(pos * AIN_HIRES_MAX + 0.5f);
   }
 
-  // Hysteresis
-  if (abs(mapped - (int)cfg.lastMidiValue) > cfg.hysteresis ||
-      cfg.lastMidiValue == 255) {
-    triggerAnalogActions(cfg, mapped, 0);
-    cfg.lastMidiValue = mapped;
+  // Meter follows in steps, but always lands exactly on the end stops
+  int meterDelta = abs(hiRes - (int)cfg.meterPos);
+  if (!analogDryRun &&
+      (meterDelta >= AIN_METER_STEP ||
+       (meterDelta > 0 && (hiRes == 0 || hiRes == AIN_HIRES_MAX)))) {
+    cfg.meterPos = hiRes;
+    analogMeterDirty = true;
+    ledMeterSet(&cfg - analogInputs, hiRes); // Drawn with the next LED frame
+  }
 
-    // LED Feedback (v1.5)
-    if (cfg.ledIndex >= 0 &&
-        cfg.ledIndex <
-            NUM_LEDS) { // v1.5.5: Use NUM_LEDS instead of hardcoded 10
-      // Scale brightness based on value (0-127)
-      uint8_t r = (uint16_t)cfg.rgb[0] * mapped / 127;
-      uint8_t g = (uint16_t)cfg.rgb[1] * mapped / 127;
-      uint8_t b = (uint16_t)cfg.rgb[2] * mapped / 127;
-      updateIndividualLed(cfg.ledIndex, r, g, b);
+  int mapped = hiRes * 127 / AIN_HIRES_MAX;
+
+  // Hysteresis - in the 14-bit domain (plus rate limit) when any message is
+  // hi-res, so the 7-bit quantization does not hide the extra resolution
+  bool changed;
+  if (hasHiResOutput(cfg)) {
+    unsigned long now = ainMillis();
+    int hyst = cfg.hysteresis * AIN_HIRES_HYST_SCALE;
+    changed = cfg.lastHiResValue == 0xFFFF ||
+              (abs(hiRes - (int)cfg.lastHiResValue) > hyst &&
+               now - cfg.lastHiResSendTime >= AIN_HIRES_MIN_INTERVAL_MS);
+    if (changed) {
+      triggerAnalogActions(cfg, mapped, 0, hiRes);
+      cfg.lastHiResValue = hiRes;
+      cfg.lastHiResSendTime = now;
     }
+  } else {
+    changed = abs(mapped - (int)cfg.lastMidiValue) > cfg.hysteresis ||
+              cfg.lastMidiValue == 255;
+    if (changed)
+      triggerAnalogActions(cfg, mapped, 0);
   }
+
+  if (changed)
+    cfg.lastMidiValue = mapped;
 }
 
 // Processing for Piezo (Peak Detect)
 void processPiezo(AnalogInputConfig &cfg, uint16_t raw) {
-  unsigned long now = millis();
+  unsigned long now = ainMillis();
 
   // 1. Masking Window (Debounce)
   if (cfg.isInMask) {
@@ -305,7 +479,50 @@ void processSwitch(AnalogInputConfig &cfg, uint16_t raw) {
   }
 }
 
+void processAnalogSample(AnalogInputConfig &cfg, uint16_t raw) {
+  if (cfg.calibrating) {
+    if (raw < cfg.calMinSeen)
+      cfg.calMinSeen = raw;
+    if (raw > cfg.calMaxSeen)
+      cfg.calMaxSeen = raw;
+  } else if (cfg.autoCalibrate && cfg.inputMode == AIN_MODE_POT) {
+    // Pots only: an idle FSR rests below its threshold and would drag minVal
+    // down to the unpressed reading
+    updateAutoCalibration(cfg, raw);
+  }
+
+  switch (cfg.inputMode) {
+  case AIN_MODE_PIEZO:
+    processPiezo(cfg, raw);
+    break;
+  case AIN_MODE_SWITCH:
+    processSwitch(cfg, raw);
+    break;
+  case AIN_MODE_POT:
+  case AIN_MODE_FSR:
+  default:
+    processContinuous(cfg, raw);
+    break;
+  }
+}
+
+// Forget the SysEx scroll entries already sent; the receiver's state is
+// unknown after a reconnect and the entries belong to the previous preset
+static void resetScrollIndices() {
+  for (int i = 0; i < MAX_ANALOG_INPUTS; i++)
+    memset(analogInputs[i].lastScrollIndex, 255,
+           sizeof(analogInputs[i].lastScrollIndex));
+}
+
 void readAnalogInputs() {
+  static int scrollPreset = -1;
+  static bool scrollLinkUp = false;
+  if (currentPreset != scrollPreset || clientConnected != scrollLinkUp) {
+    resetScrollIndices();
+    scrollPreset = currentPreset;
+    scrollLinkUp = clientConnected;
+  }
+
   for (int i = 0; i < MAX_ANALOG_INPUTS; i++) {
     AnalogInputConfig &cfg = analogInputs[i];
     if (!cfg.enabled && !systemConfig.debugAnalogIn)
@@ -319,19 +536,10 @@ void readAnalogInputs() {
     uint16_t raw = (cfg.source == AIN_SOURCE_MUX) ? readMux(cfg.pin)
                                                   : readOversampled(cfg.pin);
 
-    switch (cfg.inputMode) {
-    case AIN_MODE_PIEZO:
-      processPiezo(cfg, raw);
-      break;
-    case AIN_MODE_SWITCH:
-      processSwitch(cfg, raw);
-      break;
-    case AIN_MODE_POT:
-    case AIN_MODE_FSR:
-    default:
-      processContinuous(cfg, raw);
-      break;
-    }
+    if (analogCaptureActive)
+      recordAnalogSample(i, raw, now);
+
+    processAnalogSample(cfg, raw);
   }
 }
 
@@ -349,7 +557,7 @@ void stopCalibration(uint8_t index) {
     if (analogInputs[index].calMaxSeen - analogInputs[index].calMinSeen > 100) {
       analogInputs[index].minVal = analogInputs[index].calMinSeen;
       analogInputs[index].maxVal = analogInputs[index].calMaxSeen;
-      saveAnalogInputs(); // Save immediately
+      scheduleAnalogCalibrationSave(AIN_CAL_SAVE_DELAY_MS);
     }
   }
 }
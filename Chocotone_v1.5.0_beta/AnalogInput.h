@@ -11,6 +11,23 @@
 #define DEFAULT_HYSTERESIS 3
 #define ANALOG_READ_INTERVAL_MS 2 // Faster read (500Hz) for Piezo
 
+// High-resolution output (CC_14BIT / NRPN)
+#define AIN_HIRES_MAX 16383           // 14-bit full scale
+#define AIN_HIRES_HYST_SCALE 4        // hysteresis is in 12-bit ADC counts
+#define AIN_HIRES_MIN_INTERVAL_MS 10  // Max ~100 hi-res updates/s per input
+
+// Background auto-calibration (autoCalibrate)
+#define AIN_AUTOCAL_CONFIRM 8          // Samples past a bound before it moves
+#define AIN_AUTOCAL_MAX_STEP 64        // Max ADC counts a bound grows per step
+#define AIN_AUTOCAL_DECAY_MS 10000     // One count of inward drift per period
+#define AIN_AUTOCAL_ACTIVE_SPAN 200    // Movement needed in a period to decay
+#define AIN_AUTOCAL_MIN_SPAN 400       // Bounds never get closer than this
+#define AIN_CAL_SAVE_DELAY_MS 2000     // Write-behind after manual calibration
+#define AIN_AUTOCAL_SAVE_INTERVAL_MS 300000 // At most one auto save per 5 min
+
+// Main screen meter (analog bars): position change that flags a redraw
+#define AIN_METER_STEP 64 // ~0.4% - finer than one pixel of a 64 px bar
+
 // Input Modes
 enum AnalogInputMode : uint8_t {
   AIN_MODE_POT = 0,
@@ -30,6 +47,13 @@ enum AnalogActionType : uint8_t {
   AIN_ACTION_JOYSTICK = 3
 };
 
+// LED feedback over the input's LED segments (LedMeter.h)
+enum AnalogLedStyle : uint8_t {
+  AIN_LED_LEVEL = 0, // All LEDs in rgb, brightness = position
+  AIN_LED_BAR = 1,   // Bargraph in rgb, length = position
+  AIN_LED_VU = 2     // Bargraph green/yellow/red with falling peak LED
+};
+
 // Analog Input Configuration
 struct AnalogInputConfig {
   // Configuration (saved to SPIFFS)
@@ -72,8 +96,13 @@ struct AnalogInputConfig {
   uint8_t messageCount = 0;
   ActionMessage messages[4]; // Fixed max 4 messages per input
 
+  // Track min/max continuously (POT/FSR), updating minVal/maxVal
+  bool autoCalibrate = false;
+  AnalogLedStyle ledStyle = AIN_LED_LEVEL;
+
   // Runtime state (not saved)
   float smoothedValue = 0;
+  uint16_t meterPos = 0; // Output position 0-AIN_HIRES_MAX shown by the meter
   uint16_t peakValue = 0;
   unsigned long peakStartTime = 0;
   unsigned long maskEndTime = 0;
@@ -81,6 +110,9 @@ struct AnalogInputConfig {
   bool isPeakScanning = false;
 
   uint8_t lastMidiValue = 255;
+  uint16_t lastHiResValue = 0xFFFF; // Last 14-bit value sent (0xFFFF = none)
+  unsigned long lastHiResSendTime = 0;
+  uint8_t lastScrollIndex[4] = {255, 255, 255, 255}; // Per message (SYSEX_SCROLL)
   unsigned long lastReadTime = 0;
   bool switchState = false; // For switch mode
 
@@ -88,15 +120,46 @@ struct AnalogInputConfig {
   bool calibrating = false;
   uint16_t calMinSeen = 4095;
   uint16_t calMaxSeen = 0;
+
+  // Auto-calibration state
+  uint8_t calLowCount = 0;  // Consecutive samples below minVal
+  uint8_t calHighCount = 0; // Consecutive samples above maxVal
+  uint16_t calWindowMin = 4095;
+  uint16_t calWindowMax = 0;
+  unsigned long calWindowStart = 0;
+
+  // Fixed-point mapping, rebuilt when minVal/maxVal change
+  uint16_t scaleMin = 0;
+  uint16_t scaleMax = 0;    // 0 = not built yet
+  uint32_t scaleQ12 = 0;    // AIN_HIRES_MAX per ADC count, Q12
 };
 
+// Saved part of AnalogInputConfig: everything before the runtime block.
+// New persistent fields must go right after messages[] so older files
+// still load (the loader copies the common prefix).
+#define AIN_PERSISTED_SIZE offsetof(AnalogInputConfig, smoothedValue)
+// Prefix written by v1 files (raw array incl. runtime state)
+#define AIN_V1_PERSISTED_SIZE                                                  \
+  (offsetof(AnalogInputConfig, messages) + 4 * sizeof(ActionMessage))
+
 // Function declarations
 void setupAnalogInputs();
 void readAnalogInputs(); // Called from main loop()
 void startCalibration(uint8_t index);
 void stopCalibration(uint8_t index);
+void scheduleAnalogCalibrationSave(unsigned long delayMs);
+void serviceAnalogCalibrationSave(); // Called from main loop()
 uint16_t readOversampled(uint8_t pin);
 bool readMuxDigital(uint8_t channel);
+void processAnalogSample(AnalogInputConfig &cfg, uint16_t raw);
+
+// Processing clock and output gate (trace replay, see AnalogTrace.h)
+unsigned long ainMillis();
+void setAnalogReplayClock(bool active, unsigned long nowMs);
+extern bool analogDryRun;
+extern uint32_t analogEmitCount;
+// Set when a meterPos moved by AIN_METER_STEP; loop() requests a redraw
+extern volatile bool analogMeterDirty;
 
 // External array declaration
 extern AnalogInputConfig analogInputs[MAX_ANALOG_INPUTS];
@@ -0,0 +1,237 @@
+#include "AnalogTrace.h"
+#include "MidiCoalescer.h"
+#include "Storage.h"
+#include <SPIFFS.h>
+
+bool analogCaptureActive = false;
+
+static File traceFile;
+static AnalogTraceRecord traceBuffer[AIN_TRACE_BUFFER_RECORDS];
+static uint16_t traceBuffered = 0;
+static uint16_t traceMask = 0;
+static unsigned long traceLastMs = 0;
+static unsigned long traceEndMs = 0;
+static size_t traceBytes = 0;
+
+static void flushTraceBuffer() {
+  if (traceBuffered == 0 || !traceFile)
+    return;
+  size_t len = traceBuffered * sizeof(AnalogTraceRecord);
+  traceFile.write((uint8_t *)traceBuffer, len);
+  traceBytes += len;
+  traceBuffered = 0;
+}
+
+bool startAnalogCapture(uint16_t inputMask, uint32_t durationMs) {
+  if (analogCaptureActive)
+    stopAnalogCapture();
+  if (inputMask == 0)
+    return false;
+
+  if (!mountStorage()) {
+    Serial.println("ERROR: SPIFFS mount failed!");
+    return false;
+  }
+  traceFile = SPIFFS.open(AIN_TRACE_FILE, FILE_WRITE);
+  if (!traceFile) {
+    Serial.println("ERROR: Failed to open trace file for writing!");
+    return false;
+  }
+
+  unsigned long now = millis();
+  AnalogTraceHeader hdr = {AIN_TRACE_MAGIC,
+                           AIN_TRACE_VERSION,
+                           sizeof(AnalogTraceRecord),
+                           inputMask,
+                           (uint32_t)now,
+                           ANALOG_READ_INTERVAL_MS,
+                           0};
+  traceFile.write((uint8_t *)&hdr, sizeof(hdr));
+
+  traceMask = inputMask;
+  traceBuffered = 0;
+  traceBytes = sizeof(hdr);
+  traceLastMs = now;
+  traceEndMs = now + durationMs;
+  analogCaptureActive = true;
+  Serial.printf("Analog capture started (mask=0x%04X, %lums)\n", inputMask,
+                (unsigned long)durationMs);
+  return true;
+}
+
+void stopAnalogCapture() {
+  if (!analogCaptureActive)
+    return;
+  analogCaptureActive = false;
+  flushTraceBuffer();
+  traceFile.close();
+  Serial.printf("Analog capture stopped (%d bytes)\n", traceBytes);
+}
+
+void recordAnalogSample(uint8_t index, uint16_t raw, unsigned long now) {
+  if (!(traceMask & (1 << index)))
+    return;
+
+  // Long gaps are split so dtMs never overflows (0xFFFF = time-only record)
+  while (now - traceLastMs >= 0xFFFF) {
+    traceLastMs += 0xFFFF;
+    traceBuffer[traceBuffered++] = {0xFFFF, 0xFFFF}; // Time-only record
+    if (traceBuffered >= AIN_TRACE_BUFFER_RECORDS)
+      flushTraceBuffer();
+  }
+
+  AnalogTraceRecord &rec = traceBuffer[traceBuffered++];
+  rec.dtMs = now - traceLastMs;
+  rec.inputRaw = ((uint16_t)index << 12) | (raw & 0x0FFF);
+  traceLastMs = now;
+
+  if (traceBuffered >= AIN_TRACE_BUFFER_RECORDS)
+    flushTraceBuffer();
+
+  if ((long)(now - traceEndMs) >= 0 || traceBytes >= AIN_TRACE_MAX_BYTES)
+    stopAnalogCapture();
+}
+
+// Feed a captured trace through processAnalogSample() with the current
+// input settings, on the trace's own clock. With sendMidi=false outputs are
+// only counted (dry run).
+bool replayAnalogTrace(bool sendMidi, AnalogReplayResult &result) {
+  memset(&result, 0, sizeof(result));
+  if (analogCaptureActive)
+    return false;
+  if (!mountStorage() || !SPIFFS.exists(AIN_TRACE_FILE))
+    return false;
+
+  File file = SPIFFS.open(AIN_TRACE_FILE, FILE_READ);
+  if (!file)
+    return false;
+
+  AnalogTraceHeader hdr;
+  if (file.read((uint8_t *)&hdr, sizeof(hdr)) != sizeof(hdr) ||
+      hdr.magic != AIN_TRACE_MAGIC || hdr.version != AIN_TRACE_VERSION ||
+      hdr.recordSize != sizeof(AnalogTraceRecord)) {
+    file.close();
+    Serial.println("Invalid analog trace file");
+    return false;
+  }
+
+  unsigned long clock = hdr.startMs;
+  bool seeded[MAX_ANALOG_INPUTS] = {false};
+  unsigned long lastMove[MAX_ANALOG_INPUTS] = {0};
+  unsigned long lastEmit[MAX_ANALOG_INPUTS] = {0};
+  uint16_t moveRef[MAX_ANALOG_INPUTS] = {0};
+  uint64_t cpuTotal = 0;
+
+  // Auto-calibration may move the bounds during replay
+  uint16_t savedMin[MAX_ANALOG_INPUTS], savedMax[MAX_ANALOG_INPUTS];
+  for (int i = 0; i < MAX_ANALOG_INPUTS; i++) {
+    savedMin[i] = analogInputs[i].minVal;
+    savedMax[i] = analogInputs[i].maxVal;
+  }
+
+  uint32_t emitStart = analogEmitCount;
+  analogDryRun = !sendMidi;
+  // With MIDI, continuous values go through the coalescer on the trace
+  // clock, flushed after every sample like loop() does
+  unsigned long lastQueued = 0, lastSent = 0;
+  uint32_t queued = coalesceStats.queued, sent = coalesceStats.sent;
+  uint32_t sentStart = sent;
+  if (sendMidi) {
+    for (uint8_t t = 0; t < MIDI_OUT_COUNT; t++)
+      resetMidiCoalescer((MidiTransport)t);
+  }
+  AnalogTraceRecord chunk[64];
+  size_t got;
+  while ((got = file.read((uint8_t *)chunk, sizeof(chunk))) >=
+         sizeof(AnalogTraceRecord)) {
+    size_t count = got / sizeof(AnalogTraceRecord);
+    for (size_t r = 0; r < count; r++) {
+      clock += chunk[r].dtMs;
+      if (chunk[r].dtMs == 0xFFFF)
+        continue; // Time-only record
+
+      uint8_t idx = chunk[r].inputRaw >> 12;
+      uint16_t raw = chunk[r].inputRaw & 0x0FFF;
+      AnalogInputConfig &cfg = analogInputs[idx];
+
+      if (!seeded[idx]) {
+        // Same start state as setupAnalogInputs()
+        cfg.smoothedValue = raw;
+        cfg.lastMidiValue = 255;
+        cfg.lastHiResValue = 0xFFFF;
+        memset(cfg.lastScrollIndex, 255, sizeof(cfg.lastScrollIndex));
+        cfg.isPeakScanning = false;
+        cfg.isInMask = false;
+        cfg.switchState = false;
+        cfg.calLowCount = cfg.calHighCount = 0;
+        cfg.calWindowStart = clock;
+        moveRef[idx] = raw;
+        seeded[idx] = true;
+      }
+      // "Movement" = raw moved more than ~1% since the last movement
+      if (abs((int)raw - (int)moveRef[idx]) > 40) {
+        moveRef[idx] = raw;
+        lastMove[idx] = clock;
+      }
+
+      setAnalogReplayClock(true, clock);
+      uint32_t before = analogEmitCount;
+      unsigned long t0 = micros();
+      processAnalogSample(cfg, raw);
+      uint32_t cpu = micros() - t0;
+
+      if (analogEmitCount != before)
+        lastEmit[idx] = clock;
+      if (sendMidi) {
+        flushMidiCoalescer();
+        if (coalesceStats.queued != queued)
+          lastQueued = clock;
+        if (coalesceStats.sent != sent)
+          lastSent = clock;
+        queued = coalesceStats.queued;
+        sent = coalesceStats.sent;
+      }
+      cpuTotal += cpu;
+      if (cpu > result.cpuMaxUs)
+        result.cpuMaxUs = cpu;
+      result.samples++;
+    }
+    yield();
+  }
+  file.close();
+
+  if (sendMidi) {
+    // Let the rate limit release what is still held back
+    for (unsigned long t = clock + 1; t <= clock + 1000 / CC_MAX_RATE_MIN_HZ;
+         t++) {
+      setAnalogReplayClock(true, t);
+      flushMidiCoalescer();
+      if (coalesceStats.sent != sent)
+        lastSent = t;
+      sent = coalesceStats.sent;
+    }
+    if (lastSent > lastQueued)
+      result.wireTailMs = lastSent - lastQueued;
+    result.sent = coalesceStats.sent - sentStart;
+  }
+  result.emitted = analogEmitCount - emitStart;
+  setAnalogReplayClock(false, 0);
+  analogDryRun = false;
+
+  for (int i = 0; i < MAX_ANALOG_INPUTS; i++) {
+    if (seeded[i] && lastEmit[i] > lastMove[i] &&
+        lastEmit[i] - lastMove[i] > result.tailLatencyMs)
+      result.tailLatencyMs = lastEmit[i] - lastMove[i];
+  }
+  result.durationMs = clock - hdr.startMs;
+  if (result.samples > 0)
+    result.cpuAvgUs = cpuTotal / result.samples;
+
+  // Live state was disturbed by the replay - start fresh
+  for (int i = 0; i < MAX_ANALOG_INPUTS; i++) {
+    analogInputs[i].minVal = savedMin[i];
+    analogInputs[i].maxVal = savedMax[i];
+  }
+  setupAnalogInputs();
+  return true;
+}
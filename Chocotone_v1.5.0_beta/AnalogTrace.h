@@ -0,0 +1,58 @@
+#ifndef ANALOG_TRACE_H
+#define ANALOG_TRACE_H
+
+#include "AnalogInput.h"
+#include <Arduino.h>
+
+// ============================================
+// ANALOG TRACE CAPTURE / REPLAY
+// Records raw ADC samples of selected inputs to SPIFFS so pedal jitter and
+// piezo mis-triggers can be replayed through the same processing code with
+// the current settings (on the device, or decoded on a PC with
+// scripts/ain_trace_decode.py).
+//
+// File layout (little endian):
+//   AnalogTraceHeader
+//   N x AnalogTraceRecord, time-ordered
+// ============================================
+
+#define AIN_TRACE_FILE "/ain_trace.bin"
+#define AIN_TRACE_MAGIC 0x54414843 // "CHAT"
+#define AIN_TRACE_VERSION 1
+#define AIN_TRACE_BUFFER_RECORDS 256 // 1KB RAM buffer, flushed when full
+#define AIN_TRACE_MAX_BYTES (256 * 1024)
+
+struct AnalogTraceHeader {
+  uint32_t magic;
+  uint8_t version;
+  uint8_t recordSize;  // sizeof(AnalogTraceRecord)
+  uint16_t inputMask;  // Captured inputs (bit n = A(n+1))
+  uint32_t startMs;    // millis() at capture start
+  uint16_t intervalMs; // ANALOG_READ_INTERVAL_MS at capture time
+  uint16_t reserved;
+};
+
+struct AnalogTraceRecord {
+  uint16_t dtMs;     // ms since the previous record (0xFFFF = time-only)
+  uint16_t inputRaw; // input index << 12 | raw 12-bit ADC value
+};
+
+struct AnalogReplayResult {
+  uint32_t samples;
+  uint32_t emitted;       // MIDI messages the pipeline produced
+  uint32_t cpuAvgUs;      // Processing time per sample
+  uint32_t cpuMaxUs;
+  uint32_t tailLatencyMs; // Last raw movement -> last emitted value (worst)
+  uint32_t wireTailMs;    // sendMidi: last value queued -> on the wire
+  uint32_t sent;          // sendMidi: continuous values on the wire
+  uint32_t durationMs;    // Trace length
+};
+
+extern bool analogCaptureActive;
+
+bool startAnalogCapture(uint16_t inputMask, uint32_t durationMs);
+void stopAnalogCapture();
+void recordAnalogSample(uint8_t index, uint16_t raw, unsigned long now);
+bool replayAnalogTrace(bool sendMidi, AnalogReplayResult &result);
+
+#endif
@@ -1,5 +1,7 @@
 #include "BleMidi.h"
+#include "DisplayTask.h"
 #include "GP5Protocol.h"
+#include "MidiCoalescer.h"
 #include "Storage.h"
 #include "UI_Display.h"
 #include "WebInterface.h"
@@ -60,11 +62,15 @@ class MySecurityCallbacks : public BLESecurityCallbacks {
 class MyClientCallback : public BLEClientCallbacks {
   void onConnect(BLEClient *pclient) {
     clientConnected = true;
+    resetMidiCoalescer(MIDI_OUT_SPM); // New receiver: no "already sent"
     Serial.println("BLE Client Connected");
+    requestDisplay(VIEW_CURRENT, DISPLAY_REASON_MIDI); // Sync status
   }
   void onDisconnect(BLEClient *pclient) {
     clientConnected = false;
+    resetMidiCoalescer(MIDI_OUT_SPM);
     Serial.println("BLE Client Disconnected");
+    requestDisplay(VIEW_CURRENT, DISPLAY_REASON_MIDI); // Sync status
   }
 };
 
@@ -96,12 +102,14 @@ class ServerCallbacks : public BLEServerCallbacks {
   // v1.5.5: Minimal onConnect - let BLE stack handle everything naturally
   void onConnect(BLEServer *pServer, esp_ble_gatts_cb_param_t *param) {
     serverConnected = true;
+    resetMidiCoalescer(MIDI_OUT_DAW);
     Serial.println("BLE Server: Device connected");
   }
 
   void onDisconnect(BLEServer *pServer) {
     serverConnected = false;
     configClientConnected = false;
+    resetMidiCoalescer(MIDI_OUT_DAW);
     Serial.println("BLE Server: Device disconnected");
 
     // Don't use delay() in callback - set flag for main loop to handle
@@ -486,6 +494,7 @@ bool connectToServer() {
     pRemoteCharacteristic->registerForNotify(notifyCallback);
 
   clientConnected = true;
+  resetMidiCoalescer(MIDI_OUT_SPM); // Characteristic ready - start clean
   return true;
 }
 
@@ -627,6 +636,94 @@ void sendMidiPC(byte ch, byte n) {
   }
 }
 
+bool isMidiOutConnected(MidiTransport t) {
+  switch (t) {
+  case MIDI_OUT_USB:
+#if defined(CONFIG_IDF_TARGET_ESP32S3)
+    return systemConfig.bleMode == MIDI_USB_ONLY;
+#else
+    return false;
+#endif
+  case MIDI_OUT_SPM:
+    return systemConfig.bleMode != MIDI_USB_ONLY && clientConnected &&
+           pRemoteCharacteristic;
+  case MIDI_OUT_DAW:
+    return systemConfig.bleMode != MIDI_USB_ONLY && serverConnected &&
+           pServerMidiCharacteristic;
+  default:
+    return false;
+  }
+}
+
+// Send CC messages (pairs of controller,value) to one transport. On BLE all
+// pairs go out in a single packet, each with its own 0x80 timestamp byte.
+// No logging here - this is the hot path for continuous controllers.
+void sendControlChangesTo(MidiTransport t, byte ch, const uint8_t *ccPairs,
+                          uint8_t pairCount) {
+  if (ch < 1)
+    ch = 1;
+  if (ch > 16)
+    ch = 16;
+  if (pairCount == 0 || pairCount > 4)
+    return;
+
+#if defined(CONFIG_IDF_TARGET_ESP32S3)
+  if (t == MIDI_OUT_USB) {
+    for (uint8_t i = 0; i < pairCount; i++) {
+      usbMidi.controlChange(ccPairs[i * 2], ccPairs[i * 2 + 1], ch);
+    }
+    yield();
+    return;
+  }
+#endif
+
+  uint8_t status = 0xB0 | ((ch - 1) & 0x0F);
+  uint8_t m[2 + 4 * 4];
+  size_t len = 0;
+  m[len++] = 0x80; // Header (timestamp high)
+  for (uint8_t i = 0; i < pairCount; i++) {
+    m[len++] = 0x80; // Timestamp low
+    m[len++] = status;
+    m[len++] = ccPairs[i * 2] & 0x7F;
+    m[len++] = ccPairs[i * 2 + 1] & 0x7F;
+  }
+
+  if (t == MIDI_OUT_SPM && clientConnected && pRemoteCharacteristic) {
+    pRemoteCharacteristic->writeValue(m, len, false);
+  } else if (t == MIDI_OUT_DAW && serverConnected &&
+             pServerMidiCharacteristic) {
+    pServerMidiCharacteristic->setValue(m, len);
+    pServerMidiCharacteristic->notify();
+  }
+}
+
+static void sendControlChangesToAll(byte ch, const uint8_t *ccPairs,
+                                    uint8_t pairCount) {
+  for (uint8_t t = 0; t < MIDI_OUT_COUNT; t++) {
+    if (isMidiOutConnected((MidiTransport)t))
+      sendControlChangesTo((MidiTransport)t, ch, ccPairs, pairCount);
+  }
+}
+
+// 14-bit CC: MSB on controller n (0-31), LSB on n+32.
+// MSB is only sent when it changed - receivers keep the last MSB, so a small
+// move costs a single LSB message.
+void sendMidiCC14(byte ch, byte n, uint16_t v, bool sendMsb) {
+  uint8_t pairs[4];
+  uint8_t count = buildCC14Pairs(pairs, n, v, sendMsb);
+  sendControlChangesToAll(ch, pairs, count);
+  Serial.printf("→ MIDI: CC14 Ch%d N%d V%d%s\n", ch, n & 0x1F, v,
+                sendMsb ? "" : " (LSB)");
+}
+
+// NRPN: param select (CC99/98) + data entry (CC6/38), sent as one packet
+void sendMidiNRPN(byte ch, uint16_t param, uint16_t v) {
+  uint8_t pairs[8];
+  uint8_t count = buildNRPNPairs(pairs, param, v);
+  sendControlChangesToAll(ch, pairs, count);
+  Serial.printf("→ MIDI: NRPN Ch%d P%d V%d\n", ch, param, v);
+}
+
 void sendDelayTime(int delayMs) {
   if (!clientConnected || !pRemoteCharacteristic) {
     Serial.println("! SPM not connected - cannot send delay time");
@@ -720,6 +817,32 @@ void sendSysex(const uint8_t *data, size_t length) {
   Serial.println();
 }
 
+// Send a SysEx that already carries the 2-byte BLE MIDI header (flash
+// tables). The BLE stack copies the payload itself, so the mapped flash
+// slice is handed over as-is; nothing is logged on this hot path.
+// Returns false when no transport took the message.
+bool sendSysexFramed(const uint8_t *blePacket, size_t length) {
+  if (length <= 2)
+    return false;
+
+#if defined(CONFIG_IDF_TARGET_ESP32S3)
+  if (systemConfig.bleMode == MIDI_USB_ONLY) {
+    for (size_t i = 2; i < length; i++) {
+      usbMidi.write(blePacket[i]);
+    }
+    yield();
+    return true;
+  }
+#endif
+
+  if (!clientConnected || !pRemoteCharacteristic)
+    return false;
+
+  pRemoteCharacteristic->writeValue(const_cast<uint8_t *>(blePacket), length,
+                                    false);
+  return true;
+}
+
 // ============================================
 // BLE SERVER MIDI OUTPUT (to DAW/Apps)
 // ============================================
@@ -1492,7 +1615,6 @@ extern void finalizeConfigUpload();
 // External declarations for preset/UI functions (from Globals.cpp and
 // UI_Display.cpp)
 extern int currentPreset;
-extern void displayOLED();
 extern void updateLeds();
 
 // Static variables for chunked config upload (browser -> device)
@@ -1602,7 +1724,7 @@ void processBleConfigCommand(const String &cmd) {
     int preset = cmd.substring(11).toInt();
     if (preset >= 0 && preset < 4) {
       currentPreset = preset;
-      displayOLED();
+      requestDisplay(VIEW_MAIN, DISPLAY_REASON_CONFIG, DISPLAY_HIGH);
       updateLeds();
       sendBleSingleResponse("OK:PRESET_SET");
       Serial.printf("BLE Config: Preset changed to %d\n", preset);
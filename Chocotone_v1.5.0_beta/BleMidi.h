@@ -16,8 +16,52 @@ void sendMidiNoteOn(byte ch, byte n, byte v);
 void sendMidiNoteOff(byte ch, byte n, byte v);
 void sendMidiCC(byte ch, byte n, byte v);
 void sendMidiPC(byte ch, byte n);
+void sendMidiCC14(byte ch, byte n, uint16_t v, bool sendMsb);
+void sendMidiNRPN(byte ch, uint16_t param, uint16_t v);
 void sendDelayTime(int delayMs);
 void sendSysex(const uint8_t* data, size_t length);
+bool sendSysexFramed(const uint8_t* blePacket, size_t length); // false: not sent
+
+// Per-transport output (used by the CC coalescer)
+enum MidiTransport : uint8_t {
+  MIDI_OUT_USB = 0, // USB MIDI (ESP32-S3, MIDI_USB_ONLY)
+  MIDI_OUT_SPM,     // BLE client link
+  MIDI_OUT_DAW,     // BLE server link
+  MIDI_OUT_COUNT
+};
+bool isMidiOutConnected(MidiTransport t);
+void sendControlChangesTo(MidiTransport t, byte ch, const uint8_t *ccPairs,
+                          uint8_t pairCount);
+
+// Build controller,value pairs for 14-bit messages. Returns pair count.
+inline uint8_t buildCC14Pairs(uint8_t *pairs, byte n, uint16_t v,
+                              bool sendMsb) {
+  n &= 0x1F;
+  if (v > 16383)
+    v = 16383;
+  uint8_t count = 0;
+  if (sendMsb) {
+    pairs[count * 2] = n;
+    pairs[count * 2 + 1] = v >> 7;
+    count++;
+  }
+  pairs[count * 2] = n + 32;
+  pairs[count * 2 + 1] = v & 0x7F;
+  return count + 1;
+}
+inline uint8_t buildNRPNPairs(uint8_t *pairs, uint16_t param, uint16_t v) {
+  if (v > 16383)
+    v = 16383;
+  pairs[0] = 99;
+  pairs[1] = (param >> 7) & 0x7F;
+  pairs[2] = 98;
+  pairs[3] = param & 0x7F;
+  pairs[4] = 6;
+  pairs[5] = v >> 7;
+  pairs[6] = 38;
+  pairs[7] = v & 0x7F;
+  return 4;
+}
 
 // MIDI via Server (to connected DAW/Apps)
 void sendMidiToServer(byte* data, size_t length);
@@ -1,8 +1,13 @@
 #include "AnalogInput.h"
 #include "BleMidi.h"
 #include "Config.h"
+#include "DisplayTask.h"
 #include "Globals.h"
 #include "Input.h"
+#include "LedTask.h"
+#include "MidiCoalescer.h"
+#include "SettingsCache.h"
+#include "OledFlush.h"
 #include "Storage.h"
 #include "UI_Display.h"
 #include "WebInterface.h"
@@ -14,6 +19,13 @@
 #include <USB.h>
 #include <USBMIDI.h>
 USBMIDI usbMidi;
+
+// Host attached, detached, suspended or resumed: CC coalescer starts over
+static void usbEventCallback(void *arg, esp_event_base_t base, int32_t id,
+                             void *data) {
+  if (base == ARDUINO_USB_EVENTS)
+    resetMidiCoalescer(MIDI_OUT_USB);
+}
 #endif
 
 // ============================================================================
@@ -173,6 +185,7 @@ void resolveDisplayPinConflicts() {
 void setup() {
 #if defined(CONFIG_IDF_TARGET_ESP32S3)
   // Enable Native USB for CDC (Serial) and MIDI
+  USB.onEvent(usbEventCallback);
   USB.begin();
   usbMidi.begin();
 #endif
@@ -200,7 +213,7 @@ void setup() {
   } else {
     // OLED uses I2C - use configurable pins from systemConfig
     Wire.begin(systemConfig.oledSdaPin, systemConfig.oledSclPin);
-    Wire.setClock(100000);
+    Wire.setClock(oledBusClock()); // 400kHz, falls back on bus errors
     delay(50);
     Serial.printf("I2C initialized for OLED: SDA=%d, SCL=%d\n",
                   systemConfig.oledSdaPin, systemConfig.oledSclPin);
@@ -388,11 +401,12 @@ void setup() {
 
     // Reinitialize strip with the resolved pin
     strip.updateType(NEO_GRB + NEO_KHZ800);
-    strip.updateLength(NUM_LEDS);
+    strip.updateLength(ledStripLength);
     strip.setPin(systemConfig.ledPin);
     strip.begin();
     strip.show();
-    strip.setBrightness(ledBrightnessOn);
+    ledSetBrightness(ledBrightnessOn); // With gamma, see LedPower.h
+    startLedTask(ledStripLength); // strip.show() runs on core 0 from here
 #if defined(CONFIG_IDF_TARGET_ESP32S3)
   }
 #endif
@@ -431,11 +445,12 @@ void setup() {
   }
 
   // Display and LEDs
+  startDisplayTask(); // Async refreshes from input handlers
+  updateLeds(); // Non-blocking - the LED task pushes the frame
   if (!isWifiOn) {
     displayOLED();
-    updateLeds();
   } else {
-    Serial.println("Skipping OLED/LED/BleScan update due to WiFi On");
+    Serial.println("Skipping OLED/BleScan update due to WiFi On");
     // Optional: Draw simple text on OLED if safe?
     // For now, safety first.
   }
@@ -472,38 +487,20 @@ void loop() {
       static unsigned long lastAnalogDebugRefresh = 0;
       if (millis() - lastAnalogDebugRefresh > 100) { // 10Hz refresh
         lastAnalogDebugRefresh = millis();
-        displayAnalogDebug();
+        requestDisplay(VIEW_ANALOG_DEBUG, DISPLAY_REASON_PERIODIC);
       }
       // Skip normal preset mode when in analog debug
     } else {
       loop_presetMode();
-
-      // Update display to handle button name timeout
-      // SKIP when WiFi is on to prevent crash
-      if (!isWifiOn && buttonNameDisplayUntil > 0 &&
-          millis() >= buttonNameDisplayUntil) {
-        buttonNameDisplayUntil = 0;
-        safeDisplayOLED();
-      }
     }
   }
 
-  // Update LEDs continuously (needed for tap tempo blink)
-  // Skip when WiFi is on (heap too low) or when pending update will do it
-  if (!isWifiOn && !pendingDisplayUpdate) {
-    updateLeds();
-  }
+  // Recompute LEDs that changed or are animating (tap tempo blink); idle
+  // passes return without touching the LEDs
+  serviceLeds();
 
-  // Handle deferred display updates from web interface
-  if (pendingDisplayUpdate) {
-    pendingDisplayUpdate = false;
-    safeDisplayOLED();
-    // Skip LED update if WiFi is on (NeoPixel disables interrupts, crashes
-    // WiFi)
-    if (!isWifiOn) {
-      updateLeds();
-    }
-  }
+  // Write settings changed since the last quiet period (one NVS batch)
+  settingsService();
 
   // Skip BLE operations when WiFi is on (already paused)
   if (!isWifiOn) {
@@ -525,31 +522,18 @@ void loop() {
 
     // Read expression pedals and send MIDI CC
     readAnalogInputs();
-
-    // Throttled display refresh for analog loading bars (TFT only)
-    // Check every 50ms if analog values changed significantly
-    static unsigned long lastAnalogDisplayUpdate = 0;
-    static float lastAnalogDisplayValues[MAX_ANALOG_INPUTS] = {0};
-    if (oledConfig.type == TFT_128X128 && oledConfig.main.showColorStrips) {
-      unsigned long now = millis();
-      if (now - lastAnalogDisplayUpdate >= 50) {
-        lastAnalogDisplayUpdate = now;
-        bool needsRedraw = false;
-        for (int i = 0;
-             i < MAX_ANALOG_INPUTS && i < systemConfig.analogInputCount; i++) {
-          if (analogInputs[i].enabled) {
-            float diff =
-                abs(analogInputs[i].smoothedValue - lastAnalogDisplayValues[i]);
-            if (diff > 122) { // ~3% change threshold (4095 * 0.03)
-              lastAnalogDisplayValues[i] = analogInputs[i].smoothedValue;
-              needsRedraw = true;
-            }
-          }
-        }
-        if (needsRedraw) {
-          updateAnalogColorStrips(); // Partial update - no flicker
-        }
-      }
+    flushMidiCoalescer(); // Send resting values held back by the rate limit
+    serviceAnalogCalibrationSave();
+
+    // Analog meters: the pipeline flags value changes, the scheduler caps
+    // the redraws at DISPLAY_REFRESH_MS (~30 fps) and draws only the bar
+    // columns that moved
+    if (analogMeterDirty) {
+      analogMeterDirty = false;
+      if (oledConfig.main.showColorStrips && currentMode == 0 &&
+          !systemConfig.debugAnalogIn && !inTapTempoMode &&
+          buttonNameDisplayUntil == 0)
+        requestDisplay(VIEW_MAIN, DISPLAY_REASON_ANALOG);
     }
 
     // Periodic display refresh for battery icon and BLE status (every 5 sec)
@@ -561,13 +545,19 @@ void loop() {
       unsigned long now = millis();
       if (now - lastPeriodicDisplayUpdate >= 5000) {
         lastPeriodicDisplayUpdate = now;
-        if (currentMode == 0 && buttonNameDisplayUntil == 0) {
-          displayOLED(); // Refresh main screen
+        if (currentMode == 0 && buttonNameDisplayUntil == 0 &&
+            !systemConfig.debugAnalogIn) {
+          requestDisplay(VIEW_MAIN, DISPLAY_REASON_PERIODIC, DISPLAY_LOW);
         }
       }
     }
   }
 
+  // Safe point: input and MIDI for this pass are done - draw at most one
+  // frame for everything requested above (or from web / BLE callbacks)
+  serviceOledHealth(); // One recovery step if the OLED bus is down
+  serviceDisplay();
+
   // Handle serial commands for offline editor config transfer
   handleSerialConfig();
 
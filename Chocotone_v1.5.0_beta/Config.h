@@ -24,7 +24,8 @@
 #define MAX_BUTTONS 16                   // Maximum supported buttons
 #define DEFAULT_BUTTON_COUNT 8           // Default active buttons
 #define NUM_BUTTONS DEFAULT_BUTTON_COUNT // Backward compatibility
-#define NUM_LEDS MAX_BUTTONS             // LEDs match max buttons
+#define NUM_LEDS MAX_BUTTONS             // Default strip length
+#define MAX_LEDS 300 // Longest strip (ledStripLength); 3 frame buffers
 #define LONG_PRESS_DURATION 500
 #define ENCODER_BUTTON_DEBOUNCE_DELAY                                          \
   100 // Increased from 50 for noise immunity
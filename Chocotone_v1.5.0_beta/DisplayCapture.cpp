@@ -0,0 +1,235 @@
+#include "DisplayCapture.h"
+#include "DisplayTask.h"
+#include "Globals.h"
+#include "TftFrame.h"
+#include "UI_Display.h"
+
+// Adafruit_GFX target that writes one band of the screen into RAM and
+// counts every primitive drawn (Adafruit text and shapes end up here too)
+class ProbeCanvas : public Adafruit_GFX {
+public:
+  ProbeCanvas(int16_t w, int16_t h, uint16_t *buf, bool isMono)
+      : Adafruit_GFX(w, h), buffer(buf), mono(isMono) {}
+
+  void setWindow(int16_t y, int16_t h) {
+    winY = y;
+    winH = h;
+  }
+
+  void drawPixel(int16_t x, int16_t y, uint16_t color) override {
+    if (counting)
+      profile.calls++;
+    plot(x, y, color);
+  }
+
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                uint16_t color) override {
+    if (counting)
+      profile.calls++;
+    int16_t x0 = max(x, (int16_t)0), y0 = max(y, (int16_t)0);
+    int16_t x1 = min((int16_t)(x + w), width());
+    int16_t y1 = min((int16_t)(y + h), height());
+    if (x1 <= x0 || y1 <= y0)
+      return;
+    if (counting)
+      profile.pixels += (uint32_t)(x1 - x0) * (y1 - y0);
+    if (!buffer)
+      return;
+    y0 = max(y0, winY);
+    y1 = min(y1, (int16_t)(winY + winH));
+    for (int16_t row = y0; row < y1; row++)
+      for (int16_t col = x0; col < x1; col++)
+        store(col, row, color);
+  }
+
+  void drawFastHLine(int16_t x, int16_t y, int16_t w,
+                     uint16_t color) override {
+    fillRect(x, y, w, 1, color);
+  }
+
+  void drawFastVLine(int16_t x, int16_t y, int16_t h,
+                     uint16_t color) override {
+    fillRect(x, y, 1, h, color);
+  }
+
+  void fillScreen(uint16_t color) override {
+    fillRect(0, 0, width(), height(), color);
+  }
+
+  DisplayProfile profile = {0, 0, 0};
+  bool counting = true; // Only the first band is counted
+
+private:
+  void plot(int16_t x, int16_t y, uint16_t color) {
+    if (x < 0 || y < 0 || x >= width() || y >= height())
+      return;
+    if (counting)
+      profile.pixels++;
+    if (buffer && y >= winY && y < winY + winH)
+      store(x, y, color);
+  }
+
+  void store(int16_t x, int16_t y, uint16_t color) {
+    uint16_t &p = buffer[(y - winY) * width() + x];
+    if (!mono)
+      p = tftThemeColor(color); // What the palette frame would push
+    else if (color == SSD1306_INVERSE)
+      p = ~p;
+    else
+      p = color ? 0xFFFF : 0x0000;
+  }
+
+  uint16_t *buffer;
+  bool mono;
+  int16_t winY = 0, winH = 0;
+};
+
+static bool captureActive = false;
+
+static const char *const screenNames[CAPTURE_SCREEN_COUNT] = {
+    "current", "main", "menu", "tap", "debug", "edit"};
+
+bool displayCaptureActive() { return captureActive; }
+
+const char *captureScreenName(CaptureScreen screen) {
+  return screen < CAPTURE_SCREEN_COUNT ? screenNames[screen] : "?";
+}
+
+bool parseCaptureScreen(const String &name, CaptureScreen *screen) {
+  if (name.length() == 0) {
+    *screen = CAPTURE_CURRENT;
+    return true;
+  }
+  for (int i = 0; i < CAPTURE_SCREEN_COUNT; i++) {
+    if (name == screenNames[i]) {
+      *screen = (CaptureScreen)i;
+      return true;
+    }
+  }
+  return false;
+}
+
+static void renderScreen(CaptureScreen screen) {
+  if (screen == CAPTURE_CURRENT) {
+    switch (currentDisplayView()) {
+    case VIEW_MENU:
+      displayMenu();
+      return;
+    case VIEW_EDIT_MENU:
+      displayEditMenu();
+      return;
+    case VIEW_ANALOG_DEBUG:
+      displayAnalogDebug();
+      return;
+    default:
+      displayOLED(); // Includes tap tempo and button name overlay
+      return;
+    }
+  }
+  switch (screen) {
+  case CAPTURE_MENU:
+    displayMenu();
+    break;
+  case CAPTURE_TAP_TEMPO:
+    displayTapTempoMode();
+    break;
+  case CAPTURE_ANALOG_DEBUG:
+    displayAnalogDebug();
+    break;
+  case CAPTURE_EDIT_MENU: {
+    EditMenuState state = editMenuState;
+    if (state == EDIT_NONE)
+      editMenuState = EDIT_ROOT; // Not editing: show where editing starts
+    displayEditMenu();
+    editMenuState = state;
+    break;
+  }
+  default:
+    displayOLED();
+    break;
+  }
+}
+
+// Render screen through probe, one band at a time (a single pass if the
+// probe has no buffer). Runs under the display lock.
+static void runProbe(ProbeCanvas &probe, CaptureScreen screen, int16_t rows,
+                     CaptureSink sink, uint16_t *buffer) {
+  int16_t w = probe.width(), h = probe.height();
+  static uint8_t rgbRow[160 * 3];
+
+  Adafruit_GFX *target = displayPtr;
+  displayPtr = &probe;
+  captureActive = true;
+
+  for (int16_t y = 0; y < h; y += rows) {
+    int16_t bh = min(rows, (int16_t)(h - y));
+    probe.setWindow(y, bh);
+    probe.counting = y == 0;
+    unsigned long t0 = micros();
+    renderScreen(screen);
+    if (y == 0)
+      probe.profile.us = micros() - t0;
+    if (!buffer)
+      break;
+
+    for (int16_t r = 0; r < bh; r++) {
+      const uint16_t *px = &buffer[r * w];
+      for (int16_t x = 0; x < w; x++) {
+        uint16_t c = px[x];
+        rgbRow[x * 3] = ((c >> 11) & 0x1F) * 255 / 31;
+        rgbRow[x * 3 + 1] = ((c >> 5) & 0x3F) * 255 / 63;
+        rgbRow[x * 3 + 2] = (c & 0x1F) * 255 / 31;
+      }
+      sink(rgbRow, w * 3);
+    }
+  }
+
+  captureActive = false;
+  displayPtr = target;
+}
+
+bool captureDisplay(CaptureScreen screen, CaptureSink sink,
+                    DisplayProfile *profile) {
+  DisplayLock lock;
+  if (displayPtr == nullptr || oledConfig.type == OLED_NONE)
+    return false;
+
+  int16_t w = displayPtr->width(), h = displayPtr->height();
+  if (w > 160)
+    return false;
+  int16_t rows = min((int16_t)(CAPTURE_BAND_PIXELS / w), h);
+  uint16_t *buffer = (uint16_t *)malloc((size_t)w * rows * sizeof(uint16_t));
+  if (!buffer) {
+    Serial.println("Capture: no heap for band buffer");
+    return false;
+  }
+
+  bool isTft =
+      oledConfig.type == TFT_128X128 || oledConfig.type == TFT_128X160;
+  ProbeCanvas probe(w, h, buffer, !isTft);
+
+  char header[24];
+  int n = snprintf(header, sizeof(header), "P6\n%d %d\n255\n", w, h);
+  sink((const uint8_t *)header, n);
+  runProbe(probe, screen, rows, sink, buffer);
+  free(buffer);
+
+  if (profile)
+    *profile = probe.profile;
+  // Screen functions cancel queued refreshes - put the real frame back
+  requestDisplay(VIEW_CURRENT, DISPLAY_REASON_RECOVERY, DISPLAY_LOW);
+  return true;
+}
+
+bool profileDisplay(CaptureScreen screen, DisplayProfile *profile) {
+  DisplayLock lock;
+  if (displayPtr == nullptr || oledConfig.type == OLED_NONE)
+    return false;
+
+  ProbeCanvas probe(displayPtr->width(), displayPtr->height(), nullptr,
+                    false);
+  runProbe(probe, screen, probe.height(), nullptr, nullptr);
+  *profile = probe.profile;
+  requestDisplay(VIEW_CURRENT, DISPLAY_REASON_RECOVERY, DISPLAY_LOW);
+  return true;
+}
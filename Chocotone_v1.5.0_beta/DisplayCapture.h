@@ -0,0 +1,48 @@
+#ifndef DISPLAY_CAPTURE_H
+#define DISPLAY_CAPTURE_H
+
+#include <Arduino.h>
+
+// ============================================
+// DISPLAY CAPTURE / PROFILE
+// Renders a screen with the real UI code into RAM instead of the panel:
+// displayPtr is pointed at a probe canvas (mono for SSD1306, RGB565 for
+// TFT, current size and rotation) and the screen function is run once per
+// band of CAPTURE_BAND_PIXELS. The panel, the retained scene and the OLED
+// shadow are not touched.
+// The probe also counts draw calls and pixels written, which is what
+// DISPLAY_PROFILE reports per screen.
+// ============================================
+
+#define CAPTURE_BAND_PIXELS 2048 // RGB565 work buffer (4 KB, freed after)
+
+enum CaptureScreen : uint8_t {
+  CAPTURE_CURRENT, // What the scheduler drew last (incl. edit menu, overlays)
+  CAPTURE_MAIN,
+  CAPTURE_MENU,
+  CAPTURE_TAP_TEMPO,
+  CAPTURE_ANALOG_DEBUG,
+  CAPTURE_EDIT_MENU, // Current edit menu page (root if not editing)
+  CAPTURE_SCREEN_COUNT
+};
+
+struct DisplayProfile {
+  uint32_t calls;  // Primitive draw calls (pixel, rect, line, fill)
+  uint32_t pixels; // Pixels written, clipped to the screen
+  uint32_t us;     // CPU time of one render into RAM (no bus traffic)
+};
+
+// Called once per band with RGB888 rows, top to bottom
+typedef void (*CaptureSink)(const uint8_t *rgb, size_t len);
+
+bool displayCaptureActive(); // UI_Display.cpp skips panel-only work
+const char *captureScreenName(CaptureScreen screen);
+bool parseCaptureScreen(const String &name, CaptureScreen *screen);
+
+// Writes a binary PPM (P6) of the screen to sink. false = no display / heap
+bool captureDisplay(CaptureScreen screen, CaptureSink sink,
+                    DisplayProfile *profile = nullptr);
+// Counts only - no pixel buffer needed
+bool profileDisplay(CaptureScreen screen, DisplayProfile *profile);
+
+#endif
@@ -0,0 +1,326 @@
+#include "DisplayScene.h"
+#include "Globals.h"
+
+// Adafruit_GFX target for one band of the screen. Coordinates stay in
+// screen space; everything outside the band window is clipped.
+class BandCanvas16 : public Adafruit_GFX {
+public:
+  BandCanvas16(int16_t w, int16_t h, uint16_t *buf)
+      : Adafruit_GFX(w, h), buffer(buf) {}
+
+  void setWindow(int16_t x, int16_t y, int16_t w, int16_t h) {
+    winX = x;
+    winY = y;
+    winW = w;
+    winH = h;
+  }
+
+  void drawPixel(int16_t x, int16_t y, uint16_t color) override {
+    x -= winX;
+    y -= winY;
+    if (x < 0 || y < 0 || x >= winW || y >= winH)
+      return;
+    buffer[y * winW + x] = color;
+  }
+
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                uint16_t color) override {
+    int16_t x0 = max(x, winX), y0 = max(y, winY);
+    int16_t x1 = min((int16_t)(x + w), (int16_t)(winX + winW));
+    int16_t y1 = min((int16_t)(y + h), (int16_t)(winY + winH));
+    for (int16_t row = y0; row < y1; row++) {
+      uint16_t *p = &buffer[(row - winY) * winW + (x0 - winX)];
+      for (int16_t col = x0; col < x1; col++)
+        *p++ = color;
+    }
+  }
+
+  void drawFastHLine(int16_t x, int16_t y, int16_t w,
+                     uint16_t color) override {
+    fillRect(x, y, w, 1, color);
+  }
+
+  void drawFastVLine(int16_t x, int16_t y, int16_t h,
+                     uint16_t color) override {
+    fillRect(x, y, 1, h, color);
+  }
+
+  void fillScreen(uint16_t color) override {
+    fillRect(winX, winY, winW, winH, color);
+  }
+
+private:
+  uint16_t *buffer;
+  int16_t winX = 0, winY = 0, winW = 0, winH = 0;
+};
+
+struct SceneWidget {
+  int16_t x, y, w, h;
+  uint32_t sig;
+  bool dirty;
+};
+
+enum ScenePass : uint8_t { SCENE_OFF, SCENE_LAYOUT, SCENE_DRAW, SCENE_BAND };
+
+SceneStats sceneStats = {0, 0, 0, 0, 0, 0, 0};
+
+static SceneWidget prevWidgets[SCENE_MAX_WIDGETS];
+static SceneWidget curWidgets[SCENE_MAX_WIDGETS];
+static uint8_t prevCount = 0;
+static uint8_t curCount = 0;
+static uint8_t drawIndex = 0;
+static ScenePass scenePass = SCENE_OFF;
+static bool sceneValid = false;
+static bool sceneOverflow = false; // More widgets than the table holds
+static uint32_t framePixels = 0;
+static uint16_t frameWidgets = 0;
+static uint16_t frameBands = 0;
+static uint16_t *bandBuffer = nullptr;
+static SceneWidget bandClip;
+// Areas the last frame cleared (direct) or pushed (bands)
+static SceneWidget frameRects[SCENE_MAX_WIDGETS];
+static int frameRectCount = 0;
+static bool frameFull = false;
+
+uint32_t sceneHash(const void *data, size_t len, uint32_t seed) {
+  const uint8_t *p = (const uint8_t *)data;
+  uint32_t h = seed;
+  for (size_t i = 0; i < len; i++) {
+    h ^= p[i];
+    h *= 16777619u;
+  }
+  return h;
+}
+
+static inline bool sameRect(const SceneWidget &a, const SceneWidget &b) {
+  return a.x == b.x && a.y == b.y && a.w == b.w && a.h == b.h;
+}
+
+static inline bool overlaps(const SceneWidget &a, const SceneWidget &b) {
+  return a.x < b.x + b.w && b.x < a.x + a.w && a.y < b.y + b.h &&
+         b.y < a.y + a.h;
+}
+
+void sceneInvalidate() { sceneValid = false; }
+
+bool sceneIsValid() { return sceneValid; }
+
+void sceneBeginLayout() {
+  scenePass = SCENE_LAYOUT;
+  curCount = 0;
+  sceneOverflow = false;
+  framePixels = 0;
+  frameWidgets = 0;
+  frameBands = 0;
+  frameRectCount = 0;
+  frameFull = false;
+}
+
+void sceneBeginDraw() {
+  scenePass = SCENE_DRAW;
+  drawIndex = 0;
+
+  if (sceneOverflow && sceneValid) {
+    displayPtr->fillScreen(SCENE_BACKGROUND); // Cannot diff - full repaint
+    sceneValid = false;
+  }
+  if (!sceneValid) {
+    // Screen was cleared by clearDisplayBuffer() - paint everything
+    for (int i = 0; i < curCount; i++)
+      curWidgets[i].dirty = true;
+    framePixels += (uint32_t)displayPtr->width() * displayPtr->height();
+    sceneStats.fullRepaints++;
+    frameFull = true;
+    return;
+  }
+
+  for (int i = 0; i < curCount; i++) {
+    curWidgets[i].dirty = i >= prevCount ||
+                          !sameRect(curWidgets[i], prevWidgets[i]) ||
+                          curWidgets[i].sig != prevWidgets[i].sig;
+  }
+
+  // Clear where changed or removed widgets used to be
+  SceneWidget *cleared = frameRects;
+  int &clearedCount = frameRectCount;
+  for (int i = 0; i < prevCount; i++) {
+    if (i < curCount && !curWidgets[i].dirty)
+      continue;
+    SceneWidget &r = prevWidgets[i];
+    if (r.w <= 0 || r.h <= 0)
+      continue;
+    displayPtr->fillRect(r.x, r.y, r.w, r.h, SCENE_BACKGROUND);
+    framePixels += (uint32_t)r.w * r.h;
+    cleared[clearedCount++] = r;
+  }
+
+  // Unchanged widgets hit by a clear are repainted in place
+  for (int i = 0; i < curCount; i++) {
+    if (curWidgets[i].dirty)
+      continue;
+    for (int c = 0; c < clearedCount; c++) {
+      if (overlaps(curWidgets[i], cleared[c])) {
+        curWidgets[i].dirty = true;
+        break;
+      }
+    }
+  }
+}
+
+void sceneEnd() {
+  memcpy(prevWidgets, curWidgets, sizeof(SceneWidget) * curCount);
+  prevCount = curCount;
+  scenePass = SCENE_OFF;
+  sceneValid = true;
+
+  sceneStats.frames++;
+  sceneStats.lastPixels = framePixels;
+  sceneStats.lastWidgets = frameWidgets;
+  sceneStats.lastBands = frameBands;
+  sceneStats.totalPixels += framePixels;
+  if (framePixels > sceneStats.maxPixels &&
+      framePixels < (uint32_t)displayPtr->width() * displayPtr->height())
+    sceneStats.maxPixels = framePixels;
+}
+
+bool sceneTouched(int16_t x, int16_t y, int16_t w, int16_t h) {
+  if (frameFull)
+    return true;
+  SceneWidget r = {x, y, w, h, 0, false};
+  for (int i = 0; i < frameRectCount; i++) {
+    if (overlaps(r, frameRects[i]))
+      return true;
+  }
+  return false;
+}
+
+bool sceneWidget(int16_t x, int16_t y, int16_t w, int16_t h, uint32_t sig) {
+  if (scenePass == SCENE_LAYOUT) {
+    if (curCount < SCENE_MAX_WIDGETS)
+      curWidgets[curCount++] = {x, y, w, h, sig, true};
+    else
+      sceneOverflow = true;
+    return false;
+  }
+  if (scenePass == SCENE_BAND) {
+    // Skip layout work for widgets outside the band being rendered
+    SceneWidget r = {x, y, w, h, 0, false};
+    bool draw = overlaps(r, bandClip);
+    if (draw)
+      frameWidgets++;
+    return draw;
+  }
+  if (scenePass == SCENE_DRAW) {
+    // Past the table (overflow frames are full repaints) - always draw
+    bool draw = drawIndex >= curCount || curWidgets[drawIndex].dirty;
+    drawIndex++;
+    if (draw) {
+      framePixels += (uint32_t)max(w, (int16_t)0) * max(h, (int16_t)0);
+      frameWidgets++;
+    }
+    return draw;
+  }
+  return true;
+}
+
+// ============================================
+// BAND RENDERING
+// ============================================
+
+bool sceneInitBandBuffer() {
+  if (!bandBuffer)
+    bandBuffer = (uint16_t *)malloc(SCENE_BAND_PIXELS * sizeof(uint16_t));
+  if (!bandBuffer)
+    Serial.println("Scene: no heap for band buffer - drawing direct");
+  return bandBuffer != nullptr;
+}
+
+bool sceneHasBandBuffer() { return bandBuffer != nullptr; }
+
+static void addDirtyRect(SceneWidget *rects, int &count, int maxCount,
+                         const SceneWidget &r, int16_t sw, int16_t sh) {
+  SceneWidget c = r;
+  if (c.x < 0) {
+    c.w += c.x;
+    c.x = 0;
+  }
+  if (c.y < 0) {
+    c.h += c.y;
+    c.y = 0;
+  }
+  c.w = min(c.w, (int16_t)(sw - c.x));
+  c.h = min(c.h, (int16_t)(sh - c.y));
+  if (c.w <= 0 || c.h <= 0)
+    return;
+
+  // Merge with overlapping areas so no pixel is pushed twice
+  for (int i = 0; i < count; i++) {
+    if (overlaps(rects[i], c)) {
+      int16_t x0 = min(rects[i].x, c.x), y0 = min(rects[i].y, c.y);
+      int16_t x1 = max(rects[i].x + rects[i].w, c.x + c.w);
+      int16_t y1 = max(rects[i].y + rects[i].h, c.y + c.h);
+      c = {x0, y0, (int16_t)(x1 - x0), (int16_t)(y1 - y0), 0, false};
+      rects[i] = rects[--count];
+      i = -1; // The grown area may now overlap earlier ones
+    }
+  }
+  if (count < maxCount) {
+    rects[count++] = c;
+  } else {
+    // Out of slots - one full-screen rect covers everything dropped
+    rects[0] = {0, 0, sw, sh, 0, false};
+    count = 1;
+  }
+}
+
+void sceneRenderBands(void (*render)()) {
+  Adafruit_ST7735 *panel = static_cast<Adafruit_ST7735 *>(displayPtr);
+  int16_t sw = panel->width();
+  int16_t sh = panel->height();
+
+  SceneWidget *dirty = frameRects;
+  int &dirtyCount = frameRectCount;
+  if (!sceneValid || sceneOverflow) {
+    SceneWidget full = {0, 0, sw, sh, 0, false};
+    addDirtyRect(dirty, dirtyCount, SCENE_MAX_WIDGETS, full, sw, sh);
+    sceneStats.fullRepaints++;
+  } else {
+    // Old and new area of every changed widget
+    for (int i = 0; i < max(curCount, prevCount); i++) {
+      bool changed = i >= curCount || i >= prevCount ||
+                     !sameRect(curWidgets[i], prevWidgets[i]) ||
+                     curWidgets[i].sig != prevWidgets[i].sig;
+      if (!changed)
+        continue;
+      if (i < prevCount)
+        addDirtyRect(dirty, dirtyCount, SCENE_MAX_WIDGETS, prevWidgets[i], sw,
+                     sh);
+      if (i < curCount)
+        addDirtyRect(dirty, dirtyCount, SCENE_MAX_WIDGETS, curWidgets[i], sw,
+                     sh);
+    }
+  }
+
+  BandCanvas16 canvas(sw, sh, bandBuffer);
+  Adafruit_GFX *target = displayPtr;
+  displayPtr = &canvas;
+  scenePass = SCENE_BAND;
+
+  for (int d = 0; d < dirtyCount; d++) {
+    SceneWidget &r = dirty[d];
+    int16_t rows = max(1, SCENE_BAND_PIXELS / r.w);
+    for (int16_t y = r.y; y < r.y + r.h; y += rows) {
+      int16_t bh = min(rows, (int16_t)(r.y + r.h - y));
+      canvas.setWindow(r.x, y, r.w, bh);
+      bandClip = {r.x, y, r.w, bh, 0, false};
+      canvas.fillScreen(SCENE_BACKGROUND);
+      render();
+      panel->drawRGBBitmap(r.x, y, bandBuffer, r.w, bh);
+      framePixels += (uint32_t)r.w * bh;
+      frameBands++;
+    }
+  }
+
+  displayPtr = target;
+  scenePass = SCENE_OFF;
+}
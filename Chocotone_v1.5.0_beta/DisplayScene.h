@@ -0,0 +1,67 @@
+#ifndef DISPLAY_SCENE_H
+#define DISPLAY_SCENE_H
+
+#include <Arduino.h>
+
+// ============================================
+// RETAINED DISPLAY SCENE (TFT main screen)
+// displayOLED() runs the main screen layout twice per refresh:
+//   1. Layout pass - every widget (label, strip, BPM, status, battery)
+//      registers its rectangle and a signature of its content.
+//   2. Draw pass - only widgets whose rectangle/signature changed, or that
+//      overlap an area cleared this frame, are painted.
+// Stale areas are cleared with fillRect instead of fillScreen, so a BPM
+// change pushes a few hundred pixels instead of the whole panel.
+// Anything else that draws on the screen (menus, overlays) must call
+// sceneInvalidate() - clearDisplayBuffer() does this.
+//
+// With a band buffer the draw pass renders the dirty areas into RAM
+// (RGB565, SCENE_BAND_PIXELS at a time) and pushes each band as a single
+// address window + pixel block, instead of clearing with fillRect and
+// drawing glyphs pixel by pixel over SPI.
+//
+// The scene is theme-less: it is only used when the TFT palette frame could
+// not be allocated (TftFrame.h), so bands are cleared to SCENE_BACKGROUND
+// and widgets draw the classic colors, like the direct path.
+// ============================================
+
+#define SCENE_MAX_WIDGETS 80 // 2 rows x (label + strip) x 16 + middle area
+#define SCENE_BAND_PIXELS 2048 // RGB565 band buffer (4 KB)
+#define SCENE_BACKGROUND 0x0000 // ST7735_BLACK (no theme, see above)
+
+struct SceneStats {
+  uint32_t frames;
+  uint32_t fullRepaints;
+  uint32_t lastPixels;  // Pixels cleared + drawn by the last frame
+  uint16_t lastWidgets; // Widgets redrawn by the last frame
+  uint32_t maxPixels;   // Largest partial frame
+  uint64_t totalPixels;
+  uint16_t lastBands; // Blocks pushed by the last frame (band mode)
+};
+extern SceneStats sceneStats;
+
+void sceneInvalidate(); // Next frame repaints everything
+bool sceneIsValid();    // Screen still shows the last scene frame
+void sceneBeginLayout();
+void sceneBeginDraw(); // Diff against the previous frame, clear stale areas
+void sceneEnd();
+
+// Band rendering (TFT). sceneRenderBands() replaces sceneBeginDraw() and the
+// draw pass: it calls render() once per dirty band with displayPtr pointing
+// at the band canvas.
+bool sceneInitBandBuffer(); // false = not enough heap, use direct drawing
+bool sceneHasBandBuffer();
+void sceneRenderBands(void (*render)());
+
+// Register a widget. Returns true when the caller should draw it (always
+// true outside the draw pass, e.g. on SSD1306 where the scene is unused).
+bool sceneWidget(int16_t x, int16_t y, int16_t w, int16_t h, uint32_t sig);
+
+// Drawing done outside the scene (analog meters) must repaint whatever the
+// last frame cleared or pushed: true if that area intersects the rect
+bool sceneTouched(int16_t x, int16_t y, int16_t w, int16_t h);
+
+// FNV-1a, chainable via seed
+uint32_t sceneHash(const void *data, size_t len, uint32_t seed = 2166136261u);
+
+#endif
@@ -0,0 +1,177 @@
+#include "DisplayTask.h"
+#include "Globals.h"
+#include "UI_Display.h"
+
+DisplayTaskStats displayTaskStats = {0, 0, 0, 0, 0, 0};
+
+static TaskHandle_t displayTaskHandle = NULL;
+static SemaphoreHandle_t displayMutex = NULL;
+static volatile bool refreshPending = false;
+static volatile bool fullPending = false; // Not just analog meters
+
+DisplayLock::DisplayLock() {
+  if (displayMutex)
+    xSemaphoreTakeRecursive(displayMutex, portMAX_DELAY);
+}
+
+DisplayLock::~DisplayLock() {
+  if (displayMutex)
+    xSemaphoreGiveRecursive(displayMutex);
+}
+
+static void displayTask(void *param) {
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+    DisplayLock lock;
+    if (!refreshPending)
+      continue; // Already drawn synchronously (or a menu took over)
+
+    unsigned long t0 = micros();
+    if (fullPending)
+      displayOLED(); // Clears refreshPending
+    else
+      displayAnalogMeters();
+    uint32_t us = micros() - t0;
+
+    displayTaskStats.frames++;
+    displayTaskStats.lastFrameUs = us;
+    displayTaskStats.totalFrameUs += us;
+    if (us > displayTaskStats.maxFrameUs)
+      displayTaskStats.maxFrameUs = us;
+  }
+}
+
+void startDisplayTask() {
+  if (displayTaskHandle)
+    return;
+  displayMutex = xSemaphoreCreateRecursiveMutex();
+  if (!displayMutex) {
+    Serial.println("Display task: mutex alloc failed - drawing inline");
+    return;
+  }
+  if (xTaskCreatePinnedToCore(displayTask, "display", DISPLAY_TASK_STACK,
+                              NULL, DISPLAY_TASK_PRIORITY, &displayTaskHandle,
+                              DISPLAY_TASK_CORE) != pdPASS) {
+    displayTaskHandle = NULL;
+    Serial.println("Display task: create failed - drawing inline");
+    return;
+  }
+  Serial.println("Display task started");
+}
+
+void requestDisplayRefresh(bool metersOnly) {
+  if (!displayTaskHandle) {
+    if (metersOnly)
+      displayAnalogMeters();
+    else
+      displayOLED();
+    return;
+  }
+  unsigned long t0 = micros();
+  displayTaskStats.requests++;
+  if (!metersOnly)
+    fullPending = true;
+  refreshPending = true;
+  xTaskNotifyGive(displayTaskHandle);
+  uint32_t us = micros() - t0;
+  if (us > displayTaskStats.maxPostUs)
+    displayTaskStats.maxPostUs = us;
+}
+
+void cancelDisplayRefresh() {
+  refreshPending = false;
+  fullPending = false;
+}
+
+// ============================================
+// DISPLAY SCHEDULER
+// ============================================
+
+DisplaySchedulerStats displaySchedulerStats = {{0}, 0, 0, 0};
+
+static portMUX_TYPE schedMux = portMUX_INITIALIZER_UNLOCKED;
+static volatile bool viewPending = false;
+static volatile DisplayView pendingView = VIEW_MAIN;
+static volatile DisplayPriority pendingPrio = DISPLAY_LOW;
+static volatile uint8_t pendingReasons = 0; // Bit per DisplayReason
+static DisplayView shownView = VIEW_MAIN;
+static unsigned long lastFrameMs = 0;
+
+void requestDisplay(DisplayView view, DisplayReason reason,
+                    DisplayPriority prio) {
+  portENTER_CRITICAL(&schedMux);
+  if (reason < DISPLAY_REASON_COUNT) {
+    displaySchedulerStats.requests[reason]++;
+    pendingReasons |= 1 << reason;
+  }
+  if (!viewPending || prio >= pendingPrio) {
+    if (viewPending)
+      displaySchedulerStats.coalesced++;
+    // VIEW_CURRENT never replaces a concrete view that is already pending
+    if (!(viewPending && view == VIEW_CURRENT))
+      pendingView = view;
+    pendingPrio = prio;
+    viewPending = true;
+  } else {
+    displaySchedulerStats.coalesced++;
+  }
+  portEXIT_CRITICAL(&schedMux);
+}
+
+DisplayView currentDisplayView() { return shownView; }
+
+void serviceDisplay() {
+  // Button name overlay expired - back to the preset screen
+  if (buttonNameDisplayUntil > 0 && millis() >= buttonNameDisplayUntil) {
+    buttonNameDisplayUntil = 0;
+    if (currentMode == 0 && !systemConfig.debugAnalogIn)
+      requestDisplay(VIEW_MAIN, DISPLAY_REASON_OVERLAY);
+  }
+
+  if (!viewPending)
+    return;
+
+  unsigned long now = millis();
+  unsigned long period =
+      pendingPrio == DISPLAY_LOW ? DISPLAY_LOW_REFRESH_MS : DISPLAY_REFRESH_MS;
+  if (now - lastFrameMs < period)
+    return;
+
+  // WiFi uses lots of memory - keep the frame pending instead of dropping it
+  if (ESP.getFreeHeap() < DISPLAY_MIN_FREE_HEAP) {
+    displaySchedulerStats.heapDeferred++;
+    return;
+  }
+
+  portENTER_CRITICAL(&schedMux);
+  DisplayView view = pendingView;
+  uint8_t reasons = pendingReasons;
+  viewPending = false;
+  pendingReasons = 0;
+  portEXIT_CRITICAL(&schedMux);
+
+  // Only analog values moved on the main screen - meters only
+  bool metersOnly = view == VIEW_MAIN && shownView == VIEW_MAIN &&
+                    reasons == (1 << DISPLAY_REASON_ANALOG);
+  if (view == VIEW_CURRENT)
+    view = shownView;
+  shownView = view;
+  lastFrameMs = now;
+  displaySchedulerStats.frames++;
+
+  switch (view) {
+  case VIEW_MENU:
+    displayMenu();
+    break;
+  case VIEW_EDIT_MENU:
+    displayEditMenu();
+    break;
+  case VIEW_ANALOG_DEBUG:
+    displayAnalogDebug();
+    break;
+  default:
+    requestDisplayRefresh(metersOnly); // Main screen - display task
+    break;
+  }
+}
@@ -0,0 +1,93 @@
+#ifndef DISPLAY_TASK_H
+#define DISPLAY_TASK_H
+
+#include <Arduino.h>
+
+// ============================================
+// DISPLAY TASK
+// Main screen refreshes requested through the scheduler below are rendered
+// by a low-priority task on core 0, so a press's MIDI send no longer waits
+// behind SPI/I2C pixel writes. Requests that arrive while a frame is being
+// drawn collapse into one refresh.
+// All drawing entry points in UI_Display.cpp hold DisplayLock, so menus
+// drawn synchronously from loop() never interleave with the task. Config
+// writers (web form, JSON upload over web / serial / BLE) hold it too while
+// they change names, buttons or layout. A press may switch currentPreset
+// without it: a frame reads the index once, and meters read single words.
+// ============================================
+
+#define DISPLAY_TASK_STACK 4096
+#define DISPLAY_TASK_PRIORITY 1 // Below BLE/WiFi, equal to loop()
+#define DISPLAY_TASK_CORE 0     // loop() runs on core 1
+
+struct DisplayTaskStats {
+  uint32_t requests;   // requestDisplayRefresh() calls
+  uint32_t frames;     // Frames rendered by the task
+  uint32_t lastFrameUs;
+  uint32_t maxFrameUs;
+  uint64_t totalFrameUs;
+  uint32_t maxPostUs;  // Longest time a caller was blocked posting
+};
+extern DisplayTaskStats displayTaskStats;
+
+void startDisplayTask();
+// Async main screen refresh (sync if no task). metersOnly: just the analog
+// meters changed (displayAnalogMeters()); a full request in between wins.
+void requestDisplayRefresh(bool metersOnly = false);
+void cancelDisplayRefresh(); // Screen is being drawn synchronously
+
+// ============================================
+// DISPLAY SCHEDULER
+// Callers mark a view dirty with requestDisplay() instead of drawing. loop()
+// calls serviceDisplay() once per pass, after input and MIDI handling, and
+// at most one frame is rendered per refresh period. Within a period the
+// highest-priority (then latest) request decides which view is drawn.
+// Safe to call from BLE / web callbacks - nothing is drawn there.
+// ============================================
+
+#define DISPLAY_REFRESH_MS 33       // ~30 fps for HIGH / NORMAL requests
+#define DISPLAY_LOW_REFRESH_MS 100  // Periodic status, debug screen
+#define DISPLAY_MIN_FREE_HEAP 20000 // Below this frames stay pending (WiFi)
+
+enum DisplayView : uint8_t {
+  VIEW_CURRENT,      // Whatever was drawn last (recovery, config reload)
+  VIEW_MAIN,         // Preset screen incl. tap tempo and button name overlay
+  VIEW_MENU,
+  VIEW_EDIT_MENU,
+  VIEW_ANALOG_DEBUG
+};
+
+enum DisplayPriority : uint8_t { DISPLAY_LOW, DISPLAY_NORMAL, DISPLAY_HIGH };
+
+enum DisplayReason : uint8_t {
+  DISPLAY_REASON_INPUT,    // Button / encoder on the device
+  DISPLAY_REASON_CONFIG,   // Web, serial or BLE editor changed the config
+  DISPLAY_REASON_MIDI,     // MIDI device connected / disconnected
+  DISPLAY_REASON_ANALOG,   // Analog meter values moved
+  DISPLAY_REASON_PERIODIC, // Battery / connection status, debug screen
+  DISPLAY_REASON_OVERLAY,  // Button name overlay expired
+  DISPLAY_REASON_RECOVERY, // Panel re-initialized
+  DISPLAY_REASON_COUNT
+};
+
+struct DisplaySchedulerStats {
+  uint32_t requests[DISPLAY_REASON_COUNT];
+  uint32_t frames;       // Frames started by serviceDisplay()
+  uint32_t coalesced;    // Requests absorbed by an already pending frame
+  uint32_t heapDeferred; // Passes a frame waited for DISPLAY_MIN_FREE_HEAP
+};
+extern DisplaySchedulerStats displaySchedulerStats;
+
+void requestDisplay(DisplayView view, DisplayReason reason,
+                    DisplayPriority prio = DISPLAY_NORMAL);
+void serviceDisplay(); // Safe point in loop() - renders at most one frame
+DisplayView currentDisplayView(); // View drawn by the last frame
+
+// Recursive display lock (no-op before startDisplayTask())
+class DisplayLock {
+public:
+  DisplayLock();
+  ~DisplayLock();
+};
+
+#endif
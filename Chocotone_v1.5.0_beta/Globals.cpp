@@ -1,5 +1,7 @@
 #include "Globals.h"
 #include "DeviceProfiles.h"
+#include "LedPower.h"
+#include "MidiCoalescer.h"
 
 // ============================================
 // GLOBAL OBJECTS
@@ -186,6 +188,11 @@ int ledBrightnessDim = 20;
 int ledBrightnessTap = 240;
 int buttonDebounce = 120;
 int buttonNameFontSize = 5;
+// Per-controller CC flush rate (MidiCoalescer)
+int ccMaxRateHz = DEFAULT_CC_MAX_RATE_HZ;
+uint8_t displayTheme = 0; // TFT color theme (TftFrame.h)
+uint16_t ledPowerBudgetMa = LED_POWER_DEFAULT_MA; // 0 = no limit
+uint16_t ledStripLength = NUM_LEDS; // Applied at boot (1-MAX_LEDS)
 
 // ============================================
 // STATE VARIABLES
@@ -237,7 +244,7 @@ PresetLedMode presetLedModes[CHOCO_MAX_PRESETS] = {
     PRESET_LED_SELECTION};
 int8_t presetSelectionState[CHOCO_MAX_PRESETS] = {-1, -1, -1, -1};
 
-uint32_t lastLedColors[NUM_LEDS] = {0};
+uint32_t lastLedColors[MAX_BUTTONS] = {0};
 
 // ============================================
 // EFFECT STATE SYNC (Device-Agnostic + Legacy)
@@ -268,12 +275,6 @@ unsigned long lastBatteryRead = 0;
 int batteryAdcMax = 0;    // Auto-calibrated: starts at 0, first read sets it
 int batteryAdcMin = 4095; // Auto-calibrated: starts at max, first read sets it
 
-// ============================================
-// DEFERRED UPDATES
-// ============================================
-
-bool pendingDisplayUpdate = false;
-
 // ============================================
 // TAP TEMPO
 // ============================================
@@ -291,6 +292,3 @@ bool tapModeLocked = false;
 unsigned long tapModeTimeout = 0;
 const float rhythmMultipliers[4] = {1.0, 0.5, 0.75, 2.0};
 const char *rhythmNames[4] = {"1/4", "1/8", "1/8d", "1/2"};
-
-unsigned long lastTapBlinkTime = 0;
-bool tapBlinkState = false;
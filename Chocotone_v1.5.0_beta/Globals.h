@@ -59,7 +59,10 @@ enum MidiCommandType : uint8_t {
   MENU_TOGGLE, // Enter/Exit menu mode (long press equivalent)
   MENU_UP,     // Navigate menu up / decrease value
   MENU_DOWN,   // Navigate menu down / increase value
-  MENU_ENTER   // Select menu item / confirm value
+  MENU_ENTER,  // Select menu item / confirm value
+  // High-resolution analog output (v1.5.x)
+  CC_14BIT, // Analog input: MSB on data1 (0-31), LSB on data1+32
+  NRPN      // Analog input: NRPN param data2:data1 (MSB:LSB), 14-bit value
 };
 
 // Action Type - when this message triggers
@@ -368,6 +371,10 @@ extern int ledBrightnessDim;
 extern int ledBrightnessTap;
 extern int buttonDebounce;
 extern int buttonNameFontSize;
+extern int ccMaxRateHz;
+extern uint8_t displayTheme;
+extern uint16_t ledPowerBudgetMa;
+extern uint16_t ledStripLength;
 
 // ============================================
 // STATE VARIABLES
@@ -402,7 +409,9 @@ extern int8_t editAinIndex;     // Which analog input (0-15)
 extern int8_t editSubSelection; // Cursor position in current submenu
 
 // Number of valid MidiCommandType values for cycling in editor
-#define MIDI_TYPE_COUNT 21 // MIDI_OFF(0) through MENU_ENTER(20)
+#define MIDI_TYPE_COUNT 23 // MIDI_OFF(0) through NRPN(22)
+// Buttons stop before the analog-only types (CC_14BIT, NRPN)
+#define BUTTON_MIDI_TYPE_COUNT CC_14BIT
 
 // Button state tracking
 extern bool buttonPinActive[MAX_BUTTONS];
@@ -428,7 +437,7 @@ extern char lastSentMidiString[20];
 extern bool ledToggleState[MAX_BUTTONS];
 extern PresetLedMode presetLedModes[CHOCO_MAX_PRESETS];
 extern int8_t presetSelectionState[CHOCO_MAX_PRESETS];
-extern uint32_t lastLedColors[NUM_LEDS];
+extern uint32_t lastLedColors[MAX_BUTTONS];
 
 // ============================================
 // EFFECT STATE SYNC (Device-Agnostic + Legacy)
@@ -462,12 +471,6 @@ extern unsigned long lastBatteryRead; // Last ADC read time
 extern int batteryAdcMax;             // Auto-calibrated max ADC reading
 extern int batteryAdcMin;             // Auto-calibrated min ADC reading
 
-// ============================================
-// DEFERRED UPDATES
-// ============================================
-
-extern bool pendingDisplayUpdate;
-
 // ============================================
 // TAP TEMPO
 // ============================================
@@ -486,9 +489,6 @@ extern unsigned long tapModeTimeout;
 extern const float rhythmMultipliers[4];
 extern const char *rhythmNames[4];
 
-extern unsigned long lastTapBlinkTime;
-extern bool tapBlinkState;
-
 // ============================================
 // HELPER FUNCTIONS
 // ============================================
@@ -2,7 +2,9 @@
 #include "AnalogInput.h"
 #include "BleMidi.h"
 #include "Config.h"
+#include "DisplayTask.h"
 #include "GP5Protocol.h"
+#include "SettingsCache.h"
 #include "Storage.h"
 #include "SysexScrollData.h"
 #include "UI_Display.h"
@@ -42,7 +44,7 @@ void fireGlobalAction(const ActionMessage &msg, int btnIdx) {
   }
   buttonNameToShow[20] = '\0';
   buttonNameDisplayUntil = millis() + 1000;
-  safeDisplayOLED();
+  requestDisplay(VIEW_MAIN, DISPLAY_REASON_INPUT, DISPLAY_HIGH);
 
   executeActionMessage(msg);
 }
@@ -60,7 +62,7 @@ void executeActionMessage(const ActionMessage &msg) {
     }
     currentPreset = (currentPreset + 1) % 4;
     saveCurrentPresetIndex();
-    displayOLED();
+    requestDisplay(VIEW_MAIN, DISPLAY_REASON_INPUT, DISPLAY_HIGH);
     usbMidiLedUpdatePending = true; // Allow LED update in USB MIDI mode
     updateLeds();
     if (presetSyncMode[currentPreset] != SYNC_NONE && clientConnected)
@@ -78,7 +80,7 @@ void executeActionMessage(const ActionMessage &msg) {
     }
     currentPreset = (currentPreset - 1 + 4) % 4;
     saveCurrentPresetIndex();
-    displayOLED();
+    requestDisplay(VIEW_MAIN, DISPLAY_REASON_INPUT, DISPLAY_HIGH);
     usbMidiLedUpdatePending = true; // Allow LED update in USB MIDI mode
     updateLeds();
     if (presetSyncMode[currentPreset] != SYNC_NONE && clientConnected)
@@ -99,7 +101,7 @@ void executeActionMessage(const ActionMessage &msg) {
     }
     currentPreset = msg.type - PRESET_1;
     saveCurrentPresetIndex();
-    displayOLED();
+    requestDisplay(VIEW_MAIN, DISPLAY_REASON_INPUT, DISPLAY_HIGH);
     updateLeds();
     if (presetSyncMode[currentPreset] != SYNC_NONE && clientConnected)
       requestPresetState();
@@ -110,13 +112,14 @@ void executeActionMessage(const ActionMessage &msg) {
       turnWifiOff();
       delay(100);
       yield();
-      displayOLED(); // Safe to update display after WiFi off
+      // Safe to update display after WiFi off
+      requestDisplay(VIEW_MAIN, DISPLAY_REASON_INPUT, DISPLAY_HIGH);
     } else {
       turnWifiOn();
       delay(200); // Give WiFi more time to stabilize
       yield();
       Serial.println("WiFi toggle complete, skipping display update");
-      // Skip displayOLED when WiFi just started - heap is low
+      // Scheduler holds frames while WiFi startup leaves the heap low
     }
     return;
 
@@ -131,11 +134,11 @@ void executeActionMessage(const ActionMessage &msg) {
       menuSelection = 0;
       inSubMenu = false;
       inTapTempoMode = false;
-      displayMenu();
+      requestDisplay(VIEW_MENU, DISPLAY_REASON_INPUT, DISPLAY_HIGH);
     } else {
       // Exit menu without saving
       currentMode = 0;
-      safeDisplayOLED();
+      requestDisplay(VIEW_MAIN, DISPLAY_REASON_INPUT, DISPLAY_HIGH);
       updateLeds();
     }
     return;
@@ -147,7 +150,7 @@ void executeActionMessage(const ActionMessage &msg) {
       } else {
         menuSelection = (menuSelection - 1 + 13) % 13;
       }
-      displayMenu();
+      requestDisplay(VIEW_MENU, DISPLAY_REASON_INPUT, DISPLAY_HIGH);
     }
     return;
 
@@ -158,7 +161,7 @@ void executeActionMessage(const ActionMessage &msg) {
       } else {
         menuSelection = (menuSelection + 1) % 13;
       }
-      displayMenu();
+      requestDisplay(VIEW_MENU, DISPLAY_REASON_INPUT, DISPLAY_HIGH);
     }
     return;
 
@@ -215,7 +218,7 @@ void handleTapTempo(int buttonIndex) {
     lastTapTime = now;
     inTapTempoMode = true;
     tapModeTimeout = now + 3000;
-    displayOLED();
+    requestDisplay(VIEW_MAIN, DISPLAY_REASON_INPUT, DISPLAY_HIGH);
     return;
   }
 
@@ -232,7 +235,7 @@ void handleTapTempo(int buttonIndex) {
   sendDelayTime(delayTimeMS);
 
   tapModeTimeout = now + 3000;
-  displayOLED();
+  requestDisplay(VIEW_MAIN, DISPLAY_REASON_INPUT, DISPLAY_HIGH);
   Serial.printf("Tap Tempo: BPM=%.1f, Pattern=%s, DelayMs=%d\n", currentBPM,
                 rhythmNames[rhythmPattern], delayTimeMS);
 }
@@ -252,7 +255,7 @@ void loop_presetMode() {
       saveSystemSettings();
       rhythmPatternDirty = false;
     }
-    displayOLED();
+    requestDisplay(VIEW_MAIN, DISPLAY_REASON_INPUT, DISPLAY_HIGH);
     updateLeds();
   }
 
@@ -273,7 +276,7 @@ void loop_presetMode() {
       sendDelayTime(delayTimeMS);
 
       tapModeTimeout = millis() + 3000;
-      displayOLED();
+      requestDisplay(VIEW_MAIN, DISPLAY_REASON_INPUT, DISPLAY_HIGH);
     }
   }
 
@@ -294,6 +297,7 @@ void loop_presetMode() {
     }
 
     if (pressed != buttonPinActive[i]) {
+      markLedDirty(i); // Momentary LEDs follow the pin (also in sync mode)
       if (pressed) {
         // ===== BUTTON PRESS =====
         // Skip if button was consumed by preset change (requires release first)
@@ -366,6 +370,7 @@ void loop_presetMode() {
                 if (digitalRead(systemConfig.buttonPins[partner]) == LOW) {
                   buttonPinActive[partner] = true;
                   lastButtonPressTime_pads[partner] = millis();
+                  markLedDirty(partner); // As for a regular pin change
                   // Update partner LED state if needed
                   ButtonConfig &partnerConfig =
                       buttonConfigs[currentPreset][partner];
@@ -468,7 +473,7 @@ void loop_presetMode() {
                   buttonNameDisplayUntil = millis() + 1000;
                   if (!tapModeLocked)
                     tapModeTimeout = millis() + 3000;
-                  safeDisplayOLED();
+                  requestDisplay(VIEW_MAIN, DISPLAY_REASON_INPUT, DISPLAY_HIGH);
                   isTapControl = true;
                   break;
                 }
@@ -483,7 +488,7 @@ void loop_presetMode() {
                   buttonNameDisplayUntil = millis() + 1000;
                   if (!tapModeLocked)
                     tapModeTimeout = millis() + 3000;
-                  safeDisplayOLED();
+                  requestDisplay(VIEW_MAIN, DISPLAY_REASON_INPUT, DISPLAY_HIGH);
                   isTapControl = true;
                   break;
                 }
@@ -502,7 +507,7 @@ void loop_presetMode() {
                     }
                     buttonNameDisplayUntil = 0;
                   }
-                  safeDisplayOLED();
+                  requestDisplay(VIEW_MAIN, DISPLAY_REASON_INPUT, DISPLAY_HIGH);
                   isTapControl = true;
                   break;
                 }
@@ -595,7 +600,8 @@ void loop_presetMode() {
                       }
                       buttonNameToShow[20] = '\0';
                       buttonNameDisplayUntil = millis() + 1000;
-                      safeDisplayOLED();
+                      requestDisplay(VIEW_MAIN, DISPLAY_REASON_INPUT,
+                                     DISPLAY_HIGH);
                     }
 
                     executeActionMessage(msg);
@@ -709,7 +715,7 @@ void loop_presetMode() {
                 }
                 buttonNameToShow[20] = '\0';
                 buttonNameDisplayUntil = millis() + 1000;
-                safeDisplayOLED();
+                requestDisplay(VIEW_MAIN, DISPLAY_REASON_INPUT, DISPLAY_HIGH);
 
                 executeActionMessage(*pressAction);
 
@@ -867,7 +873,7 @@ void loop_presetMode() {
             }
             buttonNameToShow[20] = '\0';
             buttonNameDisplayUntil = millis() + 1000;
-            safeDisplayOLED();
+            requestDisplay(VIEW_MAIN, DISPLAY_REASON_INPUT, DISPLAY_HIGH);
 
             executeActionMessage(*longPress);
 
@@ -905,6 +911,7 @@ void loop_menuMode() {
         if (now - lastButtonPressTime_pads[i] > buttonDebounce) {
           lastButtonPressTime_pads[i] = now;
           buttonPinActive[i] = true;
+          markLedDirty(i);
           // Skip MENU buttons - they should still navigate
           ButtonConfig &btn = buttonConfigs[currentPreset][i];
           if (btn.messageCount > 0 && (btn.messages[0].type == MENU_UP ||
@@ -917,12 +924,13 @@ void loop_menuMode() {
             editBtnIndex = i;
             editSubSelection = 0;
             editMenuState = EDIT_BTN_ACTIONS;
-            displayEditMenu();
+            requestDisplay(VIEW_EDIT_MENU, DISPLAY_REASON_INPUT, DISPLAY_HIGH);
             return;
           }
         }
       } else if (!isPressed && buttonPinActive[i]) {
         buttonPinActive[i] = false;
+        markLedDirty(i);
       }
     }
   }
@@ -939,6 +947,7 @@ void loop_menuMode() {
       if (now - lastButtonPressTime_pads[i] > buttonDebounce) {
         lastButtonPressTime_pads[i] = now;
         buttonPinActive[i] = true;
+        markLedDirty(i);
 
         // Check this button's first message for menu commands
         ButtonConfig &btn = buttonConfigs[currentPreset][i];
@@ -952,7 +961,7 @@ void loop_menuMode() {
                 editMenuState = EDIT_NONE;
               }
               currentMode = 0;
-              safeDisplayOLED();
+              requestDisplay(VIEW_MAIN, DISPLAY_REASON_INPUT, DISPLAY_HIGH);
               updateLeds();
               return;
             case MENU_UP:
@@ -964,9 +973,10 @@ void loop_menuMode() {
                 menuSelection = (menuSelection - 1 + 15) % 15;
               }
               if (editMenuState != EDIT_NONE)
-                displayEditMenu();
+                requestDisplay(VIEW_EDIT_MENU, DISPLAY_REASON_INPUT,
+                               DISPLAY_HIGH);
               else
-                displayMenu();
+                requestDisplay(VIEW_MENU, DISPLAY_REASON_INPUT, DISPLAY_HIGH);
               return;
             case MENU_DOWN:
               if (editMenuState != EDIT_NONE) {
@@ -977,9 +987,10 @@ void loop_menuMode() {
                 menuSelection = (menuSelection + 1) % 15;
               }
               if (editMenuState != EDIT_NONE)
-                displayEditMenu();
+                requestDisplay(VIEW_EDIT_MENU, DISPLAY_REASON_INPUT,
+                               DISPLAY_HIGH);
               else
-                displayMenu();
+                requestDisplay(VIEW_MENU, DISPLAY_REASON_INPUT, DISPLAY_HIGH);
               return;
             case MENU_ENTER:
               if (editMenuState != EDIT_NONE) {
@@ -996,6 +1007,7 @@ void loop_menuMode() {
       }
     } else if (!isPressed && buttonPinActive[i]) {
       buttonPinActive[i] = false;
+      markLedDirty(i);
     }
   }
 
@@ -1016,7 +1028,7 @@ void loop_menuMode() {
       handleEditMenuInput(dir, false);
     }
     oldEncoderPosition = newEncoderPosition;
-    displayEditMenu();
+    requestDisplay(VIEW_EDIT_MENU, DISPLAY_REASON_INPUT, DISPLAY_HIGH);
     return;
   }
 
@@ -1047,7 +1059,7 @@ void loop_menuMode() {
     }
     oldEncoderPosition = newEncoderPosition;
   }
-  displayMenu();
+  requestDisplay(VIEW_MENU, DISPLAY_REASON_INPUT, DISPLAY_HIGH);
 }
 
 void handleMenuSelection() {
@@ -1065,7 +1077,7 @@ void handleMenuSelection() {
     } else {
       // User selected "No, Go Back"
       factoryResetConfirm = false;
-      displayMenu();
+      requestDisplay(VIEW_MENU, DISPLAY_REASON_INPUT, DISPLAY_HIGH);
     }
     return;
   }
@@ -1077,16 +1089,17 @@ void handleMenuSelection() {
       savePresets(); // Also save button/analog edits
       if (bleModeChanged) {
         Serial.println("BLE Mode changed - rebooting...");
+        settingsFlush(); // Pending settings must reach NVS first
         delay(500);
         ESP.restart();
       }
       currentMode = 0;
-      safeDisplayOLED();
+      requestDisplay(VIEW_MAIN, DISPLAY_REASON_INPUT, DISPLAY_HIGH);
       updateLeds();
       return; // Exit function to prevent displayMenu() at end
     case 1:   // Exit without Saving
       currentMode = 0;
-      safeDisplayOLED();
+      requestDisplay(VIEW_MAIN, DISPLAY_REASON_INPUT, DISPLAY_HIGH);
       updateLeds();
       return; // Exit function to prevent displayMenu() at end
     case 2:   // WiFi Toggle
@@ -1094,7 +1107,8 @@ void handleMenuSelection() {
         turnWifiOff();
         delay(100);
         yield();
-        displayMenu(); // Safe after WiFi off
+        // Safe after WiFi off
+        requestDisplay(VIEW_MENU, DISPLAY_REASON_INPUT, DISPLAY_HIGH);
       } else {
         if (isBtSerialOn) {
           Serial.println("Cannot enable WiFi while BT Serial is on");
@@ -1105,7 +1119,7 @@ void handleMenuSelection() {
         turnWifiOn();
         delay(200);
         yield();
-        // Skip displayMenu when WiFi just started - heap is low
+        // Scheduler holds frames while WiFi startup leaves the heap low
       }
       break;
     case 3: // BT Serial Toggle (NEW)
@@ -1113,7 +1127,7 @@ void handleMenuSelection() {
         turnBtSerialOff();
         delay(100);
         yield();
-        displayMenu();
+        requestDisplay(VIEW_MENU, DISPLAY_REASON_INPUT, DISPLAY_HIGH);
       } else {
         if (isWifiOn) {
           Serial.println("Cannot enable BT Serial while WiFi is on");
@@ -1124,7 +1138,7 @@ void handleMenuSelection() {
         turnBtSerialOn();
         delay(200);
         yield();
-        displayMenu();
+        requestDisplay(VIEW_MENU, DISPLAY_REASON_INPUT, DISPLAY_HIGH);
       }
       break;
     case 4:
@@ -1142,10 +1156,11 @@ void handleMenuSelection() {
     case 7:
       clearBLEBonds();
       currentMode = 0;
-      safeDisplayOLED();
+      requestDisplay(VIEW_MAIN, DISPLAY_REASON_INPUT, DISPLAY_HIGH);
       updateLeds();
       return; // Exit function to prevent displayMenu() at end
     case 8:
+      settingsFlush();
       ESP.restart();
       break;
     case 9: // Factory Reset - show confirmation
@@ -1156,7 +1171,7 @@ void handleMenuSelection() {
         // Already in confirmation, this shouldn't be reached normally
         factoryResetConfirm = false;
       }
-      displayMenu();
+      requestDisplay(VIEW_MENU, DISPLAY_REASON_INPUT, DISPLAY_HIGH);
       break;
     case 10:
       inSubMenu = true;
@@ -1165,7 +1180,7 @@ void handleMenuSelection() {
       break;
     case 11: // WiFi at Boot
       systemConfig.wifiOnAtBoot = !systemConfig.wifiOnAtBoot;
-      displayMenu();
+      requestDisplay(VIEW_MENU, DISPLAY_REASON_INPUT, DISPLAY_HIGH);
       break;
     case 12: // MIDI Mode - cycles: CLIENT → SERVER → DUAL → USB → EDIT → CLIENT
       if (bleConfigMode) {
@@ -1196,16 +1211,16 @@ void handleMenuSelection() {
         systemConfig.bleMode = BLE_CLIENT_ONLY;
         bleModeChanged = true;
       }
-      displayMenu();
+      requestDisplay(VIEW_MENU, DISPLAY_REASON_INPUT, DISPLAY_HIGH);
       break;
     case 13: // Analog Debug
       systemConfig.debugAnalogIn = !systemConfig.debugAnalogIn;
-      displayMenu();
+      requestDisplay(VIEW_MENU, DISPLAY_REASON_INPUT, DISPLAY_HIGH);
       break;
     case 14: // Edit Commands
       editMenuState = EDIT_ROOT;
       editSubSelection = 0;
-      displayEditMenu();
+      requestDisplay(VIEW_EDIT_MENU, DISPLAY_REASON_INPUT, DISPLAY_HIGH);
       return; // Skip displayMenu() at end
     }
   } else {
@@ -1227,7 +1242,7 @@ void handleMenuSelection() {
       break;
     }
   }
-  displayMenu();
+  requestDisplay(VIEW_MENU, DISPLAY_REASON_INPUT, DISPLAY_HIGH);
 }
 
 // ============================================
@@ -1252,11 +1267,11 @@ void handleEditMenuInput(int direction, bool enter) {
         break;
       case 2: // Back
         editMenuState = EDIT_NONE;
-        displayMenu();
+        requestDisplay(VIEW_MENU, DISPLAY_REASON_INPUT, DISPLAY_HIGH);
         return;
       }
     }
-    displayEditMenu();
+    requestDisplay(VIEW_EDIT_MENU, DISPLAY_REASON_INPUT, DISPLAY_HIGH);
     break;
   }
 
@@ -1265,7 +1280,7 @@ void handleEditMenuInput(int direction, bool enter) {
     if (enter) {
       editMenuState = EDIT_ROOT;
       editSubSelection = 0;
-      displayEditMenu();
+      requestDisplay(VIEW_EDIT_MENU, DISPLAY_REASON_INPUT, DISPLAY_HIGH);
     }
     break;
   }
@@ -1292,7 +1307,7 @@ void handleEditMenuInput(int direction, bool enter) {
         editSubSelection = 0;
       }
     }
-    displayEditMenu();
+    requestDisplay(VIEW_EDIT_MENU, DISPLAY_REASON_INPUT, DISPLAY_HIGH);
     break;
   }
 
@@ -1308,8 +1323,8 @@ void handleEditMenuInput(int direction, bool enter) {
         // Constrain based on field
         if (editFieldIndex == 0) { // Type
           if (editingValue < 0)
-            editingValue = MIDI_TYPE_COUNT - 1;
-          if (editingValue >= MIDI_TYPE_COUNT)
+            editingValue = BUTTON_MIDI_TYPE_COUNT - 1;
+          if (editingValue >= BUTTON_MIDI_TYPE_COUNT)
             editingValue = 0;
         } else if (editFieldIndex == 1) { // Channel
           editingValue = constrain(editingValue, 1, 16);
@@ -1386,7 +1401,7 @@ void handleEditMenuInput(int direction, bool enter) {
         }
       }
     }
-    displayEditMenu();
+    requestDisplay(VIEW_EDIT_MENU, DISPLAY_REASON_INPUT, DISPLAY_HIGH);
     break;
   }
 
@@ -1410,7 +1425,7 @@ void handleEditMenuInput(int direction, bool enter) {
         editSubSelection = 1; // Return cursor to "Analog Inputs"
       }
     }
-    displayEditMenu();
+    requestDisplay(VIEW_EDIT_MENU, DISPLAY_REASON_INPUT, DISPLAY_HIGH);
     break;
   }
 
@@ -1439,7 +1454,7 @@ void handleEditMenuInput(int direction, bool enter) {
         editSubSelection = editAinIndex;
       }
     }
-    displayEditMenu();
+    requestDisplay(VIEW_EDIT_MENU, DISPLAY_REASON_INPUT, DISPLAY_HIGH);
     break;
   }
 
@@ -1475,6 +1490,8 @@ void handleEditMenuInput(int direction, bool enter) {
         } else {
           if (editFieldIndex == 1)
             editingValue = constrain(editingValue, 1, 16);
+          else if (editFieldIndex == 2 && m.type == CC_14BIT)
+            editingValue = constrain(editingValue, 0, 31); // MSB controller
           else
             editingValue = constrain(editingValue, 0, 127);
         }
@@ -1534,7 +1551,7 @@ void handleEditMenuInput(int direction, bool enter) {
         }
       }
     }
-    displayEditMenu();
+    requestDisplay(VIEW_EDIT_MENU, DISPLAY_REASON_INPUT, DISPLAY_HIGH);
     break;
   }
 
@@ -1570,7 +1587,7 @@ void handleEncoderButtonPress() {
         }
 
         tapModeTimeout = millis() + 3000;
-        safeDisplayOLED();
+        requestDisplay(VIEW_MAIN, DISPLAY_REASON_INPUT, DISPLAY_HIGH);
       } else if (currentMode == 1) {
         if (editMenuState != EDIT_NONE) {
           handleEditMenuInput(0, true); // Enter/confirm in edit menu
@@ -1583,7 +1600,7 @@ void handleEncoderButtonPress() {
           systemConfig.debugAnalogIn = false; // Exit analog debug
           currentMode = 1;                    // Go to menu
           menuSelection = 13;                 // Highlight "Analog Debug" option
-          displayMenu();
+          requestDisplay(VIEW_MENU, DISPLAY_REASON_INPUT, DISPLAY_HIGH);
         } else {
           currentPreset = (currentPreset + 1) % 4;
           // Only reset LED states if NOT in GP5 sync mode
@@ -1594,7 +1611,7 @@ void handleEncoderButtonPress() {
             }
           }
           saveCurrentPresetIndex();
-          displayOLED();
+          requestDisplay(VIEW_MAIN, DISPLAY_REASON_INPUT, DISPLAY_HIGH);
           usbMidiLedUpdatePending = true; // Allow LED update in USB MIDI mode
           updateLeds();
           if (presetSyncMode[currentPreset] != SYNC_NONE && clientConnected)
@@ -1608,7 +1625,7 @@ void handleEncoderButtonPress() {
         menuSelection = 0;
         inSubMenu = false;
         inTapTempoMode = false;
-        displayMenu();
+        requestDisplay(VIEW_MENU, DISPLAY_REASON_INPUT, DISPLAY_HIGH);
       }
       // In menu mode: long press does nothing (use Save & Exit or Cancel)
     }
@@ -0,0 +1,150 @@
+#include "LabelCache.h"
+
+struct LabelEntry {
+  char text[LABEL_CACHE_MAX_CHARS + 1];
+  uint8_t len;
+  uint8_t *bits; // 1bpp, MSB first, (len * 6 + 7) / 8 bytes per row, 8 rows
+  uint16_t bytes;
+  uint32_t hash;
+  uint32_t lastUse;
+};
+
+LabelCacheStats labelCacheStats = {0, 0, 0, 0, 0};
+
+static LabelEntry entries[LABEL_CACHE_ENTRIES];
+static uint32_t useCounter = 0;
+
+static uint32_t labelHash(const char *text, size_t len) {
+  uint32_t h = 2166136261u; // FNV-1a
+  for (size_t i = 0; i < len; i++) {
+    h ^= (uint8_t)text[i];
+    h *= 16777619u;
+  }
+  return h;
+}
+
+static void freeEntry(LabelEntry &e) {
+  if (!e.bits)
+    return;
+  free(e.bits);
+  labelCacheStats.bytes -= e.bytes;
+  labelCacheStats.entries--;
+  e.bits = nullptr;
+  e.bytes = 0;
+}
+
+// Free least recently used entries until `bytes` more fit. Returns a free
+// slot, or nullptr if the label alone exceeds the cap.
+static LabelEntry *makeRoom(uint16_t bytes) {
+  if (bytes > LABEL_CACHE_BYTES)
+    return nullptr;
+  for (;;) {
+    LabelEntry *freeSlot = nullptr;
+    LabelEntry *oldest = nullptr;
+    for (int i = 0; i < LABEL_CACHE_ENTRIES; i++) {
+      LabelEntry &e = entries[i];
+      if (!e.bits) {
+        if (!freeSlot)
+          freeSlot = &e;
+      } else if (!oldest || e.lastUse < oldest->lastUse) {
+        oldest = &e;
+      }
+    }
+    if (freeSlot && labelCacheStats.bytes + bytes <= LABEL_CACHE_BYTES)
+      return freeSlot;
+    if (!oldest)
+      return nullptr;
+    freeEntry(*oldest);
+    labelCacheStats.evictions++;
+  }
+}
+
+static LabelEntry *rasterize(const char *text, size_t len, uint32_t hash) {
+  int16_t w = len * 6;
+  uint16_t rowBytes = (w + 7) / 8;
+  uint16_t bytes = rowBytes * 8;
+  LabelEntry *e = makeRoom(bytes);
+  if (!e)
+    return nullptr;
+
+  GFXcanvas1 canvas(w, 8);
+  if (!canvas.getBuffer())
+    return nullptr;
+  canvas.setTextWrap(false);
+  canvas.setTextColor(1);
+  canvas.setCursor(0, 0);
+  canvas.print(text);
+
+  e->bits = (uint8_t *)malloc(bytes);
+  if (!e->bits)
+    return nullptr;
+  memcpy(e->bits, canvas.getBuffer(), bytes);
+  memcpy(e->text, text, len + 1);
+  e->len = len;
+  e->bytes = bytes;
+  e->hash = hash;
+  labelCacheStats.bytes += bytes;
+  labelCacheStats.entries++;
+  return e;
+}
+
+void labelCacheDraw(Adafruit_GFX *gfx, int16_t x, int16_t y, uint8_t size,
+                    uint16_t color, const char *text) {
+  size_t len = strlen(text);
+  if (len == 0)
+    return;
+
+  LabelEntry *e = nullptr;
+  if (len <= LABEL_CACHE_MAX_CHARS) {
+    uint32_t hash = labelHash(text, len);
+    for (int i = 0; i < LABEL_CACHE_ENTRIES; i++) {
+      LabelEntry &c = entries[i];
+      if (c.bits && c.hash == hash && c.len == len &&
+          memcmp(c.text, text, len) == 0) {
+        e = &c;
+        break;
+      }
+    }
+    if (e) {
+      labelCacheStats.hits++;
+    } else {
+      labelCacheStats.misses++;
+      e = rasterize(text, len, hash);
+    }
+  }
+
+  if (!e) {
+    // Too long or no memory - let GFX draw it glyph by glyph
+    gfx->setTextSize(size);
+    gfx->setTextColor(color);
+    gfx->setCursor(x, y);
+    gfx->print(text);
+    return;
+  }
+  e->lastUse = ++useCounter;
+
+  // One fillRect per horizontal run of set pixels
+  int16_t w = e->len * 6;
+  uint16_t rowBytes = (w + 7) / 8;
+  for (int16_t row = 0; row < 8; row++) {
+    const uint8_t *bits = e->bits + row * rowBytes;
+    int16_t col = 0;
+    while (col < w) {
+      if (!(bits[col >> 3] & (0x80 >> (col & 7)))) {
+        col++;
+        continue;
+      }
+      int16_t start = col;
+      while (col < w && (bits[col >> 3] & (0x80 >> (col & 7))))
+        col++;
+      gfx->fillRect(x + start * size, y + row * size, (col - start) * size,
+                    size, color);
+    }
+  }
+}
+
+void labelCacheClear() {
+  for (int i = 0; i < LABEL_CACHE_ENTRIES; i++)
+    freeEntry(entries[i]);
+  useCounter = 0;
+}
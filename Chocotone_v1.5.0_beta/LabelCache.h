@@ -0,0 +1,40 @@
+#ifndef LABEL_CACHE_H
+#define LABEL_CACHE_H
+
+#include <Adafruit_GFX.h>
+#include <Arduino.h>
+
+// ============================================
+// LABEL CACHE
+// Main screen text (button labels, preset name, status, BPM) rasterized
+// once with the default 6x8 font into a 1bpp bitmap and then drawn as
+// horizontal runs - one fillRect per run instead of one GFX call per glyph
+// pixel. Bitmaps are kept at text size 1; size and color are applied when
+// drawing, so one entry serves every size.
+// Entries are evicted least recently used first once LABEL_CACHE_BYTES of
+// bitmap data or LABEL_CACHE_ENTRIES is reached. The cache is cleared when
+// the main screen layout is recompiled (preset or config change), so labels
+// of a previous preset do not hold memory. Display lock only.
+// ============================================
+
+#define LABEL_CACHE_BYTES 3072   // Bitmap heap cap (~45 ten-char labels)
+#define LABEL_CACHE_ENTRIES 48
+#define LABEL_CACHE_MAX_CHARS 21 // Longer text is printed directly
+
+struct LabelCacheStats {
+  uint32_t hits;
+  uint32_t misses;
+  uint32_t evictions;
+  uint16_t entries;
+  uint16_t bytes;
+};
+extern LabelCacheStats labelCacheStats;
+
+// Draw text with its top-left corner at (x, y) - same result as
+// setTextSize(size); setCursor(x, y); print(text) with a transparent
+// background
+void labelCacheDraw(Adafruit_GFX *gfx, int16_t x, int16_t y, uint8_t size,
+                    uint16_t color, const char *text);
+void labelCacheClear();
+
+#endif
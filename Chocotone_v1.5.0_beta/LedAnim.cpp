@@ -0,0 +1,169 @@
+#include "LedAnim.h"
+
+struct LedAnimLayer {
+  LedAnimType type;
+  uint32_t color;
+  uint32_t start; // ms
+  uint16_t periodMs;
+  uint16_t durationMs;
+};
+
+LedAnimStats ledAnimStats = {0, 0, 0};
+
+static LedAnimLayer loopLayer[LED_ANIM_SLOTS];
+static LedAnimLayer shotLayer[LED_ANIM_SLOTS];
+static uint32_t loopMask = 0; // Slot bits with a loop layer
+static uint32_t shotMask = 0; // Slot bits with a one-shot layer
+static uint32_t redrawMask = 0; // Changed since the last tick
+static uint32_t beatMs = 0;
+static uint32_t beatAnchor = 0;
+static uint32_t lastFrame = 0;
+
+static inline bool isOneShot(LedAnimType type) {
+  return type == LED_ANIM_FLASH || type == LED_ANIM_FADE;
+}
+
+// level 0-255: 0 = a, 255 = b
+static uint32_t blend(uint32_t a, uint32_t b, uint8_t level) {
+  uint32_t w = level + (level >> 7); // 0-256
+  uint32_t out = 0;
+  for (int shift = 0; shift <= 16; shift += 8) {
+    int32_t ca = (a >> shift) & 0xFF;
+    int32_t cb = (b >> shift) & 0xFF;
+    out |= (uint32_t)(ca + (((cb - ca) * (int32_t)w) >> 8)) << shift;
+  }
+  return out;
+}
+
+void ledAnimStart(uint8_t slot, LedAnimType type, uint32_t color,
+                  uint16_t periodMs, uint16_t durationMs, uint32_t now) {
+  if (slot >= LED_ANIM_SLOTS || type == LED_ANIM_NONE)
+    return;
+  bool shot = isOneShot(type);
+  LedAnimLayer &l = shot ? shotLayer[slot] : loopLayer[slot];
+  if (!shot && l.type == type && l.color == color && l.periodMs == periodMs)
+    return; // Already running - keep the phase
+  l.type = type;
+  l.color = color;
+  l.start = now;
+  l.periodMs = periodMs;
+  l.durationMs = durationMs;
+  if (shot)
+    shotMask |= 1UL << slot;
+  else
+    loopMask |= 1UL << slot;
+  redrawMask |= 1UL << slot;
+}
+
+void ledAnimStop(uint8_t slot) {
+  if (slot >= LED_ANIM_SLOTS)
+    return;
+  uint32_t bit = 1UL << slot;
+  if ((loopMask | shotMask) & bit)
+    redrawMask |= bit; // Put the base color back
+  loopMask &= ~bit;
+  shotMask &= ~bit;
+  loopLayer[slot].type = LED_ANIM_NONE;
+  shotLayer[slot].type = LED_ANIM_NONE;
+}
+
+LedAnimType ledAnimLoopType(uint8_t slot) {
+  return slot < LED_ANIM_SLOTS ? loopLayer[slot].type : LED_ANIM_NONE;
+}
+
+void ledAnimSetTempo(uint32_t ms, uint32_t now) {
+  if (ms == beatMs)
+    return;
+  beatMs = ms;
+  beatAnchor = now; // First beat of the new tempo right away
+}
+
+bool ledAnimActive(uint8_t slot) {
+  return slot < LED_ANIM_SLOTS && ((loopMask | shotMask) >> slot) & 1;
+}
+
+uint32_t ledAnimTick(uint32_t now) {
+  if (!(redrawMask | loopMask | shotMask))
+    return 0; // Idle
+  uint32_t redraw = redrawMask;
+  redrawMask = 0;
+  if ((loopMask | shotMask) && now - lastFrame >= LED_ANIM_FRAME_MS) {
+    lastFrame = now;
+    for (int i = 0; i < LED_ANIM_SLOTS; i++) {
+      LedAnimLayer &s = shotLayer[i];
+      if (((shotMask >> i) & 1) && now - s.start >= s.durationMs) {
+        s.type = LED_ANIM_NONE; // Redrawn below with the layers under it
+        shotMask &= ~(1UL << i);
+        redraw |= 1UL << i;
+      }
+    }
+    redraw |= loopMask | shotMask;
+  }
+  return redraw;
+}
+
+// Position in the current period as 0-255. periodMs 0 = tempo (anchored to
+// the last tempo change); no tempo = no animation.
+static bool phase8(const LedAnimLayer &l, uint32_t now, uint8_t *phase,
+                   uint32_t *msIntoPeriod) {
+  uint32_t period = l.periodMs ? l.periodMs : beatMs;
+  if (period == 0)
+    return false;
+  uint32_t anchor = l.periodMs ? l.start : beatAnchor;
+  uint32_t ms = (now - anchor) % period;
+  *phase = (ms << 8) / period;
+  *msIntoPeriod = ms;
+  return true;
+}
+
+static inline uint8_t triangle(uint8_t phase) {
+  return phase < 128 ? phase * 2 : (255 - phase) * 2;
+}
+
+static uint32_t applyLoop(const LedAnimLayer &l, uint32_t base,
+                          uint16_t pixel, uint16_t pixels, uint32_t now) {
+  uint8_t phase;
+  uint32_t ms;
+  if (!phase8(l, now, &phase, &ms))
+    return base;
+  uint8_t level;
+  switch (l.type) {
+  case LED_ANIM_PULSE:
+    level = triangle(phase);
+    break;
+  case LED_ANIM_BREATHE: {
+    uint16_t t = triangle(phase);
+    level = (t * t) >> 8; // Eased: lingers near off, quick near full
+    break;
+  }
+  case LED_ANIM_CHASE:
+    level = pixel == ((uint32_t)phase * pixels >> 8) ? 255 : 0;
+    break;
+  case LED_ANIM_BEAT:
+    level = ms < LED_ANIM_BEAT_ON_MS ? 255 : 0;
+    break;
+  default:
+    return base;
+  }
+  return blend(base, l.color, level);
+}
+
+uint32_t ledAnimColor(uint8_t slot, uint32_t base, uint16_t pixel,
+                      uint16_t pixels, uint32_t now) {
+  if (slot >= LED_ANIM_SLOTS)
+    return base;
+  uint32_t color = base;
+  if (loopLayer[slot].type != LED_ANIM_NONE)
+    color = applyLoop(loopLayer[slot], color, pixel, pixels, now);
+
+  const LedAnimLayer &s = shotLayer[slot];
+  if (s.type == LED_ANIM_NONE)
+    return color;
+  uint32_t elapsed = now - s.start;
+  if (elapsed >= s.durationMs)
+    return color; // Cleared by the next tick
+  if (s.type == LED_ANIM_FLASH)
+    return s.color;
+  // FADE: full at start, layers below at the end
+  return blend(color, s.color, 255 - (elapsed * 255) / s.durationMs);
+}
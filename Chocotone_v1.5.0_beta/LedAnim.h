@@ -0,0 +1,60 @@
+#ifndef LED_ANIM_H
+#define LED_ANIM_H
+
+#include "Config.h"
+
+// ============================================
+// LED ANIMATIONS
+// Per-button animation layers over the state color that updateLeds()
+// computes from toggle / selection / momentary state:
+//   base color -> loop layer (pulse, breathe, chase, beat blink)
+//              -> one-shot layer (flash, fade; expires by itself)
+// Levels are 0-255 and colors are blended per channel in integer math.
+// Animated buttons are recomputed once per LED_ANIM_FRAME_MS tick
+// (ledAnimTick()), not on every loop() pass; with nothing animating a tick
+// costs two compares.
+// Nothing here reads the clock: every call takes `now` in ms, so the
+// engine runs the same against a virtual clock.
+// ============================================
+
+#define LED_ANIM_SLOTS MAX_BUTTONS
+#define LED_ANIM_FRAME_MS 20   // 50 fps while anything animates
+#define LED_ANIM_BEAT_ON_MS 50 // Beat blink on-time
+
+enum LedAnimType : uint8_t {
+  LED_ANIM_NONE,
+  // One-shot layer - durationMs required
+  LED_ANIM_FLASH, // color for durationMs
+  LED_ANIM_FADE,  // color fading back to the layers below over durationMs
+  // Loop layer - periodMs 0 follows the tempo (ledAnimSetTempo())
+  LED_ANIM_PULSE,   // Linear up/down
+  LED_ANIM_BREATHE, // Eased up/down
+  LED_ANIM_CHASE,   // One lit pixel running across the button's LEDs
+  LED_ANIM_BEAT     // LED_ANIM_BEAT_ON_MS flash on every beat
+};
+
+struct LedAnimStats {
+  uint32_t frames; // Ticks that recomputed animated buttons
+  uint32_t lastUs; // updateLeds() time of the last animated frame
+  uint32_t maxUs;
+};
+extern LedAnimStats ledAnimStats;
+
+// Starting the loop animation that is already running (same type, color,
+// period) keeps its phase
+void ledAnimStart(uint8_t slot, LedAnimType type, uint32_t color,
+                  uint16_t periodMs, uint16_t durationMs, uint32_t now);
+void ledAnimStop(uint8_t slot);                // Both layers
+LedAnimType ledAnimLoopType(uint8_t slot);     // Loop layer type
+void ledAnimSetTempo(uint32_t beatMs, uint32_t now); // 0 = no tempo
+bool ledAnimActive(uint8_t slot);
+
+// Bitmask of slots to redraw now: every animated slot once per
+// LED_ANIM_FRAME_MS, plus slots started, stopped or expired since the last
+// call (a flash shows without waiting for the frame). 0 = nothing to do.
+uint32_t ledAnimTick(uint32_t now);
+// Color of pixel (of pixels belonging to the slot) with all layers applied
+uint32_t ledAnimColor(uint8_t slot, uint32_t base, uint16_t pixel,
+                      uint16_t pixels, uint32_t now);
+
+#endif
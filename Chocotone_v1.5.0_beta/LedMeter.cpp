@@ -0,0 +1,138 @@
+#include "LedMeter.h"
+#include "Globals.h"
+#include "LedSegments.h"
+#include "LedTask.h"
+
+LedMeterStats ledMeterStats = {0, 0, 0};
+
+static uint16_t value[MAX_ANALOG_INPUTS];
+static uint16_t peakHeld[MAX_ANALOG_INPUTS];
+static uint32_t peakAt[MAX_ANALOG_INPUTS];
+static uint32_t dirtyMask = 0;
+static uint32_t peakMask = 0; // VU peaks still falling
+static uint32_t lastFrame = 0;
+
+void ledMeterSet(uint8_t input, uint16_t pos) {
+  if (input >= MAX_ANALOG_INPUTS || value[input] == pos)
+    return;
+  value[input] = pos;
+  dirtyMask |= 1UL << input;
+  ledMeterStats.updates++;
+}
+
+uint32_t ledMeterTick(uint32_t now) {
+  if (!(dirtyMask | peakMask) || now - lastFrame < LED_METER_FRAME_MS)
+    return 0;
+  lastFrame = now;
+  uint32_t mask = dirtyMask | peakMask;
+  dirtyMask = 0;
+  ledMeterStats.frames++;
+  return mask;
+}
+
+static inline uint32_t scaleColor(const uint8_t *rgb, uint8_t level) {
+  return strip.Color(rgb[0] * level / 255, rgb[1] * level / 255,
+                     rgb[2] * level / 255);
+}
+
+// VU zones by position along the bar
+static const uint8_t *vuColor(uint16_t p, uint16_t pixels) {
+  static const uint8_t green[3] = {0, 255, 0};
+  static const uint8_t yellow[3] = {255, 160, 0};
+  static const uint8_t red[3] = {255, 0, 0};
+  uint32_t pct = (uint32_t)p * 100 / pixels;
+  return pct < 60 ? green : (pct < 85 ? yellow : red);
+}
+
+// Current VU peak of input (held, then falling towards pos)
+static uint16_t updatePeak(uint8_t input, uint16_t pos, uint32_t now) {
+  int32_t peak = peakHeld[input];
+  uint32_t since = now - peakAt[input];
+  if (since > LED_METER_PEAK_HOLD_MS)
+    peak -= (int32_t)((since - LED_METER_PEAK_HOLD_MS) * AIN_HIRES_MAX /
+                      LED_METER_PEAK_FALL_MS);
+  if (pos >= peak) {
+    peak = pos;
+    peakHeld[input] = pos;
+    peakAt[input] = now;
+  }
+  if (peak > pos)
+    peakMask |= 1UL << input;
+  else
+    peakMask &= ~(1UL << input);
+  return peak;
+}
+
+bool ledMeterRender(uint8_t input, uint32_t now) {
+  if (input >= MAX_ANALOG_INPUTS)
+    return false;
+  const AnalogInputConfig &cfg = analogInputs[input];
+  LedRange ranges[LED_SEG_MAX_PER_OWNER];
+  uint8_t n = cfg.enabled ? ledSegmentsOf(LED_SEG_ANALOG + input, ranges,
+                                          LED_SEG_MAX_PER_OWNER)
+                          : 0;
+  if (n == 0) {
+    peakMask &= ~(1UL << input);
+    return false;
+  }
+  ledMeterStats.renders++;
+  uint16_t pos = value[input];
+
+  if (cfg.ledStyle == AIN_LED_LEVEL) {
+    uint32_t color = scaleColor(cfg.rgb, (uint32_t)pos * 255 / AIN_HIRES_MAX);
+    for (uint8_t r = 0; r < n; r++)
+      ledFill(ranges[r].start, ranges[r].count, color);
+    return true;
+  }
+
+  uint16_t pixels = 0;
+  for (uint8_t r = 0; r < n; r++)
+    pixels += ranges[r].count;
+  // Bar length in 1/256 LED steps
+  uint32_t level = (uint32_t)pos * pixels * 256 / AIN_HIRES_MAX;
+  uint16_t full = level >> 8;
+  uint8_t frac = level & 0xFF;
+  bool vu = cfg.ledStyle == AIN_LED_VU;
+  int32_t peakPixel = -1;
+  if (vu) {
+    uint16_t peak = updatePeak(input, pos, now);
+    if (peak > pos) {
+      peakPixel = (uint32_t)peak * pixels / (AIN_HIRES_MAX + 1);
+      if (peakPixel < full)
+        peakPixel = -1; // Inside the bar
+    }
+  }
+
+  uint16_t p = 0;
+  for (uint8_t r = 0; r < n; r++) {
+    for (uint16_t k = 0; k < ranges[r].count; k++, p++) {
+      const uint8_t *rgb = vu ? vuColor(p, pixels) : cfg.rgb;
+      uint32_t color = 0;
+      if (p < full || p == peakPixel)
+        color = scaleColor(rgb, 255);
+      else if (p == full && frac)
+        color = scaleColor(rgb, frac);
+      ledSetPixel(ranges[r].start + k, color);
+    }
+  }
+  return true;
+}
+
+const char *ledMeterStyleName(uint8_t style) {
+  switch (style) {
+  case AIN_LED_BAR:
+    return "bar";
+  case AIN_LED_VU:
+    return "vu";
+  default:
+    return "level";
+  }
+}
+
+AnalogLedStyle ledMeterParseStyle(const char *name) {
+  if (name && !strcmp(name, "bar"))
+    return AIN_LED_BAR;
+  if (name && !strcmp(name, "vu"))
+    return AIN_LED_VU;
+  return AIN_LED_LEVEL;
+}
@@ -0,0 +1,40 @@
+#ifndef LED_METER_H
+#define LED_METER_H
+
+#include "AnalogInput.h"
+
+// ============================================
+// ANALOG LED METERS
+// LED feedback of analog inputs as a layer of the LED compositor
+// (serviceLeds()): the analog pipeline only stores the new position, and
+// the input's LED segments (LedSegments.h) are redrawn at most once per
+// LED_METER_FRAME_MS, in the same frame commit as the buttons. A pedal
+// sweep no longer pushes the strip on every CC step.
+// Styles (AnalogInputConfig::ledStyle): level (all LEDs, brightness),
+// bar (bargraph with a dimmed partial LED), vu (green/yellow/red bargraph
+// with a peak LED that holds, then falls).
+// ============================================
+
+#define LED_METER_FRAME_MS 20        // Same rate as LED animations
+#define LED_METER_PEAK_HOLD_MS 600   // VU peak LED stays put this long
+#define LED_METER_PEAK_FALL_MS 1000  // then falls full scale in this time
+#define LED_METER_ALL ((1UL << MAX_ANALOG_INPUTS) - 1)
+
+struct LedMeterStats {
+  uint32_t updates; // Position changes from the analog pipeline
+  uint32_t frames;  // Ticks that redrew meters
+  uint32_t renders; // Meters drawn
+};
+extern LedMeterStats ledMeterStats;
+
+// New position 0-AIN_HIRES_MAX of input (analog pipeline)
+void ledMeterSet(uint8_t input, uint16_t pos);
+// Inputs to redraw now: changed ones (and falling VU peaks) once per frame
+uint32_t ledMeterTick(uint32_t now);
+// Draw input into the LED back buffer; false if it has no LEDs
+bool ledMeterRender(uint8_t input, uint32_t now);
+
+const char *ledMeterStyleName(uint8_t style); // "level" / "bar" / "vu"
+AnalogLedStyle ledMeterParseStyle(const char *name); // Unknown = level
+
+#endif
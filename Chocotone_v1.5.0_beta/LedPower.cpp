@@ -0,0 +1,78 @@
+#include "LedPower.h"
+#include <math.h>
+#include <string.h>
+
+LedPowerStats ledPowerStats = {0, 0, 0, 256};
+
+static uint8_t lut[256];
+static int lutBrightness = -1; // Not built yet
+
+void ledPowerSetBrightness(uint8_t brightness) {
+  if (brightness == lutBrightness)
+    return;
+  lutBrightness = brightness;
+  if (brightness == 0) {
+    // Off means off: (brightness + 1) below would still round 255 up to 1
+    memset(lut, 0, sizeof(lut));
+    return;
+  }
+  lut[0] = 0;
+  for (int i = 1; i < 256; i++) {
+    float duty = powf(i / 255.0f, LED_GAMMA) * 255.0f;
+    int v = (int)(duty * (brightness + 1) / 256.0f + 0.5f);
+    lut[i] = v < 1 ? 1 : v;
+  }
+}
+
+uint16_t ledPowerClampBudget(int32_t ma) {
+  if (ma <= 0)
+    return 0;
+  if (ma < LED_POWER_MIN_MA)
+    return LED_POWER_MIN_MA;
+  return ma > LED_POWER_MAX_MA ? LED_POWER_MAX_MA : ma;
+}
+
+uint32_t ledPowerEstimateMa(uint32_t channelSum, uint16_t count) {
+  return (uint32_t)count * LED_IDLE_MA +
+         channelSum * LED_MA_PER_CHANNEL / 255;
+}
+
+uint16_t ledPowerScale(uint32_t channelSum, uint16_t count,
+                       uint16_t budgetMa) {
+  if (budgetMa == 0 || ledPowerEstimateMa(channelSum, count) <= budgetMa)
+    return 256;
+  uint32_t idleMa = (uint32_t)count * LED_IDLE_MA;
+  if (budgetMa <= idleMa)
+    return 0;
+  // Largest channel sum that fits; channelSum is above it here
+  uint32_t allowed = (budgetMa - idleMa) * 255 / LED_MA_PER_CHANNEL;
+  return allowed * 256 / channelSum;
+}
+
+void ledPowerApply(uint32_t *frame, uint16_t count, uint16_t budgetMa) {
+  if (lutBrightness < 0)
+    ledPowerSetBrightness(255);
+
+  // Byte-wise over the whole frame; the unused top byte maps 0 -> 0
+  uint8_t *p = (uint8_t *)frame;
+  uint32_t n = (uint32_t)count * 4;
+  uint32_t sum = 0;
+  for (uint32_t k = 0; k < n; k++) {
+    uint8_t v = lut[p[k]];
+    p[k] = v;
+    sum += v;
+  }
+
+  uint32_t ma = ledPowerEstimateMa(sum, count);
+  ledPowerStats.lastMa = ma > 0xFFFF ? 0xFFFF : ma;
+  if (ledPowerStats.lastMa > ledPowerStats.maxMa)
+    ledPowerStats.maxMa = ledPowerStats.lastMa;
+
+  uint16_t scale = ledPowerScale(sum, count, budgetMa);
+  ledPowerStats.lastScale = scale;
+  if (scale >= 256)
+    return;
+  ledPowerStats.limited++;
+  for (uint32_t k = 0; k < n; k++)
+    p[k] = (p[k] * scale) >> 8;
+}
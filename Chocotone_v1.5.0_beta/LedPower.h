@@ -0,0 +1,48 @@
+#ifndef LED_POWER_H
+#define LED_POWER_H
+
+#include <stdint.h>
+
+// ============================================
+// LED POWER PIPELINE
+// Runs on every frame right before it goes to the strip (LedTask.cpp):
+//   composed color -> gamma + master brightness (one 256-entry LUT)
+//                  -> estimated current -> proportional scale-down when the
+//                     frame would draw more than the mA budget
+// The composed colors (msg->rgb scaled by the on/dim/tap brightness) are
+// perceptual levels; the LUT turns them into PWM duty so dim looks dim.
+// Any non-zero level keeps at least duty 1, so dim LEDs stay visible;
+// master brightness 0 turns every level off.
+// Current model: LED_MA_PER_CHANNEL per channel at full duty, linear in
+// duty, plus LED_IDLE_MA per LED. Scaling is integer and rounds down, so
+// a limited frame never estimates above the budget.
+// No Arduino dependencies - the math runs the same on a host.
+// ============================================
+
+#define LED_GAMMA 2.6f
+#define LED_MA_PER_CHANNEL 20  // WS2812 channel at duty 255
+#define LED_IDLE_MA 1          // WS2812 with all channels off
+#define LED_POWER_DEFAULT_MA 400 // USB-powered boards; 0 = no limit
+#define LED_POWER_MIN_MA 50
+#define LED_POWER_MAX_MA 5000
+
+struct LedPowerStats {
+  uint32_t limited; // Frames scaled down to the budget
+  uint16_t lastMa;  // Estimated current of the last frame (before limiting)
+  uint16_t maxMa;
+  uint16_t lastScale; // Scale of the last frame, 256 = not limited
+};
+extern LedPowerStats ledPowerStats;
+
+// Budget setting in range: 0 (no limit) or LED_POWER_MIN_MA-LED_POWER_MAX_MA
+uint16_t ledPowerClampBudget(int32_t ma);
+// Master brightness (0-255) folded into the LUT; rebuilds only on change
+void ledPowerSetBrightness(uint8_t brightness);
+// Estimated current of count LEDs whose channel duties add up to channelSum
+uint32_t ledPowerEstimateMa(uint32_t channelSum, uint16_t count);
+// Scale (0-256) that brings the frame within budgetMa (0 = no limit)
+uint16_t ledPowerScale(uint32_t channelSum, uint16_t count, uint16_t budgetMa);
+// Run the pipeline over frame in place (strip.Color() 0x00RRGGBB values)
+void ledPowerApply(uint32_t *frame, uint16_t count, uint16_t budgetMa);
+
+#endif
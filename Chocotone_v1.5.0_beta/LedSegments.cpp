@@ -0,0 +1,142 @@
+#include "LedSegments.h"
+#include "Globals.h"
+#include "LedTask.h"
+
+// Ranges grouped by owner: owner o has table[first[o]] .. table[first[o+1]-1]
+static LedRange table[LED_MAX_SEGMENTS];
+static uint8_t first[LED_SEG_OWNERS + 1];
+static bool custom = false;
+static char text[LED_SEG_TEXT_LEN] = "";
+
+static const char *skipSpaces(const char *p) {
+  while (*p == ' ')
+    p++;
+  return p;
+}
+
+static bool parseError(const char *what) {
+  Serial.printf("LED segments: %s - table unchanged\n", what);
+  return false;
+}
+
+// Unsigned decimal; nullptr if there is none
+static const char *parseNumber(const char *p, uint32_t *value) {
+  p = skipSpaces(p);
+  if (*p < '0' || *p > '9')
+    return nullptr;
+  uint32_t v = 0;
+  while (*p >= '0' && *p <= '9' && v < 100000)
+    v = v * 10 + (*p++ - '0');
+  *value = v;
+  return skipSpaces(p);
+}
+
+bool ledSegmentsParse(const char *src) {
+  LedRange parsed[LED_MAX_SEGMENTS];
+  uint8_t owners[LED_MAX_SEGMENTS];
+  uint8_t perOwner[LED_SEG_OWNERS] = {0};
+  uint8_t n = 0;
+
+  if (strlen(src) >= LED_SEG_TEXT_LEN)
+    return parseError("text too long");
+  const char *p = skipSpaces(src);
+  while (*p) {
+    // Owner: B<n> or A<n>
+    char kind = *p++ & ~0x20; // Upper case
+    uint32_t num;
+    p = parseNumber(p, &num);
+    uint32_t limit = kind == 'B' ? MAX_BUTTONS : MAX_ANALOG_INPUTS;
+    if ((kind != 'B' && kind != 'A') || !p || num < 1 || num > limit ||
+        *p != ':')
+      return parseError("expected B<n>: or A<n>:");
+    uint8_t owner = (kind == 'B' ? 0 : LED_SEG_ANALOG) + num - 1;
+    p++;
+
+    // Ranges: a or a-b, comma separated
+    for (;;) {
+      uint32_t a, b;
+      p = parseNumber(p, &a);
+      if (!p)
+        return parseError("expected LED index");
+      b = a;
+      if (*p == '-') {
+        p = parseNumber(p + 1, &b);
+        if (!p)
+          return parseError("expected LED index");
+      }
+      if (b < a || b >= MAX_LEDS)
+        return parseError("LED range out of order or past MAX_LEDS");
+      if (n >= LED_MAX_SEGMENTS || perOwner[owner] >= LED_SEG_MAX_PER_OWNER)
+        return parseError("too many ranges");
+      parsed[n].start = a;
+      parsed[n].count = b - a + 1;
+      owners[n++] = owner;
+      perOwner[owner]++;
+      if (*p != ',')
+        break;
+      p++;
+    }
+    if (*p == ';')
+      p = skipSpaces(p + 1);
+    else if (*p)
+      return parseError("expected ';' between owners");
+  }
+
+  // Group by owner, keeping the written order within an owner
+  uint8_t out = 0;
+  for (int o = 0; o < LED_SEG_OWNERS; o++) {
+    first[o] = out;
+    for (int i = 0; i < n && out < first[o] + perOwner[o]; i++)
+      if (owners[i] == o)
+        table[out++] = parsed[i];
+  }
+  first[LED_SEG_OWNERS] = out;
+  custom = n > 0;
+  strcpy(text, custom ? src : "");
+  return true;
+}
+
+const char *ledSegmentsText() { return text; }
+
+bool ledSegmentsCustom() { return custom; }
+
+uint8_t ledSegmentsOf(uint8_t owner, LedRange *out, uint8_t max) {
+  if (owner >= LED_SEG_OWNERS || max == 0)
+    return 0;
+
+  if (custom && first[owner + 1] > first[owner]) {
+    uint8_t n = first[owner + 1] - first[owner];
+    if (n > max)
+      n = max;
+    memcpy(out, &table[first[owner]], n * sizeof(LedRange));
+    return n;
+  }
+
+  if (owner >= LED_SEG_ANALOG) {
+    int16_t led = analogInputs[owner - LED_SEG_ANALOG].ledIndex;
+    if (led < 0 || led == 255)
+      return 0; // The editor exports "no LED" as 255
+    out[0] = {(uint16_t)led, 1};
+    return 1;
+  }
+  if (custom)
+    return 0; // Button not in the custom table
+
+  uint8_t lpb = systemConfig.ledsPerButton;
+  if (lpb <= 1)
+    out[0] = {systemConfig.ledMap[owner], 1}; // Remapped single LED
+  else
+    out[0] = {(uint16_t)(owner * lpb), lpb};
+  return 1;
+}
+
+uint16_t ledSegmentsFill(uint8_t owner, uint32_t color) {
+  LedRange ranges[LED_SEG_MAX_PER_OWNER];
+  uint8_t n = ledSegmentsOf(owner, ranges, LED_SEG_MAX_PER_OWNER);
+  uint16_t pixels = 0;
+  for (uint8_t r = 0; r < n; r++) {
+    ledFill(ranges[r].start, ranges[r].count, color);
+    pixels += ranges[r].count;
+  }
+  return pixels;
+}
@@ -0,0 +1,44 @@
+#ifndef LED_SEGMENTS_H
+#define LED_SEGMENTS_H
+
+#include "AnalogInput.h"
+#include "Config.h"
+
+// ============================================
+// LED SEGMENTS
+// Maps each button and analog input ("owner") to the LED ranges it lights
+// on the strip. Text form (JSON "ledSegments", NVS "s_ledSegs"):
+//   B1:0-9,40-49;B2:10-19;A1:20-39
+// Owners are 1-based like the UI (B = button, A = analog input), LED
+// indices 0-based and inclusive. Up to LED_SEG_MAX_PER_OWNER ranges per
+// owner, LED_MAX_SEGMENTS in total.
+// Empty text keeps the legacy layout: ledsPerButton == 1 -> ledMap[i],
+// otherwise LEDs i*ledsPerButton .. +ledsPerButton-1. A custom table
+// replaces the button layout completely (unlisted buttons stay dark);
+// analog inputs without ranges fall back to their ledIndex.
+// ============================================
+
+#define LED_MAX_SEGMENTS 48
+#define LED_SEG_MAX_PER_OWNER 8
+#define LED_SEG_ANALOG MAX_BUTTONS // Owner id of analog input 0
+#define LED_SEG_OWNERS (MAX_BUTTONS + MAX_ANALOG_INPUTS)
+// Room for a full table: "B16:" per owner, "299-299," per range, NUL
+#define LED_SEG_TEXT_LEN (LED_SEG_OWNERS * 4 + LED_MAX_SEGMENTS * 8 + 1)
+
+struct LedRange {
+  uint16_t start;
+  uint16_t count;
+};
+
+// Replace the table; false (table unchanged) on a syntax or range error.
+// "" switches back to the legacy layout.
+bool ledSegmentsParse(const char *text);
+const char *ledSegmentsText(); // As last parsed ("" = legacy)
+bool ledSegmentsCustom();
+
+// Copy up to max ranges of owner into out; returns how many
+uint8_t ledSegmentsOf(uint8_t owner, LedRange *out, uint8_t max);
+// Fill every range of owner with color (LED back buffer); returns pixels
+uint16_t ledSegmentsFill(uint8_t owner, uint32_t color);
+
+#endif
@@ -0,0 +1,129 @@
+#include "LedTask.h"
+#include "Globals.h"
+#include "LedPower.h"
+
+LedTaskStats ledTaskStats = {0, 0, 0, 0, 0, 0, 0};
+
+static TaskHandle_t ledTaskHandle = NULL;
+static bool ledOutputStarted = false;
+static portMUX_TYPE ledMux = portMUX_INITIALIZER_UNLOCKED;
+
+static uint32_t backBuffer[MAX_LEDS];  // Composed by loop()
+static uint32_t frontBuffer[MAX_LEDS]; // Last committed frame (ledMux)
+static uint32_t showBuffer[MAX_LEDS];  // Frame on the wire (LED task)
+static uint16_t ledCount = NUM_LEDS;   // Strip length set at start
+static volatile bool framePending = false;
+static volatile uint8_t masterBrightness = 255;
+static unsigned long lastShowMs = 0;
+
+static bool heapAllowsShow() {
+  // show() allocates RMT items; threshold lowered for TFT+BLE configs
+  int heapThreshold = isWifiOn ? 8000 : 10000;
+  return ESP.getFreeHeap() >= (uint32_t)heapThreshold;
+}
+
+// Gamma, brightness and current limit (LedPower.h), then out to the strip
+static void pushFrame() {
+  ledPowerSetBrightness(masterBrightness);
+  ledPowerApply(showBuffer, ledCount, ledPowerBudgetMa);
+  for (uint16_t i = 0; i < ledCount; i++)
+    strip.setPixelColor(i, showBuffer[i]);
+  unsigned long t0 = micros();
+  strip.show();
+  uint32_t us = micros() - t0;
+  lastShowMs = millis();
+  ledTaskStats.frames++;
+  ledTaskStats.lastShowUs = us;
+  if (us > ledTaskStats.maxShowUs)
+    ledTaskStats.maxShowUs = us;
+}
+
+static void ledTask(void *param) {
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+    // Pace the wire; commits arriving meanwhile land in the same frame
+    uint32_t minGap = isWifiOn ? LED_WIFI_FRAME_MS : LED_MIN_FRAME_MS;
+    uint32_t since = millis() - lastShowMs;
+    if (since < minGap)
+      vTaskDelay(pdMS_TO_TICKS(minGap - since));
+
+    if (!heapAllowsShow()) {
+      ledTaskStats.heapSkipped++;
+      vTaskDelay(pdMS_TO_TICKS(LED_HEAP_RETRY_MS));
+      xTaskNotifyGive(ledTaskHandle); // Still pending - try again
+      continue;
+    }
+
+    portENTER_CRITICAL(&ledMux);
+    bool pending = framePending;
+    framePending = false;
+    memcpy(showBuffer, frontBuffer, ledCount * sizeof(uint32_t));
+    portEXIT_CRITICAL(&ledMux);
+    if (pending)
+      pushFrame();
+  }
+}
+
+void startLedTask(uint16_t count) {
+  ledCount = count < 1 ? 1 : (count > MAX_LEDS ? MAX_LEDS : count);
+  ledOutputStarted = true;
+  if (ledTaskHandle)
+    return;
+  if (xTaskCreatePinnedToCore(ledTask, "leds", LED_TASK_STACK, NULL,
+                              LED_TASK_PRIORITY, &ledTaskHandle,
+                              LED_TASK_CORE) != pdPASS) {
+    ledTaskHandle = NULL;
+    Serial.println("LED task: create failed - showing inline");
+    return;
+  }
+  Serial.println("LED task started");
+}
+
+void ledSetBrightness(uint8_t brightness) {
+  masterBrightness = brightness; // LUT rebuilt with the next frame
+}
+
+void ledSetPixel(uint16_t index, uint32_t color) {
+  if (index < ledCount)
+    backBuffer[index] = color;
+}
+
+void ledFill(uint16_t start, uint16_t count, uint32_t color) {
+  if (start >= ledCount)
+    return;
+  if (count > ledCount - start)
+    count = ledCount - start;
+  uint32_t *p = &backBuffer[start];
+  for (uint16_t i = 0; i < count; i++)
+    p[i] = color;
+}
+
+uint32_t ledGetPixel(uint16_t index) {
+  return index < ledCount ? backBuffer[index] : 0;
+}
+
+void ledShow() {
+  if (!ledOutputStarted)
+    return; // strip.begin() not called (USB MIDI mode on S3, early boot)
+  if (!ledTaskHandle) {
+    if (heapAllowsShow()) {
+      memcpy(showBuffer, backBuffer, ledCount * sizeof(uint32_t));
+      pushFrame();
+    }
+    return;
+  }
+
+  unsigned long t0 = micros();
+  ledTaskStats.commits++;
+  portENTER_CRITICAL(&ledMux);
+  if (framePending)
+    ledTaskStats.coalesced++;
+  memcpy(frontBuffer, backBuffer, ledCount * sizeof(uint32_t));
+  framePending = true;
+  portEXIT_CRITICAL(&ledMux);
+  xTaskNotifyGive(ledTaskHandle);
+  uint32_t us = micros() - t0;
+  if (us > ledTaskStats.maxCommitUs)
+    ledTaskStats.maxCommitUs = us;
+}
@@ -0,0 +1,48 @@
+#ifndef LED_TASK_H
+#define LED_TASK_H
+
+#include <Arduino.h>
+
+// ============================================
+// LED OUTPUT TASK
+// UI code composes LED colors into a back buffer (ledSetPixel) and hands
+// finished frames over with ledShow(), which only copies the buffer and
+// wakes the LED task. The task pushes the frame to the NeoPixel strip -
+// strip.show() waits for the RMT peripheral to clock the bits out, and that
+// wait now happens on core 0 instead of in loop(). Frames committed while
+// one is on the wire collapse into the latest, so LEDs keep updating with
+// WiFi on without stalling input handling.
+// Frames pass the gamma / current-limit pipeline (LedPower.h) on the way
+// out. Only the LED task touches `strip` once startLedTask() has run.
+// ============================================
+
+#define LED_TASK_STACK 2048
+#define LED_TASK_PRIORITY 1 // Below BLE/WiFi, equal to loop()
+#define LED_TASK_CORE 0     // loop() runs on core 1
+#define LED_MIN_FRAME_MS 10 // Max 100 frames/s on the wire
+#define LED_WIFI_FRAME_MS 50 // Leave the WiFi stack room between frames
+#define LED_HEAP_RETRY_MS 100 // Low heap: frame stays pending this long
+
+struct LedTaskStats {
+  uint32_t commits;     // ledShow() calls
+  uint32_t frames;      // Frames pushed to the strip
+  uint32_t coalesced;   // Commits merged into a later frame
+  uint32_t heapSkipped; // Frames delayed by low heap
+  uint32_t lastShowUs;  // strip.show() time in the LED task
+  uint32_t maxShowUs;
+  uint32_t maxCommitUs; // Longest time a caller spent in ledShow()
+};
+extern LedTaskStats ledTaskStats;
+
+// Start after strip.begin() with the strip length (1-MAX_LEDS). Without a
+// task (create failed) ledShow() pushes inline; before it is called
+// ledShow() does nothing.
+void startLedTask(uint16_t count);
+// Master brightness over every frame (replaces strip.setBrightness())
+void ledSetBrightness(uint8_t brightness);
+void ledSetPixel(uint16_t index, uint32_t color); // strip.Color() format
+void ledFill(uint16_t start, uint16_t count, uint32_t color); // Clipped
+uint32_t ledGetPixel(uint16_t index);             // Back buffer, unscaled
+void ledShow(); // Commit the back buffer (never blocks on the strip)
+
+#endif
@@ -0,0 +1,189 @@
+#include "MidiCoalescer.h"
+#include "AnalogInput.h"
+
+struct CoalesceSlot {
+  bool used;
+  bool pending;
+  MidiTransport transport;
+  CoalesceKind kind;
+  uint8_t channel;
+  uint16_t controller;
+  uint16_t value;     // Newest pending value
+  uint16_t lastSent;  // Last value on the wire (0xFFFF = none)
+  unsigned long queuedAt;  // When the pending value was first queued
+  unsigned long lastFlush; // When this slot last transmitted
+};
+
+static CoalesceSlot slots[MIDI_COALESCE_SLOTS];
+CoalesceStats coalesceStats = {0, 0, 0, 0, 0};
+static portMUX_TYPE resetMux = portMUX_INITIALIZER_UNLOCKED;
+static uint8_t resetPending = 0; // Transport bits, set from link callbacks
+
+// Forget the slots of transports whose link changed (loop task)
+static void applyResets() {
+  portENTER_CRITICAL(&resetMux);
+  uint8_t mask = resetPending;
+  resetPending = 0;
+  portEXIT_CRITICAL(&resetMux);
+  if (!mask)
+    return;
+  for (int i = 0; i < MIDI_COALESCE_SLOTS; i++) {
+    if (slots[i].used && (mask & (1 << slots[i].transport)))
+      memset(&slots[i], 0, sizeof(slots[i]));
+  }
+}
+
+static unsigned long coalesceIntervalMs() {
+  int hz = constrain(ccMaxRateHz, CC_MAX_RATE_MIN_HZ, CC_MAX_RATE_MAX_HZ);
+  return 1000UL / hz;
+}
+
+static void transmitSlot(CoalesceSlot &slot) {
+  uint8_t pairs[8];
+  uint8_t count = 0;
+  switch (slot.kind) {
+  case COALESCE_CC:
+    pairs[0] = slot.controller;
+    pairs[1] = slot.value;
+    count = 1;
+    break;
+  case COALESCE_CC14: {
+    // MSB only when it moved (or nothing sent yet on this link)
+    bool sendMsb =
+        slot.lastSent == 0xFFFF || (slot.lastSent >> 7) != (slot.value >> 7);
+    count = buildCC14Pairs(pairs, slot.controller, slot.value, sendMsb);
+    break;
+  }
+  case COALESCE_NRPN:
+    count = buildNRPNPairs(pairs, slot.controller, slot.value);
+    break;
+  }
+  sendControlChangesTo(slot.transport, slot.channel, pairs, count);
+}
+
+static void sendNow(MidiTransport t, CoalesceKind kind, byte ch,
+                    uint16_t controller, uint16_t value) {
+  CoalesceSlot tmp = {true, true, t, kind, ch, controller, value, 0xFFFF, 0, 0};
+  transmitSlot(tmp);
+}
+
+static void queueValue(CoalesceKind kind, byte ch, uint16_t controller,
+                       uint16_t value) {
+  unsigned long now = ainMillis();
+  applyResets();
+
+  for (uint8_t t = 0; t < MIDI_OUT_COUNT; t++) {
+    MidiTransport transport = (MidiTransport)t;
+    if (!isMidiOutConnected(transport))
+      continue;
+    coalesceStats.queued++;
+
+    CoalesceSlot *slot = nullptr;
+    CoalesceSlot *freeSlot = nullptr;
+    for (int i = 0; i < MIDI_COALESCE_SLOTS; i++) {
+      CoalesceSlot &s = slots[i];
+      if (!s.used) {
+        if (!freeSlot)
+          freeSlot = &s;
+        continue;
+      }
+      if (s.transport == transport && s.kind == kind && s.channel == ch &&
+          s.controller == controller) {
+        slot = &s;
+        break;
+      }
+    }
+
+    if (!slot) {
+      if (!freeSlot) {
+        // Table full: reuse an idle slot, else bypass the coalescer
+        for (int i = 0; i < MIDI_COALESCE_SLOTS; i++) {
+          if (!slots[i].pending) {
+            freeSlot = &slots[i];
+            break;
+          }
+        }
+      }
+      if (!freeSlot) {
+        coalesceStats.dropped++;
+        sendNow(transport, kind, ch, controller, value);
+        continue;
+      }
+      slot = freeSlot;
+      slot->used = true;
+      slot->pending = false;
+      slot->transport = transport;
+      slot->kind = kind;
+      slot->channel = ch;
+      slot->controller = controller;
+      slot->lastSent = 0xFFFF;
+      slot->lastFlush = now - coalesceIntervalMs(); // First value goes out now
+    }
+
+    if (slot->pending) {
+      coalesceStats.superseded++;
+      if (slot->lastSent == value) {
+        slot->pending = false; // Moved back to what the receiver already has
+        continue;
+      }
+    } else {
+      if (slot->lastSent == value)
+        continue; // Already on the wire
+      slot->pending = true;
+      slot->queuedAt = now;
+    }
+    slot->value = value;
+  }
+
+  // Fast path: send immediately if the slot's interval already passed
+  flushMidiCoalescer();
+}
+
+void queueMidiCC(byte ch, byte n, byte v) {
+  queueValue(COALESCE_CC, ch, n & 0x7F, v & 0x7F);
+}
+
+void queueMidiCC14(byte ch, byte n, uint16_t v) {
+  queueValue(COALESCE_CC14, ch, n & 0x1F, min(v, (uint16_t)16383));
+}
+
+void queueMidiNRPN(byte ch, uint16_t param, uint16_t v) {
+  queueValue(COALESCE_NRPN, ch, param & 0x3FFF, min(v, (uint16_t)16383));
+}
+
+void flushMidiCoalescer() {
+  unsigned long now = ainMillis();
+  unsigned long interval = coalesceIntervalMs();
+  applyResets();
+
+  for (int i = 0; i < MIDI_COALESCE_SLOTS; i++) {
+    CoalesceSlot &slot = slots[i];
+    if (!slot.pending)
+      continue;
+    if (now - slot.lastFlush < interval)
+      continue;
+
+    if (!isMidiOutConnected(slot.transport)) {
+      // Link went away - drop the slot, it re-syncs on reconnect
+      slot.used = false;
+      slot.pending = false;
+      continue;
+    }
+
+    transmitSlot(slot);
+    slot.lastSent = slot.value;
+    slot.pending = false;
+    slot.lastFlush = now;
+
+    coalesceStats.sent++;
+    unsigned long lag = now - slot.queuedAt;
+    if (lag > coalesceStats.maxLagMs)
+      coalesceStats.maxLagMs = lag;
+  }
+}
+
+void resetMidiCoalescer(MidiTransport t) {
+  portENTER_CRITICAL(&resetMux);
+  resetPending |= 1 << t;
+  portEXIT_CRITICAL(&resetMux);
+}
@@ -0,0 +1,47 @@
+#ifndef MIDI_COALESCER_H
+#define MIDI_COALESCER_H
+
+#include "BleMidi.h"
+#include "Globals.h"
+
+// ============================================
+// CONTINUOUS CONTROLLER COALESCING
+// Last-value-wins queue for analog/continuous CC traffic. Each
+// (transport, channel, controller) slot holds only the newest value and is
+// flushed at most ccMaxRateHz times per second; the final resting value is
+// always sent once its slot's interval has passed.
+// Link callbacks call resetMidiCoalescer(t) on connect and disconnect so
+// a new receiver gets full values (CC14 with MSB) and nothing is skipped
+// as "already sent"; the slots are cleared by the loop task.
+// Time comes from ainMillis(), so an analog trace replay (AnalogTrace.h)
+// runs the rate limit on the trace's clock.
+// ============================================
+
+#define MIDI_COALESCE_SLOTS 24
+#define DEFAULT_CC_MAX_RATE_HZ 50
+#define CC_MAX_RATE_MIN_HZ 5
+#define CC_MAX_RATE_MAX_HZ 500
+
+enum CoalesceKind : uint8_t {
+  COALESCE_CC = 0, // 7-bit CC (controller 0-127)
+  COALESCE_CC14,   // 14-bit CC (MSB controller 0-31)
+  COALESCE_NRPN    // NRPN (14-bit parameter number)
+};
+
+struct CoalesceStats {
+  uint32_t queued;     // Values handed to the coalescer
+  uint32_t sent;       // Values actually transmitted
+  uint32_t superseded; // Pending values replaced before being sent
+  uint32_t dropped;    // No free slot - sent directly instead
+  uint32_t maxLagMs;   // Worst queue-to-wire delay of a sent value
+};
+
+void queueMidiCC(byte ch, byte n, byte v);
+void queueMidiCC14(byte ch, byte n, uint16_t v);
+void queueMidiNRPN(byte ch, uint16_t param, uint16_t v);
+void flushMidiCoalescer(); // Called from main loop()
+void resetMidiCoalescer(MidiTransport t); // Link up/down - any task
+
+extern CoalesceStats coalesceStats;
+
+#endif
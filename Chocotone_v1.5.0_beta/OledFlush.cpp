@@ -0,0 +1,240 @@
+#include "OledFlush.h"
+#include "Config.h"
+#include <Wire.h>
+
+// SSD1306 commands (horizontal addressing mode, set by Adafruit begin())
+#define SSD1306_COLUMNADDR 0x21
+#define SSD1306_PAGEADDR 0x22
+#define OLED_CTRL_COMMANDS 0x00
+#define OLED_CTRL_DATA 0x40
+
+OledFlushStats oledFlushStats = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+
+static uint8_t *shadow = nullptr;
+static size_t shadowSize = 0;
+static bool shadowValid = false;
+static uint32_t busClockHz = OLED_I2C_FAST_HZ;
+static uint32_t objectClockHz = 0; // Clock the panel object was built with
+static uint8_t consecutiveErrors = 0;
+static bool busDown = false;
+
+uint32_t oledBusClock() { return busClockHz; }
+
+Adafruit_SSD1306 *oledCreate(uint8_t height) {
+  objectClockHz = busClockHz;
+  return new Adafruit_SSD1306(SCREEN_WIDTH, height, &Wire, OLED_RESET,
+                              busClockHz, busClockHz);
+}
+
+void oledInvalidateShadow() { shadowValid = false; }
+
+bool oledBusDown() { return busDown; }
+
+void oledBusFallback() {
+  if (busClockHz == OLED_I2C_SAFE_HZ)
+    return;
+  busClockHz = OLED_I2C_SAFE_HZ;
+  Wire.setClock(busClockHz);
+  oledFlushStats.fallbacks++;
+  shadowValid = false;
+  Serial.printf("OLED: I2C errors - falling back to %lu Hz\n",
+                (unsigned long)busClockHz);
+}
+
+// Set the write window and stream bytes into it. Returns false on a bus
+// error. *wireBytes counts every byte clocked out, incl. address bytes.
+static bool sendWindow(uint8_t col0, uint8_t col1, uint8_t page0,
+                       uint8_t page1, const uint8_t *data, size_t len,
+                       uint32_t *wireBytes) {
+  Wire.beginTransmission(OLED_I2C_ADDR);
+  Wire.write(OLED_CTRL_COMMANDS);
+  Wire.write(SSD1306_COLUMNADDR);
+  Wire.write(col0);
+  Wire.write(col1);
+  Wire.write(SSD1306_PAGEADDR);
+  Wire.write(page0);
+  Wire.write(page1);
+  if (Wire.endTransmission() != 0)
+    return false;
+  *wireBytes += 8;
+
+  while (len > 0) {
+    size_t n = len > OLED_I2C_CHUNK ? OLED_I2C_CHUNK : len;
+    Wire.beginTransmission(OLED_I2C_ADDR);
+    Wire.write(OLED_CTRL_DATA);
+    Wire.write(data, n);
+    if (Wire.endTransmission() != 0)
+      return false;
+    *wireBytes += n + 2;
+    data += n;
+    len -= n;
+  }
+  return true;
+}
+
+void oledFlush(Adafruit_SSD1306 *oled, uint8_t height) {
+  const uint8_t width = 128;
+  uint8_t pages = (height + 7) / 8;
+  size_t size = (size_t)width * pages;
+  uint8_t *buf = oled->getBuffer();
+  if (!buf)
+    return;
+
+  if (shadowSize != size) {
+    free(shadow);
+    shadow = (uint8_t *)malloc(size);
+    shadowSize = shadow ? size : 0;
+    shadowValid = false;
+  }
+  if (busDown) {
+    oledFlushStats.skipped++; // Kept in RAM until recovery resends it
+    return;
+  }
+
+  // Adafruit's own transactions (begin, commands) may leave another clock
+  if (Wire.getClock() != busClockHz)
+    Wire.setClock(busClockHz);
+
+  unsigned long t0 = micros();
+  uint32_t wireBytes = 0;
+  bool ok = true;
+  bool sent = false;
+
+  if (!shadowValid || !shadow) { // No RAM for a shadow: always in full
+    ok = sendWindow(0, width - 1, 0, pages - 1, buf, size, &wireBytes);
+    oledFlushStats.fullFlushes++;
+    sent = true;
+  } else {
+    for (uint8_t page = 0; page < pages && ok; page++) {
+      const uint8_t *row = buf + page * width;
+      const uint8_t *old = shadow + page * width;
+      int first = 0;
+      while (first < width && row[first] == old[first])
+        first++;
+      if (first == width)
+        continue; // Page unchanged
+      int last = width - 1;
+      while (row[last] == old[last])
+        last--;
+      ok = sendWindow(first, last, page, page, row + first, last - first + 1,
+                      &wireBytes);
+      sent = true;
+    }
+  }
+
+  if (ok) {
+    if (shadow)
+      memcpy(shadow, buf, size);
+    shadowValid = shadow != nullptr;
+    consecutiveErrors = 0;
+  } else {
+    // Panel state unknown - resend everything next time
+    shadowValid = false;
+    oledFlushStats.errors++;
+    if (++consecutiveErrors >= OLED_I2C_MAX_ERRORS) {
+      consecutiveErrors = 0;
+      if (busClockHz != OLED_I2C_SAFE_HZ) {
+        oledBusFallback();
+      } else {
+        busDown = true; // serviceOledHealth() takes over
+        oledFlushStats.busDowns++;
+        Serial.println("OLED: bus down - frames kept in RAM until recovery");
+      }
+    }
+  }
+
+  uint32_t us = micros() - t0;
+  oledFlushStats.flushes++;
+  if (!sent)
+    oledFlushStats.skipped++;
+  oledFlushStats.lastBytes = wireBytes;
+  oledFlushStats.totalBytes += wireBytes;
+  oledFlushStats.lastUs = us;
+  if (us > oledFlushStats.maxUs)
+    oledFlushStats.maxUs = us;
+}
+
+bool oledBusUnlock(uint8_t sda, uint8_t scl) {
+  Wire.end();
+  pinMode(sda, INPUT_PULLUP);
+  pinMode(scl, OUTPUT_OPEN_DRAIN);
+  digitalWrite(scl, HIGH);
+  delayMicroseconds(5);
+
+  // A slave interrupted mid-byte holds SDA low until it has clocked out
+  // the rest of it
+  for (int i = 0; i < 9 && digitalRead(sda) == LOW; i++) {
+    digitalWrite(scl, LOW);
+    delayMicroseconds(5);
+    digitalWrite(scl, HIGH);
+    delayMicroseconds(5);
+  }
+
+  // STOP: SDA low -> high while SCL is high
+  pinMode(sda, OUTPUT_OPEN_DRAIN);
+  digitalWrite(scl, LOW);
+  digitalWrite(sda, LOW);
+  delayMicroseconds(5);
+  digitalWrite(scl, HIGH);
+  delayMicroseconds(5);
+  digitalWrite(sda, HIGH);
+  delayMicroseconds(5);
+  pinMode(sda, INPUT_PULLUP);
+  bool released = digitalRead(sda) == HIGH;
+
+  Wire.begin(sda, scl);
+  Wire.setClock(busClockHz);
+  return released;
+}
+
+bool oledReinit(Adafruit_SSD1306 **oledRef, uint8_t height) {
+  uint8_t pages = (height + 7) / 8;
+  size_t size = (size_t)128 * pages;
+  Adafruit_SSD1306 *oled = *oledRef;
+  uint8_t *buf = oled->getBuffer();
+  if (!buf)
+    return false;
+
+  bool rebuilt = false;
+  if (objectClockHz != busClockHz) {
+    // Built before a fallback: its begin() would still run at the old
+    // clock. The new object's begin() is the panel init.
+    uint32_t oldClockHz = objectClockHz;
+    Adafruit_SSD1306 *fresh = oledCreate(height);
+    if (fresh->begin(SSD1306_SWITCHCAPVCC, OLED_I2C_ADDR, true, false)) {
+      memcpy(fresh->getBuffer(), buf, size);
+      fresh->setRotation(oled->getRotation());
+      fresh->setTextColor(SSD1306_WHITE);
+      delete oled;
+      *oledRef = oled = fresh;
+      rebuilt = true;
+    } else {
+      delete fresh; // No RAM for a second buffer - keep the old object
+      objectClockHz = oldClockHz;
+    }
+  }
+
+  if (!rebuilt) {
+    // begin() clears the buffer (and draws the splash) - park the current
+    // frame in the shadow, which is resent in full anyway
+    bool keep = shadow && shadowSize == size;
+    if (keep)
+      memcpy(shadow, buf, size);
+    oled->begin(SSD1306_SWITCHCAPVCC, OLED_I2C_ADDR, true, false);
+    if (keep)
+      memcpy(buf, shadow, size);
+    else
+      oled->clearDisplay(); // Caller requests a redraw
+  }
+
+  busDown = false;
+  shadowValid = false;
+  uint16_t errorsBefore = oledFlushStats.errors;
+  oledFlush(oled, height);
+  if (oledFlushStats.errors != errorsBefore) {
+    busDown = true; // Still failing - stay down, caller backs off
+    return false;
+  }
+  oledFlushStats.recoveries++;
+  return true;
+}
@@ -0,0 +1,62 @@
+#ifndef OLED_FLUSH_H
+#define OLED_FLUSH_H
+
+#include <Adafruit_SSD1306.h>
+#include <Arduino.h>
+
+// ============================================
+// SSD1306 DELTA FLUSH
+// Keeps a shadow of what the panel shows and, per 8-pixel page, sends only
+// the column range that changed (instead of Adafruit's full 1 KB display()).
+// The bus runs at OLED_I2C_FAST_HZ and drops to OLED_I2C_SAFE_HZ after
+// repeated NACKs / bus errors. If flushes keep failing at the safe clock the
+// bus is marked down: frames are still drawn into the RAM buffer but not
+// sent, until serviceOledHealth() (UI_Display.cpp) has unlocked the bus and
+// re-initialized the panel. Health is judged from the flush transactions
+// only - there are no probe transfers.
+// Adafruit_SSD1306 switches Wire to the clock passed to its constructor for
+// its own transactions (begin, display), so the object is built here with
+// the current bus clock and rebuilt by oledReinit() after a fallback.
+// ============================================
+
+#define OLED_I2C_ADDR 0x3C
+#define OLED_I2C_FAST_HZ 400000
+#define OLED_I2C_SAFE_HZ 100000
+#define OLED_I2C_CHUNK 64      // Data bytes per transaction (Wire buffer 128)
+#define OLED_I2C_MAX_ERRORS 3  // Consecutive failed flushes before fallback
+
+struct OledFlushStats {
+  uint32_t flushes;
+  uint32_t skipped;     // Nothing changed - no I2C traffic
+  uint32_t fullFlushes; // Shadow invalid (init, recovery, bus error)
+  uint32_t lastBytes;   // Bytes on the wire incl. address/control bytes
+  uint64_t totalBytes;
+  uint32_t lastUs;      // Blocking time of the last flush
+  uint32_t maxUs;
+  uint16_t errors;
+  uint16_t fallbacks;
+  uint16_t busDowns;   // Times the bus was given up on
+  uint16_t recoveries; // Successful re-inits after a bus down
+};
+extern OledFlushStats oledFlushStats;
+
+uint32_t oledBusClock(); // Current I2C clock for the OLED
+// New panel object whose library transactions run at oledBusClock()
+Adafruit_SSD1306 *oledCreate(uint8_t height);
+void oledFlush(Adafruit_SSD1306 *oled, uint8_t height);
+void oledInvalidateShadow(); // Panel RAM no longer matches the shadow
+void oledBusFallback();      // Drop to OLED_I2C_SAFE_HZ
+
+// Recovery steps (caller holds DisplayLock)
+bool oledBusDown(); // Flushes failing at the safe clock - panel not updated
+// Release a slave holding SDA low: up to 9 SCL pulses and a STOP, then
+// restart Wire. Returns true if SDA is high (bus free). ~100 us.
+bool oledBusUnlock(uint8_t sda, uint8_t scl);
+// Re-run the panel init sequence and resend the RAM buffer (kept across
+// Adafruit begin()). If the bus clock changed since *oled was built, *oled
+// is replaced by a new object at the current clock (buffer and rotation
+// carried over, the old one deleted). Returns true if the panel
+// acknowledged everything.
+bool oledReinit(Adafruit_SSD1306 **oled, uint8_t height);
+
+#endif
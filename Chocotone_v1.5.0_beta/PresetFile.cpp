@@ -0,0 +1,530 @@
+#include "PresetFile.h"
+#include "Globals.h"
+
+// Field tags. Shared by all sections: the ActionMessage fields (16+),
+// used in PSEC_BUTTONS and PSEC_SPECIALS after a F_MESSAGE.
+enum PresetFieldTag : uint8_t {
+  // PSEC_BUTTONS
+  F_BUTTON = 1, // preset, button - starts a cleared record
+  F_BTN_NAME = 2,
+  F_BTN_LED_MODE = 3,
+  F_BTN_SEL_GROUP = 4,
+  F_MESSAGE = 5, // Starts the next (cleared) message of the record
+  // PSEC_NAMES
+  F_PRESET_NAME = 1, // preset, chars
+  // PSEC_LED_MODES / PSEC_SYNC_MODES
+  F_VALUES = 1, // One byte per preset
+  // PSEC_SPECIALS
+  F_SPECIAL = 1, // button - starts a cleared record
+  F_SPECIAL_COMBO = 2,
+  F_SPECIAL_PARTNER = 3,
+  // PSEC_META
+  F_PROFILE_NAME = 1,
+  F_LAST_MODIFIED = 2,
+  // PSEC_COMMIT
+  F_GENERATION = 1, // u32
+  F_FILE_CRC = 2,   // u32, CRC of the file up to this section
+  // ActionMessage
+  M_ACTION = 16,
+  M_TYPE = 17,
+  M_CHANNEL = 18,
+  M_DATA1 = 19,
+  M_DATA2 = 20,
+  M_RGB = 21,
+  M_LABEL = 22,
+  M_RANGE = 23,  // minInput, maxInput, minOut, maxOut
+  M_PARAMS = 24, // combo / longPress / tapTempo bytes of the union
+  M_SYSEX = 25   // SYSEX bytes; the length is the field length
+};
+
+#define PRESET_PARAMS_BYTES 4
+static_assert(sizeof(ActionMessage::tapTempo) <= PRESET_PARAMS_BYTES &&
+                  sizeof(ActionMessage::longPress) <= PRESET_PARAMS_BYTES &&
+                  sizeof(ActionMessage::combo) <= PRESET_PARAMS_BYTES,
+              "M_PARAMS must cover the non-SysEx union members");
+
+// ---- Encoding ----
+
+static void writeMessage(TlvWriter &w, const ActionMessage &m) {
+  w.field(F_MESSAGE, nullptr, 0);
+  w.fieldU8(M_ACTION, m.action);
+  w.fieldU8(M_TYPE, m.type);
+  w.fieldU8(M_CHANNEL, m.channel);
+  w.fieldU8(M_DATA1, m.data1);
+  w.fieldU8(M_DATA2, m.data2);
+  w.field(M_RGB, m.rgb, 3);
+  w.fieldStr(M_LABEL, m.label, sizeof(m.label));
+  uint8_t range[4] = {m.minInput, m.maxInput, m.minOut, m.maxOut};
+  w.field(M_RANGE, range, 4);
+  if (m.type == SYSEX) {
+    uint8_t len = m.sysex.length;
+    w.field(M_SYSEX, m.sysex.data,
+            len < sizeof(m.sysex.data) ? len : sizeof(m.sysex.data));
+  } else {
+    w.field(M_PARAMS, m._padding, PRESET_PARAMS_BYTES);
+  }
+}
+
+static void writeButton(TlvWriter &w, int p, int b) {
+  const ButtonConfig &btn = buttonConfigs[p][b];
+  uint8_t id[2] = {(uint8_t)p, (uint8_t)b};
+  w.field(F_BUTTON, id, 2);
+  w.fieldStr(F_BTN_NAME, btn.name, sizeof(btn.name));
+  w.fieldU8(F_BTN_LED_MODE, btn.ledMode);
+  w.fieldU8(F_BTN_SEL_GROUP, btn.inSelectionGroup);
+  uint8_t count = btn.messageCount;
+  if (count > MAX_ACTIONS_PER_BUTTON)
+    count = 0; // Garbage - same rule as updateLeds()
+  for (int m = 0; m < count; m++)
+    writeMessage(w, btn.messages[m]);
+}
+
+static void writeName(TlvWriter &w, int p) {
+  uint8_t buf[1 + sizeof(presetNames[0])];
+  size_t len = strnlen(presetNames[p], sizeof(presetNames[0]));
+  buf[0] = p;
+  memcpy(&buf[1], presetNames[p], len);
+  w.field(F_PRESET_NAME, buf, 1 + len);
+}
+
+static void writeSpecial(TlvWriter &w, int i) {
+  const GlobalSpecialAction &s = globalSpecialActions[i];
+  w.fieldU8(F_SPECIAL, i);
+  w.fieldU8(F_SPECIAL_COMBO, s.hasCombo);
+  w.fieldU8(F_SPECIAL_PARTNER, (uint8_t)s.partner);
+  writeMessage(w, s.comboAction);
+}
+
+// Section bodies. ctx is a PresetDirty selecting the records to write, or
+// nullptr for all of them.
+static void writeButtons(TlvWriter &w, void *ctx) {
+  const PresetDirty *dirty = (const PresetDirty *)ctx;
+  for (int p = 0; p < CHOCO_MAX_PRESETS; p++) {
+    for (int b = 0; b < MAX_BUTTONS; b++) {
+      if (!dirty || dirty->buttons[p][b])
+        writeButton(w, p, b);
+    }
+  }
+}
+
+static void writeNames(TlvWriter &w, void *ctx) {
+  const PresetDirty *dirty = (const PresetDirty *)ctx;
+  for (int p = 0; p < CHOCO_MAX_PRESETS; p++) {
+    if (!dirty || dirty->presets[p])
+      writeName(w, p);
+  }
+}
+
+static void writeLedModes(TlvWriter &w, void *) {
+  uint8_t v[CHOCO_MAX_PRESETS];
+  for (int p = 0; p < CHOCO_MAX_PRESETS; p++)
+    v[p] = presetLedModes[p];
+  w.field(F_VALUES, v, sizeof(v));
+}
+
+static void writeSyncModes(TlvWriter &w, void *) {
+  uint8_t v[CHOCO_MAX_PRESETS];
+  for (int p = 0; p < CHOCO_MAX_PRESETS; p++)
+    v[p] = presetSyncMode[p];
+  w.field(F_VALUES, v, sizeof(v));
+}
+
+static void writeSpecials(TlvWriter &w, void *ctx) {
+  const PresetDirty *dirty = (const PresetDirty *)ctx;
+  for (int i = 0; i < MAX_BUTTONS; i++) {
+    if (!dirty || dirty->specials[i])
+      writeSpecial(w, i);
+  }
+}
+
+static void writeMeta(TlvWriter &w, void *) {
+  w.fieldStr(F_PROFILE_NAME, configProfileName, sizeof(configProfileName));
+  w.fieldStr(F_LAST_MODIFIED, configLastModified, sizeof(configLastModified));
+}
+
+struct PresetCommit {
+  uint32_t generation;
+  uint32_t fileCrc;
+};
+
+static void putU32(TlvWriter &w, uint8_t tag, uint32_t v) {
+  uint8_t b[4] = {(uint8_t)v, (uint8_t)(v >> 8), (uint8_t)(v >> 16),
+                  (uint8_t)(v >> 24)};
+  w.field(tag, b, 4);
+}
+
+static void writeCommit(TlvWriter &w, void *ctx) {
+  const PresetCommit *c = (const PresetCommit *)ctx;
+  putU32(w, F_GENERATION, c->generation);
+  putU32(w, F_FILE_CRC, c->fileCrc);
+}
+
+bool writePresetFile(TlvSink &sink, uint32_t generation) {
+  TlvWriter w(sink);
+  w.begin(PRESET_FILE_MAGIC, PRESET_FILE_VERSION);
+  w.section(PSEC_BUTTONS, writeButtons, nullptr);
+  w.section(PSEC_NAMES, writeNames, nullptr);
+  w.section(PSEC_LED_MODES, writeLedModes, nullptr);
+  w.section(PSEC_SYNC_MODES, writeSyncModes, nullptr);
+  w.section(PSEC_SPECIALS, writeSpecials, nullptr);
+  w.section(PSEC_META, writeMeta, nullptr);
+  PresetCommit commit = {generation, w.bytesCrc()};
+  w.section(PSEC_COMMIT, writeCommit, &commit);
+  return w.ok();
+}
+
+bool writePresetLogEntry(TlvSink &sink, const PresetDirty &dirty,
+                         uint32_t generation, bool header) {
+  // Separate writer for the log header: the commit CRC covers this entry
+  // only, so entries verify on their own
+  if (header) {
+    TlvWriter h(sink);
+    h.begin(PRESET_LOG_MAGIC, PRESET_FILE_VERSION);
+    if (!h.ok())
+      return false;
+  }
+  TlvWriter w(sink);
+  bool anyButton = false, anyPreset = false, anySpecial = false;
+  for (int p = 0; p < CHOCO_MAX_PRESETS; p++) {
+    anyPreset |= dirty.presets[p];
+    for (int b = 0; b < MAX_BUTTONS; b++)
+      anyButton |= dirty.buttons[p][b];
+  }
+  for (int i = 0; i < MAX_BUTTONS; i++)
+    anySpecial |= dirty.specials[i];
+
+  if (anyButton)
+    w.section(PSEC_BUTTONS, writeButtons, (void *)&dirty);
+  if (anyPreset) {
+    w.section(PSEC_NAMES, writeNames, (void *)&dirty);
+    w.section(PSEC_LED_MODES, writeLedModes, nullptr);
+    w.section(PSEC_SYNC_MODES, writeSyncModes, nullptr);
+  }
+  if (anySpecial)
+    w.section(PSEC_SPECIALS, writeSpecials, (void *)&dirty);
+  if (dirty.meta)
+    w.section(PSEC_META, writeMeta, nullptr);
+  PresetCommit commit = {generation, w.bytesCrc()};
+  w.section(PSEC_COMMIT, writeCommit, &commit);
+  return w.ok();
+}
+
+// ---- Record CRCs (dirty tracking) ----
+
+class NullSink : public TlvSink {
+public:
+  size_t write(const uint8_t *, size_t len) override { return len; }
+};
+
+void presetFileCrcs(PresetCrcs *out) {
+  NullSink sink;
+  for (int p = 0; p < CHOCO_MAX_PRESETS; p++) {
+    for (int b = 0; b < MAX_BUTTONS; b++) {
+      TlvWriter w(sink);
+      writeButton(w, p, b);
+      out->buttons[p][b] = w.bytesCrc();
+    }
+    TlvWriter w(sink);
+    writeName(w, p);
+    w.fieldU8(F_VALUES, presetLedModes[p]);
+    w.fieldU8(F_VALUES, presetSyncMode[p]);
+    out->presets[p] = w.bytesCrc();
+  }
+  for (int i = 0; i < MAX_BUTTONS; i++) {
+    TlvWriter w(sink);
+    writeSpecial(w, i);
+    out->specials[i] = w.bytesCrc();
+  }
+  TlvWriter w(sink);
+  writeMeta(w, nullptr);
+  out->meta = w.bytesCrc();
+}
+
+int presetFileDiff(const PresetCrcs &saved, const PresetCrcs &now,
+                   PresetDirty *dirty) {
+  int count = 0;
+  for (int p = 0; p < CHOCO_MAX_PRESETS; p++) {
+    for (int b = 0; b < MAX_BUTTONS; b++)
+      count += dirty->buttons[p][b] = saved.buttons[p][b] != now.buttons[p][b];
+    count += dirty->presets[p] = saved.presets[p] != now.presets[p];
+  }
+  for (int i = 0; i < MAX_BUTTONS; i++)
+    count += dirty->specials[i] = saved.specials[i] != now.specials[i];
+  count += dirty->meta = saved.meta != now.meta;
+  return count;
+}
+
+// ---- Decoding ----
+
+// True if tag is an ActionMessage field (read into m, if any)
+static bool readMessageField(TlvReader &r, uint8_t tag, uint8_t len,
+                             ActionMessage *m) {
+  if (tag < M_ACTION || tag > M_SYSEX)
+    return false;
+  if (!m)
+    return true; // No slot (too many messages) - skip
+  switch (tag) {
+  case M_ACTION:
+    m->action = (ActionType)r.readU8();
+    break;
+  case M_TYPE:
+    m->type = (MidiCommandType)r.readU8();
+    break;
+  case M_CHANNEL:
+    m->channel = r.readU8();
+    break;
+  case M_DATA1:
+    m->data1 = r.readU8();
+    break;
+  case M_DATA2:
+    m->data2 = r.readU8();
+    break;
+  case M_RGB:
+    r.read(m->rgb, 3);
+    break;
+  case M_LABEL:
+    r.readStr(m->label, sizeof(m->label));
+    break;
+  case M_RANGE: {
+    uint8_t range[4];
+    r.read(range, 4);
+    m->minInput = range[0];
+    m->maxInput = range[1];
+    m->minOut = range[2];
+    m->maxOut = range[3];
+    break;
+  }
+  case M_PARAMS:
+    r.read(m->_padding, PRESET_PARAMS_BYTES);
+    break;
+  case M_SYSEX:
+    r.read(m->sysex.data, sizeof(m->sysex.data));
+    m->sysex.length = len < sizeof(m->sysex.data) ? len : sizeof(m->sysex.data);
+    break;
+  }
+  return true;
+}
+
+static void readButtons(TlvReader &r) {
+  ButtonConfig *btn = nullptr;
+  ActionMessage *msg = nullptr;
+  uint8_t tag, len;
+  while (r.nextField(&tag, &len)) {
+    if (tag == F_BUTTON) {
+      uint8_t p = r.readU8();
+      uint8_t b = r.readU8();
+      btn = p < CHOCO_MAX_PRESETS && b < MAX_BUTTONS ? &buttonConfigs[p][b]
+                                                     : nullptr;
+      msg = nullptr;
+      if (btn)
+        memset(btn, 0, sizeof(ButtonConfig));
+    } else if (!btn) {
+      continue; // Fields of a record this build has no room for
+    } else if (tag == F_BTN_NAME) {
+      r.readStr(btn->name, sizeof(btn->name));
+    } else if (tag == F_BTN_LED_MODE) {
+      btn->ledMode = (LedMode)r.readU8();
+    } else if (tag == F_BTN_SEL_GROUP) {
+      btn->inSelectionGroup = r.readU8();
+    } else if (tag == F_MESSAGE) {
+      msg = nullptr;
+      if (btn->messageCount < MAX_ACTIONS_PER_BUTTON) {
+        msg = &btn->messages[btn->messageCount++];
+        memset(msg, 0, sizeof(ActionMessage));
+      }
+    } else {
+      readMessageField(r, tag, len, msg);
+    }
+  }
+}
+
+static void readNames(TlvReader &r) {
+  uint8_t tag, len;
+  while (r.nextField(&tag, &len)) {
+    if (tag != F_PRESET_NAME)
+      continue;
+    uint8_t p = r.readU8();
+    if (p < CHOCO_MAX_PRESETS)
+      r.readStr(presetNames[p], sizeof(presetNames[p]));
+  }
+}
+
+// One byte per preset; presets the field does not cover keep their value
+static void readValues(TlvReader &r, uint8_t *values, size_t count) {
+  uint8_t tag, len;
+  while (r.nextField(&tag, &len)) {
+    if (tag == F_VALUES)
+      r.read(values, len < count ? len : count);
+  }
+}
+
+static void readSpecials(TlvReader &r) {
+  GlobalSpecialAction *s = nullptr;
+  ActionMessage *msg = nullptr;
+  uint8_t tag, len;
+  while (r.nextField(&tag, &len)) {
+    if (tag == F_SPECIAL) {
+      uint8_t i = r.readU8();
+      s = i < MAX_BUTTONS ? &globalSpecialActions[i] : nullptr;
+      msg = nullptr;
+      if (s) {
+        memset(s, 0, sizeof(GlobalSpecialAction));
+        s->partner = -1;
+      }
+    } else if (!s) {
+      continue;
+    } else if (tag == F_SPECIAL_COMBO) {
+      s->hasCombo = r.readU8();
+    } else if (tag == F_SPECIAL_PARTNER) {
+      s->partner = (int8_t)r.readU8();
+    } else if (tag == F_MESSAGE) {
+      msg = &s->comboAction;
+      memset(msg, 0, sizeof(ActionMessage));
+    } else {
+      readMessageField(r, tag, len, msg);
+    }
+  }
+}
+
+static void readMeta(TlvReader &r) {
+  uint8_t tag, len;
+  while (r.nextField(&tag, &len)) {
+    if (tag == F_PROFILE_NAME)
+      r.readStr(configProfileName, sizeof(configProfileName));
+    else if (tag == F_LAST_MODIFIED)
+      r.readStr(configLastModified, sizeof(configLastModified));
+  }
+}
+
+static uint32_t readU32(TlvReader &r) {
+  uint8_t b[4];
+  r.read(b, 4);
+  return b[0] | (b[1] << 8) | (b[2] << 16) | ((uint32_t)b[3] << 24);
+}
+
+static PresetCommit readCommit(TlvReader &r) {
+  PresetCommit c = {0, 0};
+  uint8_t tag, len;
+  while (r.nextField(&tag, &len)) {
+    if (tag == F_GENERATION)
+      c.generation = readU32(r);
+    else if (tag == F_FILE_CRC)
+      c.fileCrc = readU32(r);
+  }
+  return c;
+}
+
+bool presetFileCommitted(TlvSource &src, uint32_t *generation) {
+  TlvReader r(src);
+  uint8_t version, tag;
+  if (!r.begin(PRESET_FILE_MAGIC, &version))
+    return false;
+  // Sections are only walked (header + length); the file CRC covers them
+  while (r.nextSection(&tag)) {
+    if (tag != PSEC_COMMIT)
+      continue;
+    uint32_t start = r.sectionOffset();
+    if (!r.sectionValid() || !r.atEnd())
+      return false;
+    PresetCommit c = readCommit(r);
+    uint32_t crc;
+    if (!tlvCrcRange(src, 0, start, &crc) || crc != c.fileCrc)
+      return false;
+    *generation = c.generation;
+    return true;
+  }
+  return false; // No commit section: the save did not finish
+}
+
+// Decode one data section into the globals (CRC checked first)
+static void readSection(TlvReader &r, uint8_t tag, PresetFileResult &res) {
+  if (tag < PSEC_BUTTONS || tag > PSEC_META) {
+    res.unknown++;
+    return;
+  }
+  if (!r.sectionValid()) {
+    Serial.printf("  Preset section %d: CRC mismatch - skipped\n", tag);
+    res.damaged++;
+    return;
+  }
+  switch (tag) {
+  case PSEC_BUTTONS:
+    readButtons(r);
+    break;
+  case PSEC_NAMES:
+    readNames(r);
+    break;
+  case PSEC_LED_MODES:
+    readValues(r, (uint8_t *)presetLedModes, CHOCO_MAX_PRESETS);
+    break;
+  case PSEC_SYNC_MODES:
+    readValues(r, (uint8_t *)presetSyncMode, CHOCO_MAX_PRESETS);
+    break;
+  case PSEC_SPECIALS:
+    readSpecials(r);
+    break;
+  case PSEC_META:
+    readMeta(r);
+    break;
+  }
+  res.sections++;
+}
+
+PresetFileResult readPresetFile(TlvSource &src) {
+  PresetFileResult res = {};
+  TlvReader r(src);
+  if (!r.begin(PRESET_FILE_MAGIC, &res.version))
+    return res;
+  res.valid = true;
+
+  uint8_t tag;
+  while (r.nextSection(&tag)) {
+    if (tag == PSEC_COMMIT) {
+      if (r.sectionValid())
+        res.generation = readCommit(r).generation;
+      break; // Nothing after the commit belongs to the file
+    }
+    readSection(r, tag, res);
+  }
+  res.truncated = !r.atEnd();
+  return res;
+}
+
+PresetLogResult replayPresetLog(TlvSource &src, uint32_t generation) {
+  PresetLogResult res = {};
+  TlvReader r(src);
+  uint8_t version, tag;
+  if (!r.begin(PRESET_LOG_MAGIC, &version)) {
+    res.torn = src.size() > 0;
+    return res;
+  }
+
+  uint32_t entryStart = TLV_FILE_HEADER;
+  while (r.nextSection(&tag)) {
+    if (tag != PSEC_COMMIT)
+      continue; // Walk to the entry's commit before decoding anything
+    uint32_t commitAt = r.sectionOffset();
+    uint32_t next = commitAt + TLV_SECTION_HEADER + r.sectionLength();
+    if (!r.sectionValid())
+      break;
+    PresetCommit c = readCommit(r);
+    uint32_t crc;
+    if (!tlvCrcRange(src, entryStart, commitAt, &crc) || crc != c.fileCrc)
+      break;
+
+    if (c.generation == generation) {
+      PresetFileResult sections = {};
+      r.seekSection(entryStart);
+      while (r.nextSection(&tag) && tag != PSEC_COMMIT)
+        readSection(r, tag, sections);
+      res.entries++;
+    } else {
+      res.stale++; // Written against another base slot
+    }
+    r.seekSection(next);
+    entryStart = next;
+  }
+  res.validEnd = entryStart;
+  res.torn = entryStart < src.size();
+  return res;
+}
@@ -0,0 +1,101 @@
+#ifndef PRESET_FILE_H
+#define PRESET_FILE_H
+
+#include "Globals.h"
+#include "Tlv.h"
+
+// ============================================
+// PRESET FILE (TLV)
+// /presets.bin as tagged sections (Tlv.h) instead of raw struct images:
+// every button, message and preset property is its own field, so a
+// struct change (longer SysEx buffer, new fields) no longer makes the
+// loader throw presets away. Rules for changing the format:
+// - never reuse a tag; add new tags for new fields
+// - a field that is missing decodes as 0 (the record is cleared first),
+//   so new fields need 0 to mean "default"
+// - PRESET_FILE_VERSION only changes if a field changes meaning
+// Files from before this format start with the old version byte (<= 4),
+// never with the magic; Storage.cpp loads those once and rewrites them.
+//
+// Every file ends with a PSEC_COMMIT section holding a generation number
+// and the CRC of all bytes before it. Storage.cpp keeps two slot files and
+// writes the inactive one: until its commit section is complete the slot
+// does not count, so a power cut mid-save leaves the previous slot current.
+// At boot the committed slot with the newest generation wins.
+//
+// Small edits do not rewrite a slot: the changed records (found by
+// comparing per-record CRCs with the last save) are appended as an entry
+// to a log file - data sections holding just those records, then a commit
+// section whose CRC covers the entry. Entries apply on top of the slot
+// with the same generation, in order, up to the first incomplete one.
+// ============================================
+
+#define PRESET_FILE_MAGIC "CHPF"
+#define PRESET_FILE_VERSION 1
+#define PRESET_LOG_MAGIC "CHPL"
+
+enum PresetSectionTag : uint8_t {
+  PSEC_BUTTONS = 1,
+  PSEC_NAMES = 2,
+  PSEC_LED_MODES = 3,
+  PSEC_SYNC_MODES = 4,
+  PSEC_SPECIALS = 5,
+  PSEC_META = 6,
+  PSEC_COMMIT = 7 // Last section: generation + CRC of the preceding bytes
+};
+
+struct PresetFileResult {
+  bool valid;          // Magic matched
+  uint8_t version;     // PRESET_FILE_VERSION of the file
+  uint8_t sections;    // Sections decoded
+  uint8_t damaged;     // Sections skipped for a CRC mismatch
+  uint8_t unknown;     // Sections skipped as unknown (newer firmware)
+  bool truncated;      // File ends inside a section
+  uint32_t generation; // From the commit section (0 if none)
+};
+
+struct PresetLogResult {
+  uint16_t entries;  // Entries applied
+  uint16_t stale;    // Entries for another slot generation (skipped)
+  bool torn;         // Bytes after the last complete entry
+  uint32_t validEnd; // Offset after the last complete entry
+};
+
+// Which records changed since the last save (one flag per record)
+struct PresetDirty {
+  bool buttons[CHOCO_MAX_PRESETS][MAX_BUTTONS];
+  bool presets[CHOCO_MAX_PRESETS]; // Name, LED mode, sync mode
+  bool specials[MAX_BUTTONS];
+  bool meta;
+};
+
+// CRC of each record's encoding - the saved state to diff against
+struct PresetCrcs {
+  uint32_t buttons[CHOCO_MAX_PRESETS][MAX_BUTTONS];
+  uint32_t presets[CHOCO_MAX_PRESETS];
+  uint32_t specials[MAX_BUTTONS];
+  uint32_t meta;
+};
+
+// Encode buttonConfigs, presetNames, presetLedModes, presetSyncMode,
+// globalSpecialActions and the config metadata, then the commit section.
+// False if a write failed.
+bool writePresetFile(TlvSink &sink, uint32_t generation);
+// True if the file ends in a complete commit section that matches the
+// bytes before it (the whole save reached flash)
+bool presetFileCommitted(TlvSource &src, uint32_t *generation);
+// Decode over the current globals - load defaults first, so sections that
+// are missing or damaged keep them
+PresetFileResult readPresetFile(TlvSource &src);
+
+void presetFileCrcs(PresetCrcs *out);
+// Flag records whose CRC differs; returns how many
+int presetFileDiff(const PresetCrcs &saved, const PresetCrcs &now,
+                   PresetDirty *dirty);
+// Append one log entry with the dirty records; header for a new log file
+bool writePresetLogEntry(TlvSink &sink, const PresetDirty &dirty,
+                         uint32_t generation, bool header);
+// Apply the complete entries written against slot generation
+PresetLogResult replayPresetLog(TlvSource &src, uint32_t generation);
+
+#endif
@@ -0,0 +1,259 @@
+#include "SettingsCache.h"
+#include <Preferences.h>
+
+SettingsCacheStats settingsCacheStats = {0, 0, 0, 0, 0, 0};
+
+enum SettingsType : uint8_t {
+  ST_INT,
+  ST_UCHAR,
+  ST_USHORT,
+  ST_BOOL,
+  ST_STRING,
+  ST_BYTES
+};
+
+struct SettingsEntry {
+  const char *ns;
+  const char *key;
+  SettingsType type;
+  bool dirty;
+  bool lazy;
+  bool valid;   // value holds the last put (false after a write-through)
+  uint16_t len; // Value bytes (strings include the NUL)
+  uint16_t cap;
+  uint16_t off; // Into pool
+  uint32_t writes;
+};
+
+static SettingsEntry entries[SETTINGS_MAX_KEYS];
+static uint8_t pool[SETTINGS_POOL_BYTES];
+static bool soonPending = false;
+static bool lazyPending = false;
+static unsigned long lastPutMs = 0;
+static unsigned long lazySinceMs = 0;
+
+static void writeEntry(Preferences &prefs, const SettingsEntry &e,
+                       const uint8_t *v) {
+  switch (e.type) {
+  case ST_INT: {
+    int32_t x;
+    memcpy(&x, v, 4);
+    prefs.putInt(e.key, x);
+    break;
+  }
+  case ST_UCHAR:
+    prefs.putUChar(e.key, v[0]);
+    break;
+  case ST_USHORT: {
+    uint16_t x;
+    memcpy(&x, v, 2);
+    prefs.putUShort(e.key, x);
+    break;
+  }
+  case ST_BOOL:
+    prefs.putBool(e.key, v[0]);
+    break;
+  case ST_STRING:
+    prefs.putString(e.key, (const char *)v);
+    break;
+  case ST_BYTES:
+    prefs.putBytes(e.key, v, e.len);
+    break;
+  }
+  settingsCacheStats.writes++;
+}
+
+static SettingsEntry *findEntry(const char *ns, const char *key) {
+  for (int i = 0; i < settingsCacheStats.keys; i++) {
+    if (strcmp(entries[i].key, key) == 0 && strcmp(entries[i].ns, ns) == 0)
+      return &entries[i];
+  }
+  return nullptr;
+}
+
+static SettingsEntry *addEntry(const char *ns, const char *key,
+                               SettingsType type, size_t len, size_t cap) {
+  // Strings get room to grow (up to their field size if known); other
+  // values keep their size
+  if (cap < len)
+    cap = type == ST_STRING && len < 32 ? 32 : len;
+  cap = (cap + 3) & ~3;
+  if (settingsCacheStats.keys >= SETTINGS_MAX_KEYS ||
+      settingsCacheStats.pool + cap > SETTINGS_POOL_BYTES)
+    return nullptr;
+  SettingsEntry &e = entries[settingsCacheStats.keys++];
+  e.ns = ns;
+  e.key = key;
+  e.type = type;
+  e.dirty = false;
+  e.lazy = false;
+  e.valid = false;
+  e.len = 0;
+  e.cap = cap;
+  e.off = settingsCacheStats.pool;
+  e.writes = 0;
+  settingsCacheStats.pool += cap;
+  return &e;
+}
+
+// A value outgrew its slot: extend the slot if it is the last one, else move
+// it to the end of the pool (the old bytes stay unused until reboot)
+static bool growEntry(SettingsEntry &e, size_t len) {
+  size_t cap = (len + 3) & ~3;
+  bool last = e.off + e.cap == settingsCacheStats.pool;
+  size_t start = last ? e.off : settingsCacheStats.pool;
+  if (start + cap > SETTINGS_POOL_BYTES)
+    return false;
+  if (!last && e.valid)
+    memcpy(&pool[start], &pool[e.off], e.len);
+  e.off = start;
+  e.cap = cap;
+  settingsCacheStats.pool = start + cap;
+  return true;
+}
+
+static void put(const char *ns, const char *key, SettingsType type,
+                const void *value, size_t len, SettingsPriority prio,
+                size_t cap = 0) {
+  settingsCacheStats.puts++;
+  SettingsEntry *e = findEntry(ns, key);
+  if (!e)
+    e = addEntry(ns, key, type, len, cap);
+
+  if (!e || (len > e->cap && !growEntry(*e, len))) {
+    // No room to hold it back - write through
+    Preferences prefs;
+    if (prefs.begin(ns, false)) {
+      SettingsEntry tmp = {};
+      tmp.ns = ns;
+      tmp.key = key;
+      tmp.type = type;
+      tmp.len = len;
+      writeEntry(prefs, tmp, (const uint8_t *)value);
+      prefs.end();
+    }
+    if (e) {
+      e->writes++;
+      e->valid = false;
+      e->dirty = false;
+    }
+    return;
+  }
+
+  uint8_t *v = &pool[e->off];
+  if (e->valid && e->len == len && memcmp(v, value, len) == 0) {
+    if (!e->dirty)
+      settingsCacheStats.skipped++;
+    return;
+  }
+  memcpy(v, value, len);
+  e->len = len;
+  e->valid = true;
+  e->dirty = true;
+  e->lazy = prio == SETTINGS_LAZY;
+  if (e->lazy) {
+    if (!lazyPending)
+      lazySinceMs = millis();
+    lazyPending = true;
+  } else {
+    soonPending = true;
+    lastPutMs = millis();
+  }
+}
+
+void settingsPutInt(const char *ns, const char *key, int32_t value,
+                    SettingsPriority prio) {
+  put(ns, key, ST_INT, &value, 4, prio);
+}
+
+void settingsPutUChar(const char *ns, const char *key, uint8_t value) {
+  put(ns, key, ST_UCHAR, &value, 1, SETTINGS_SOON);
+}
+
+void settingsPutUShort(const char *ns, const char *key, uint16_t value) {
+  put(ns, key, ST_USHORT, &value, 2, SETTINGS_SOON);
+}
+
+void settingsPutBool(const char *ns, const char *key, bool value) {
+  uint8_t b = value;
+  put(ns, key, ST_BOOL, &b, 1, SETTINGS_SOON);
+}
+
+void settingsPutString(const char *ns, const char *key, const char *value,
+                       size_t size) {
+  put(ns, key, ST_STRING, value, strlen(value) + 1, SETTINGS_SOON, size);
+}
+
+void settingsPutBytes(const char *ns, const char *key, const void *value,
+                      size_t len) {
+  put(ns, key, ST_BYTES, value, len, SETTINGS_SOON);
+}
+
+void settingsAssumeSaved() {
+  for (int i = 0; i < settingsCacheStats.keys; i++)
+    entries[i].dirty = false;
+  soonPending = false;
+  lazyPending = false;
+}
+
+int settingsPending() {
+  int n = 0;
+  for (int i = 0; i < settingsCacheStats.keys; i++)
+    n += entries[i].dirty;
+  return n;
+}
+
+void settingsFlush() {
+  if (!soonPending && !lazyPending)
+    return;
+  soonPending = false;
+  lazyPending = false;
+
+  // One begin/end per namespace with dirty keys
+  int written = 0;
+  for (int i = 0; i < settingsCacheStats.keys; i++) {
+    if (!entries[i].dirty)
+      continue;
+    const char *ns = entries[i].ns;
+    Preferences prefs;
+    if (!prefs.begin(ns, false)) {
+      Serial.printf("ERROR: Cannot open NVS namespace %s!\n", ns);
+      soonPending = true; // Keys stay dirty - retry after the quiet period
+      lastPutMs = millis();
+      break;
+    }
+    for (int j = i; j < settingsCacheStats.keys; j++) {
+      SettingsEntry &e = entries[j];
+      if (!e.dirty || strcmp(e.ns, ns) != 0)
+        continue;
+      writeEntry(prefs, e, &pool[e.off]);
+      e.dirty = false;
+      e.writes++;
+      written++;
+    }
+    prefs.end();
+  }
+  settingsCacheStats.flushes++;
+  Serial.printf("Settings flushed - %d keys written\n", written);
+}
+
+void settingsService() {
+  unsigned long now = millis();
+  if ((soonPending && now - lastPutMs >= SETTINGS_QUIET_MS) ||
+      (lazyPending && now - lazySinceMs >= SETTINGS_LAZY_MS))
+    settingsFlush();
+}
+
+void settingsPrintStats(Print &out) {
+  out.printf("NVS_STATS:puts=%u,skipped=%u,writes=%u,flushes=%u,pending=%d,"
+             "keys=%u,pool=%u/%u\n",
+             settingsCacheStats.puts, settingsCacheStats.skipped,
+             settingsCacheStats.writes, settingsCacheStats.flushes,
+             settingsPending(), settingsCacheStats.keys,
+             settingsCacheStats.pool, SETTINGS_POOL_BYTES);
+  for (int i = 0; i < settingsCacheStats.keys; i++) {
+    if (entries[i].writes)
+      out.printf("NVS_KEY:%s/%s=%u\n", entries[i].ns, entries[i].key,
+                 entries[i].writes);
+  }
+}
@@ -0,0 +1,59 @@
+#ifndef SETTINGS_CACHE_H
+#define SETTINGS_CACHE_H
+
+#include <Arduino.h>
+
+// ============================================
+// SETTINGS CACHE (write-behind NVS)
+// Preferences writes go through here instead of straight to NVS. A put
+// whose value matches what NVS already holds is dropped; a changed value
+// is kept in RAM and marked dirty. Dirty keys are written in one batch
+// (one Preferences begin/end per namespace) once no put arrived for
+// SETTINGS_QUIET_MS, so a burst of edits costs one write per changed key.
+// SETTINGS_LAZY puts (battery calibration) wait up to SETTINGS_LAZY_MS
+// unless a normal batch takes them along earlier.
+// String slots are sized for their field; a value that outgrows its slot
+// moves to a bigger one instead of writing through on every save.
+// settingsFlush() writes everything now - call it before ESP.restart().
+// Namespace and key strings must be literals (they are kept, not copied).
+// Loop task only.
+// ============================================
+
+#define SETTINGS_MAX_KEYS 48
+#define SETTINGS_POOL_BYTES 1536 // Pending values; larger ones write through
+#define SETTINGS_QUIET_MS 2000
+#define SETTINGS_LAZY_MS 300000 // 5 min
+
+enum SettingsPriority : uint8_t { SETTINGS_SOON, SETTINGS_LAZY };
+
+struct SettingsCacheStats {
+  uint32_t puts;    // Put calls
+  uint32_t skipped; // Puts equal to the stored value (no write)
+  uint32_t writes;  // NVS key writes
+  uint32_t flushes; // Batches
+  uint16_t keys;    // Keys tracked
+  uint16_t pool;    // Pool bytes in use
+};
+extern SettingsCacheStats settingsCacheStats;
+
+void settingsPutInt(const char *ns, const char *key, int32_t value,
+                    SettingsPriority prio = SETTINGS_SOON);
+void settingsPutUChar(const char *ns, const char *key, uint8_t value);
+void settingsPutUShort(const char *ns, const char *key, uint16_t value);
+void settingsPutBool(const char *ns, const char *key, bool value);
+// size: the field's size incl. the NUL, so a longer value later still fits
+void settingsPutString(const char *ns, const char *key, const char *value,
+                       size_t size = 0);
+void settingsPutBytes(const char *ns, const char *key, const void *value,
+                      size_t len);
+
+// The pending values were just read from NVS - mark them clean so the
+// first save after boot only writes what really changed
+void settingsAssumeSaved();
+int settingsPending(); // Dirty keys
+void settingsService(); // loop(): flush when quiet (or lazy keys are due)
+void settingsFlush();   // Write all dirty keys now
+// Per-key NVS writes since boot (wear monitoring)
+void settingsPrintStats(Print &out);
+
+#endif
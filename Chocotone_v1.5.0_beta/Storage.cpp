@@ -1,6 +1,12 @@
 #include "Storage.h"
 #include "AnalogInput.h"
 #include "DefaultPresets.h"
+#include "LedPower.h"
+#include "LedSegments.h"
+#include "MidiCoalescer.h"
+#include "SettingsCache.h"
+#include "TftFrame.h"
+#include "UI_Display.h"
 #include <SPIFFS.h>
 
 #define PRESETS_NAMESPACE "midi_presets"
@@ -11,69 +17,79 @@
 // SYSTEM SETTINGS (v2)
 // ============================================
 
-void saveSystemSettings() {
-  Serial.println("=== Saving System Settings (v2) ===");
-
-  // Use a FRESH LOCAL Preferences object to avoid global state issues
-  Preferences prefs;
-  if (!prefs.begin(PRESETS_NAMESPACE, false)) {
-    Serial.println("ERROR: Cannot open presets namespace for system settings!");
-    return;
-  }
+// Hand every system setting to the settings cache, which writes only the
+// keys whose value changed (see SettingsCache.h)
+static void putSystemSettings() {
+  const char *ns = PRESETS_NAMESPACE;
 
   // Write version marker (prefixed to avoid collision with preset version)
-  prefs.putInt("sys_ver", CURRENT_CONFIG_VERSION);
+  settingsPutInt(ns, "sys_ver", CURRENT_CONFIG_VERSION);
 
   // UI Settings (prefixed with "s_" to distinguish from preset data)
-  prefs.putInt("s_font", buttonNameFontSize);
-  prefs.putInt("s_ledOn", ledBrightnessOn);
-  prefs.putInt("s_ledDim", ledBrightnessDim);
-  prefs.putInt("s_ledTap", ledBrightnessTap);
-  prefs.putInt("s_debounce", buttonDebounce);
-  prefs.putInt("s_rhythm", rhythmPattern);
-  prefs.putInt("s_delay", currentDelayType);
-  prefs.putInt("s_preset", currentPreset);
-  prefs.putInt("s_presCnt", presetCount); // v1.5.2: Preset count (1-8)
+  settingsPutInt(ns, "s_font", buttonNameFontSize);
+  settingsPutInt(ns, "s_ledOn", ledBrightnessOn);
+  settingsPutInt(ns, "s_ledDim", ledBrightnessDim);
+  settingsPutInt(ns, "s_ledTap", ledBrightnessTap);
+  settingsPutUShort(ns, "s_ledMaxMa", ledPowerBudgetMa);
+  settingsPutInt(ns, "s_debounce", buttonDebounce);
+  settingsPutInt(ns, "s_ccRate", ccMaxRateHz);
+  settingsPutUChar(ns, "s_dispTheme", displayTheme);
+  settingsPutInt(ns, "s_rhythm", rhythmPattern);
+  settingsPutInt(ns, "s_delay", currentDelayType);
+  settingsPutInt(ns, "s_preset", currentPreset);
+  settingsPutInt(ns, "s_presCnt", presetCount); // v1.5.2: Preset count (1-8)
 
   // SystemConfig struct fields
-  prefs.putString("s_bleName", systemConfig.bleDeviceName);
-  prefs.putString("s_apSSID", systemConfig.apSSID);
-  prefs.putString("s_apPass", systemConfig.apPassword);
-  prefs.putInt("s_btnCount", systemConfig.buttonCount);
-  prefs.putBytes("s_btnPins", systemConfig.buttonPins,
-                 sizeof(systemConfig.buttonPins));
-  prefs.putInt("s_ledPin", systemConfig.ledPin);
-  prefs.putInt("s_encA", systemConfig.encoderA);
-  prefs.putInt("s_encB", systemConfig.encoderB);
-  prefs.putInt("s_encBtn", systemConfig.encoderBtn);
-  prefs.putBool("s_wifiBoot", systemConfig.wifiOnAtBoot);
-  prefs.putUChar("s_bleMode", (uint8_t)systemConfig.bleMode);
-  prefs.putUChar("s_ledsPerBtn", systemConfig.ledsPerButton);
-  prefs.putBytes("s_ledMap", systemConfig.ledMap, sizeof(systemConfig.ledMap));
+  settingsPutString(ns, "s_bleName", systemConfig.bleDeviceName,
+                    sizeof(systemConfig.bleDeviceName));
+  settingsPutString(ns, "s_apSSID", systemConfig.apSSID,
+                    sizeof(systemConfig.apSSID));
+  settingsPutString(ns, "s_apPass", systemConfig.apPassword,
+                    sizeof(systemConfig.apPassword));
+  settingsPutInt(ns, "s_btnCount", systemConfig.buttonCount);
+  settingsPutBytes(ns, "s_btnPins", systemConfig.buttonPins,
+                   sizeof(systemConfig.buttonPins));
+  settingsPutInt(ns, "s_ledPin", systemConfig.ledPin);
+  settingsPutInt(ns, "s_encA", systemConfig.encoderA);
+  settingsPutInt(ns, "s_encB", systemConfig.encoderB);
+  settingsPutInt(ns, "s_encBtn", systemConfig.encoderBtn);
+  settingsPutBool(ns, "s_wifiBoot", systemConfig.wifiOnAtBoot);
+  settingsPutUChar(ns, "s_bleMode", (uint8_t)systemConfig.bleMode);
+  settingsPutUChar(ns, "s_ledsPerBtn", systemConfig.ledsPerButton);
+  settingsPutBytes(ns, "s_ledMap", systemConfig.ledMap,
+                   sizeof(systemConfig.ledMap));
+  settingsPutUShort(ns, "s_ledCount", ledStripLength);
+  settingsPutString(ns, "s_ledSegs", ledSegmentsText(), LED_SEG_TEXT_LEN);
 
   // OLED Configuration (v1.5)
-  prefs.putBytes("s_oledCfg", &oledConfig, sizeof(OledConfig));
+  settingsPutBytes(ns, "s_oledCfg", &oledConfig, sizeof(OledConfig));
 
   // v1.5 Additions
-  prefs.putBytes("s_muxCfg", &systemConfig.multiplexer,
-                 sizeof(MultiplexerConfig));
-  prefs.putUChar("s_target", (uint8_t)systemConfig.targetDevice);
-  prefs.putUChar("s_midiCh", systemConfig.midiChannel);
-  prefs.putBool("s_debugAin", systemConfig.debugAnalogIn);
-  prefs.putUChar("s_ainCount", systemConfig.analogInputCount);
-  prefs.putUChar("s_battPin", systemConfig.batteryAdcPin); // v1.5: Battery ADC
-  prefs.putInt("s_batMax", batteryAdcMax); // Auto-calibrated max
-  prefs.putInt("s_batMin", batteryAdcMin); // Auto-calibrated min
+  settingsPutBytes(ns, "s_muxCfg", &systemConfig.multiplexer,
+                   sizeof(MultiplexerConfig));
+  settingsPutUChar(ns, "s_target", (uint8_t)systemConfig.targetDevice);
+  settingsPutUChar(ns, "s_midiCh", systemConfig.midiChannel);
+  settingsPutBool(ns, "s_debugAin", systemConfig.debugAnalogIn);
+  settingsPutUChar(ns, "s_ainCount", systemConfig.analogInputCount);
+  settingsPutUChar(ns, "s_battPin",
+                   systemConfig.batteryAdcPin);  // v1.5: Battery ADC
+  settingsPutInt(ns, "s_batMax", batteryAdcMax); // Auto-calibrated max
+  settingsPutInt(ns, "s_batMin", batteryAdcMin); // Auto-calibrated min
+}
 
+void saveSystemSettings() {
+  invalidateDisplayLayout(); // Labels/rows may change
+  putSystemSettings();
   Serial.printf("Saved OLED config: type=%d, rotation=%d\n", oledConfig.type,
                 oledConfig.rotation);
-
-  prefs.end();
-  Serial.println("=== System Settings Saved (v2) ===");
+  Serial.printf("=== System Settings Saved (v2) - %d keys changed ===\n",
+                settingsPending());
 }
 
 void loadSystemSettings() {
-  // Use a FRESH LOCAL Preferences object (consistent with saveSystemSettings)
+  invalidateDisplayLayout(); // Labels/rows may change
+  settingsFlush();           // NVS must hold the latest values
+  // Use a FRESH LOCAL Preferences object
   yield(); // Feed watchdog before NVS operation
   Preferences prefs;
   if (!prefs.begin(PRESETS_NAMESPACE, true)) {
@@ -94,7 +110,13 @@ void loadSystemSettings() {
   ledBrightnessOn = prefs.getInt("s_ledOn", 220);
   ledBrightnessDim = prefs.getInt("s_ledDim", 20);
   ledBrightnessTap = prefs.getInt("s_ledTap", 240);
+  ledPowerBudgetMa = ledPowerClampBudget(
+      prefs.getUShort("s_ledMaxMa", LED_POWER_DEFAULT_MA));
   buttonDebounce = prefs.getInt("s_debounce", 120);
+  ccMaxRateHz = prefs.getInt("s_ccRate", DEFAULT_CC_MAX_RATE_HZ);
+  displayTheme = prefs.getUChar("s_dispTheme", 0);
+  if (displayTheme >= TFT_THEME_COUNT)
+    displayTheme = 0;
   rhythmPattern = prefs.getInt("s_rhythm", 0);
   if (rhythmPattern < 0 || rhythmPattern > 3)
     rhythmPattern = 0;
@@ -147,6 +169,9 @@ void loadSystemSettings() {
                                        8, 9, 10, 11, 12, 13, 14, 15};
     memcpy(systemConfig.ledMap, defaultMap, sizeof(systemConfig.ledMap));
   }
+  ledStripLength = constrain(prefs.getUShort("s_ledCount", NUM_LEDS), 1,
+                             MAX_LEDS);
+  ledSegmentsParse(prefs.getString("s_ledSegs", "").c_str());
 
   // Load OLED Configuration (v1.5)
   if (prefs.getBytesLength("s_oledCfg") == sizeof(OledConfig)) {
@@ -178,156 +203,363 @@ void loadSystemSettings() {
 
   yield(); // Feed watchdog before closing
   prefs.end();
+
+  // The cache starts out knowing what NVS holds, so the first save only
+  // writes keys that really changed
+  putSystemSettings();
+  settingsAssumeSaved();
   Serial.println("=== System Settings Loaded ===");
 }
 
 // ============================================
-// PRESETS - SPIFFS Storage (v4)
+// PRESETS - SPIFFS Storage (TLV sections, see PresetFile.h)
 // NVS has ~20KB limit, not enough for 16KB preset data
 // SPIFFS has 1MB available in the Huge APP partition
+// Saved A/B: each save rewrites the older slot file and only counts once
+// its commit section is on flash and verified, so a power cut mid-save
+// boots the previous presets instead of factory defaults.
 // ============================================
 
+#include "PresetFile.h"
 #include <SPIFFS.h>
 
-#define PRESETS_FILE "/presets.bin"
+#define PRESETS_FILE "/presets.bin" // Before A/B slots (raw v4 or TLV)
 
-void savePresets() {
-  Serial.println("Saving Presets (SPIFFS storage)...");
+static const char *const presetSlotFiles[2] = {"/presets_a.bin",
+                                               "/presets_b.bin"};
+static int8_t presetSlot = -1; // Slot loaded/last committed (-1 = none)
+static uint32_t presetGeneration = 0;
 
-  // Initialize SPIFFS if needed
-  if (!SPIFFS.begin(true)) {
-    Serial.println("ERROR: SPIFFS mount failed!");
-    return;
-  }
+// Incremental saves (PresetFile.h): entries on top of the current slot
+#define PRESETS_LOG_FILE "/presets.log"
+#define PRESETS_LOG_MAX 8192 // Compact into a new slot beyond this
 
-  // Open file for writing
-  File file = SPIFFS.open(PRESETS_FILE, FILE_WRITE);
-  if (!file) {
-    Serial.println("ERROR: Failed to open presets file for writing!");
-    return;
-  }
-
-  // Write version marker
-  uint8_t version = CURRENT_CONFIG_VERSION;
-  file.write(&version, 1);
-
-  // Write all button configs (4 presets × 10 buttons)
-  size_t written = file.write((uint8_t *)buttonConfigs, sizeof(buttonConfigs));
-  Serial.printf("  buttonConfigs: %d/%d bytes\n", written,
-                sizeof(buttonConfigs));
+static uint32_t presetLogSize = 0;
+static bool presetLogReset = false; // Log unusable (torn/stale) - compact
+static PresetCrcs savedPresetCrcs;  // Record CRCs as on flash
 
-  // Write preset names
-  written = file.write((uint8_t *)presetNames, sizeof(presetNames));
-  Serial.printf("  presetNames: %d/%d bytes\n", written, sizeof(presetNames));
-
-  // Write LED modes
-  written = file.write((uint8_t *)presetLedModes, sizeof(presetLedModes));
-  Serial.printf("  ledModes: %d/%d bytes\n", written, sizeof(presetLedModes));
+// SPIFFS.begin() walks the filesystem, so it runs once per boot and every
+// storage user shares the mount
+bool mountStorage() {
+  static bool mounted = false;
+  if (!mounted)
+    mounted = SPIFFS.begin(true);
+  return mounted;
+}
 
-  // Write sync modes
-  written = file.write((uint8_t *)presetSyncMode, sizeof(presetSyncMode));
-  Serial.printf("  syncModes: %d/%d bytes\n", written, sizeof(presetSyncMode));
+// fs::File adapters for the TLV codec. The sink gathers the codec's small
+// field writes into SPIFFS-page sized blocks (~25 file writes per save
+// instead of ~3500).
+#define PRESET_WRITE_BLOCK 256
+
+class FileSink : public TlvSink {
+public:
+  explicit FileSink(File &f) : file(f) {}
+  size_t write(const uint8_t *data, size_t len) override {
+    for (size_t i = 0; i < len; i++) {
+      buf[fill++] = data[i];
+      if (fill == sizeof(buf) && !flush())
+        return i;
+    }
+    return len;
+  }
+  bool flush() {
+    size_t n = fill;
+    fill = 0;
+    return n == 0 || file.write(buf, n) == n;
+  }
 
-  // Write global special actions
-  written =
-      file.write((uint8_t *)globalSpecialActions, sizeof(globalSpecialActions));
-  Serial.printf("  specials: %d/%d bytes\n", written,
-                sizeof(globalSpecialActions));
+private:
+  File &file;
+  uint8_t buf[PRESET_WRITE_BLOCK];
+  size_t fill = 0;
+};
+
+class FileSource : public TlvSource {
+public:
+  explicit FileSource(File &f) : file(f) {}
+  size_t read(uint8_t *data, size_t len) override {
+    return file.read(data, len);
+  }
+  bool seek(uint32_t pos) override { return file.seek(pos); }
+  uint32_t position() override { return file.position(); }
+  uint32_t size() override { return file.size(); }
+
+private:
+  File &file;
+};
+
+// Generation of a slot if it holds a complete, CRC-valid save
+static bool presetSlotCommitted(int slot, uint32_t *generation) {
+  if (!SPIFFS.exists(presetSlotFiles[slot]))
+    return false;
+  File file = SPIFFS.open(presetSlotFiles[slot], FILE_READ);
+  if (!file)
+    return false;
+  FileSource src(file);
+  bool ok = presetFileCommitted(src, generation);
+  file.close();
+  return ok;
+}
 
-  // Write config metadata (editor fields)
-  file.write((uint8_t *)configProfileName, sizeof(configProfileName));
-  file.write((uint8_t *)configLastModified, sizeof(configLastModified));
-  Serial.printf("  metadata: configName='%s'\n", configProfileName);
+// Full save: write the slot that is NOT current, verify, switch to it and
+// drop the log (its entries belong to the old slot)
+static bool compactPresets() {
+  unsigned long startMs = millis();
+  int slot = presetSlot == 0 ? 1 : 0;
+  uint32_t generation = presetGeneration + 1;
+  File file = SPIFFS.open(presetSlotFiles[slot], FILE_WRITE);
+  if (!file) {
+    Serial.println("ERROR: Failed to open presets file for writing!");
+    return false;
+  }
 
+  FileSink sink(file);
+  bool ok = writePresetFile(sink, generation) && sink.flush();
   size_t totalSize = file.size();
   file.close();
 
-  Serial.printf("Presets Saved - %d bytes total\n", totalSize);
+  // Read back before switching: the slot must verify as committed
+  uint32_t readBack = 0;
+  if (!ok || !presetSlotCommitted(slot, &readBack) || readBack != generation) {
+    Serial.printf("ERROR: Presets slot %c failed to verify - keeping slot %c\n",
+                  'A' + slot, presetSlot < 0 ? '-' : 'A' + presetSlot);
+    return false;
+  }
+  presetSlot = slot;
+  presetGeneration = generation;
+
+  // Superseded by the commit: the pre-slot file and the old slot's log
+  if (SPIFFS.exists(PRESETS_FILE))
+    SPIFFS.remove(PRESETS_FILE);
+  if (SPIFFS.exists(PRESETS_LOG_FILE))
+    SPIFFS.remove(PRESETS_LOG_FILE);
+  presetLogSize = 0;
+  presetLogReset = false;
+
+  Serial.printf("Presets Saved - slot %c, gen %u, %d bytes in %lu ms\n",
+                'A' + slot, generation, totalSize, millis() - startMs);
+  return true;
 }
 
-void loadPresets() {
-  Serial.println("Loading Presets (SPIFFS storage)...");
-
-  // Initialize SPIFFS - this can take a while on first boot
-  yield(); // Feed watchdog before potentially slow operation
-  if (!SPIFFS.begin(true)) {
-    Serial.println("ERROR: SPIFFS mount failed!");
-    loadFactoryPresets();
-    return;
+// Incremental save: append the changed records to the log
+static bool appendPresetLog(const PresetDirty &dirty, int records) {
+  unsigned long startMs = millis();
+  File file = SPIFFS.open(PRESETS_LOG_FILE, FILE_APPEND);
+  if (!file) {
+    Serial.println("ERROR: Failed to open presets log!");
+    return false;
   }
-
-  // Check if file exists
-  if (!SPIFFS.exists(PRESETS_FILE)) {
-    Serial.println("No presets file found - loading factory defaults");
-    loadFactoryPresets();
-    savePresets(); // Save defaults to SPIFFS
-    return;
+  size_t before = file.size();
+  FileSink sink(file);
+  bool ok = writePresetLogEntry(sink, dirty, presetGeneration, before == 0) &&
+            sink.flush();
+  size_t after = file.size();
+  file.close();
+  if (!ok) {
+    Serial.println("ERROR: Presets log write failed!");
+    presetLogReset = true; // Tail may be torn - compact instead
+    return false;
   }
+  presetLogSize = after;
+  Serial.printf("Presets Saved - %d records, %d bytes in %lu ms (log %d/%d)\n",
+                records, after - before, millis() - startMs, after,
+                PRESETS_LOG_MAX);
+  return true;
+}
 
-  // Open file for reading
-  File file = SPIFFS.open(PRESETS_FILE, FILE_READ);
-  if (!file) {
-    Serial.println("ERROR: Failed to open presets file!");
-    loadFactoryPresets();
+void savePresets() {
+  invalidateDisplayLayout(); // Labels/rows may change
+  Serial.println("Saving Presets (SPIFFS storage)...");
+
+  if (!mountStorage()) {
+    Serial.println("ERROR: SPIFFS mount failed!");
     return;
   }
 
-  // Read version marker
-  uint8_t version = 0;
-  file.read(&version, 1);
-  Serial.printf("  File version: %d\n", version);
-
-  if (version < CURRENT_CONFIG_VERSION) {
-    Serial.println("  Old version - loading defaults and migrating");
-    file.close();
-    loadFactoryPresets();
-    savePresets();
+  static PresetCrcs current; // Static: ~370 bytes, keep off the stack
+  static PresetDirty dirty;
+  presetFileCrcs(&current);
+  int records = presetFileDiff(savedPresetCrcs, current, &dirty);
+  if (presetSlot >= 0 && records == 0) {
+    Serial.println("Presets unchanged - nothing to write");
     return;
   }
 
+  // Log entries only make sense on top of a slot; a long log costs boot
+  // time and space, so it is folded into a new slot instead
+  bool ok = false;
+  if (presetSlot >= 0 && !presetLogReset && presetLogSize < PRESETS_LOG_MAX)
+    ok = appendPresetLog(dirty, records);
+  if (!ok)
+    ok = compactPresets();
+  if (ok)
+    savedPresetCrcs = current;
+}
+
+// Raw struct images written before the TLV format (config version 4).
+// Only readable while the structs keep the layout they had then.
+static bool loadLegacyPresets(File &file) {
   size_t read = file.read((uint8_t *)buttonConfigs, sizeof(buttonConfigs));
   yield(); // Feed watchdog after large read
   Serial.printf("  buttonConfigs: %d/%d bytes\n", read, sizeof(buttonConfigs));
   if (read != sizeof(buttonConfigs)) {
     Serial.println("  ERROR: Size mismatch - using defaults");
-    file.close();
-    loadFactoryPresets();
-    return;
+    return false;
   }
 
-  // Read preset names
   file.read((uint8_t *)presetNames, sizeof(presetNames));
-
-  // Read LED modes
   file.read((uint8_t *)presetLedModes, sizeof(presetLedModes));
-
-  // Read sync modes
   file.read((uint8_t *)presetSyncMode, sizeof(presetSyncMode));
-  Serial.printf("  Sync Mode: P1=%d P2=%d P3=%d P4=%d\n", presetSyncMode[0],
-                presetSyncMode[1], presetSyncMode[2], presetSyncMode[3]);
 
-  // Read global special actions
+  // Global special actions
   size_t specialsRead =
       file.read((uint8_t *)globalSpecialActions, sizeof(globalSpecialActions));
-  if (specialsRead == sizeof(globalSpecialActions)) {
-    Serial.println("  ✓ Special actions loaded");
-  } else {
+  if (specialsRead != sizeof(globalSpecialActions)) {
     Serial.println("  Special actions missing - using defaults");
     for (int i = 0; i < MAX_BUTTONS; i++) {
       globalSpecialActions[i].hasCombo = false;
     }
   }
 
-  // Read config metadata (editor fields) - optional, may not exist in old files
+  // Config metadata (editor fields) - optional, may not exist in old files
   size_t metadataRead =
       file.read((uint8_t *)configProfileName, sizeof(configProfileName));
   if (metadataRead == sizeof(configProfileName)) {
     file.read((uint8_t *)configLastModified, sizeof(configLastModified));
-    Serial.printf("  metadata: configName='%s'\n", configProfileName);
+  }
+  return true;
+}
+
+static void logPresetFile(const PresetFileResult &res) {
+  Serial.printf("  Format v%d: %d sections, %d damaged, %d unknown%s\n",
+                res.version, res.sections, res.damaged, res.unknown,
+                res.truncated ? ", truncated" : "");
+  Serial.printf("  Sync Mode: P1=%d P2=%d P3=%d P4=%d\n", presetSyncMode[0],
+                presetSyncMode[1], presetSyncMode[2], presetSyncMode[3]);
+  Serial.printf("  metadata: configName='%s'\n", configProfileName);
+}
+
+// /presets.bin from before the A/B slots, loaded once and then committed
+// to a slot by savePresets()
+static void loadPresetsFile() {
+  File file = SPIFFS.open(PRESETS_FILE, FILE_READ);
+  if (!file) {
+    Serial.println("ERROR: Failed to open presets file!");
+    return;
   }
 
+  // TLV files start with the magic, legacy files with their version byte
+  uint8_t first = 0;
+  file.read(&first, 1);
+  if (first == PRESET_FILE_MAGIC[0]) {
+    FileSource src(file);
+    PresetFileResult res = readPresetFile(src);
+    file.close();
+    if (!res.valid) {
+      Serial.println("  ERROR: Unknown presets file - using defaults");
+      return;
+    }
+    logPresetFile(res);
+    Serial.println("✓ Presets file loaded - moving to slots");
+    savePresets();
+    return;
+  }
+
+  Serial.printf("  Legacy file version: %d\n", first);
+  if (first < CURRENT_CONFIG_VERSION) {
+    Serial.println("  Old version - loading defaults and migrating");
+    file.close();
+    savePresets();
+    return;
+  }
+
+  bool ok = loadLegacyPresets(file);
   file.close();
-  Serial.println("✓ Presets Loaded from SPIFFS");
+  if (!ok) {
+    loadFactoryPresets();
+    return;
+  }
+  Serial.println("✓ Legacy presets loaded - rewriting as TLV");
+  savePresets();
+}
+
+// Apply the log entries written since the current slot
+static void replayPresetsLog() {
+  presetLogSize = 0;
+  presetLogReset = false;
+  if (!SPIFFS.exists(PRESETS_LOG_FILE))
+    return;
+  File file = SPIFFS.open(PRESETS_LOG_FILE, FILE_READ);
+  if (!file)
+    return;
+  FileSource src(file);
+  PresetLogResult res = replayPresetLog(src, presetGeneration);
+  presetLogSize = file.size();
+  file.close();
+  // Appending after a torn tail or stale entries would never replay
+  presetLogReset = res.torn || res.stale > 0;
+  Serial.printf("  Log: %d entries, %d stale%s (%d bytes)\n", res.entries,
+                res.stale, res.torn ? ", torn tail" : "", presetLogSize);
+}
+
+void loadPresets() {
+  invalidateDisplayLayout(); // Labels/rows may change
+  Serial.println("Loading Presets (SPIFFS storage)...");
+
+  // Initialize SPIFFS - this can take a while on first boot
+  yield(); // Feed watchdog before potentially slow operation
+  if (!mountStorage()) {
+    Serial.println("ERROR: SPIFFS mount failed!");
+    loadFactoryPresets();
+    return;
+  }
+
+  // Defaults first: the TLV loader only overwrites what the file holds
+  loadFactoryPresets();
+
+  // Newest committed slot wins; a slot cut off mid-save does not count
+  presetSlot = -1;
+  presetGeneration = 0;
+  for (int slot = 0; slot < 2; slot++) {
+    uint32_t generation;
+    if (!presetSlotCommitted(slot, &generation)) {
+      if (SPIFFS.exists(presetSlotFiles[slot]))
+        Serial.printf("  Slot %c incomplete - ignored\n", 'A' + slot);
+      continue;
+    }
+    if (presetSlot < 0 || (int32_t)(generation - presetGeneration) > 0) {
+      presetSlot = slot;
+      presetGeneration = generation;
+    }
+  }
+  yield(); // Feed watchdog after slot scan
+
+  if (presetSlot >= 0) {
+    File file = SPIFFS.open(presetSlotFiles[presetSlot], FILE_READ);
+    if (!file) {
+      Serial.println("ERROR: Failed to open presets file!");
+      return;
+    }
+    FileSource src(file);
+    PresetFileResult res = readPresetFile(src);
+    file.close();
+    yield(); // Feed watchdog after large read
+    Serial.printf("  Slot %c, gen %u\n", 'A' + presetSlot, presetGeneration);
+    replayPresetsLog();
+    logPresetFile(res);
+    presetFileCrcs(&savedPresetCrcs); // What is on flash now
+    Serial.println("✓ Presets Loaded from SPIFFS");
+    return;
+  }
+
+  if (SPIFFS.exists(PRESETS_FILE)) {
+    loadPresetsFile();
+    return;
+  }
+
+  Serial.println("No presets file found - loading factory defaults");
+  savePresets(); // Save defaults to SPIFFS
 }
 
 // initializeGlobalOverrides() removed - globalOverrides no longer used
@@ -338,16 +570,67 @@ void loadPresets() {
 // ============================================
 
 #define ANALOG_FILE "/analog_inputs.bin"
+#define ANALOG_HEADER 3 // version + record size
+
+// Per-input CRC of the persisted fields as on flash. Valid only while the
+// file has the v2 layout with today's record size, so a changed input can
+// be rewritten in place.
+static uint32_t savedAnalogCrc[MAX_ANALOG_INPUTS];
+static bool analogCrcValid = false;
+
+static uint32_t analogInputCrc(int i) {
+  return tlvCrc32(0, (const uint8_t *)&analogInputs[i], AIN_PERSISTED_SIZE);
+}
+
+// Overwrite only the changed records; false if the file needs a rewrite
+static bool saveChangedAnalogInputs(const uint32_t *crc) {
+  File file = SPIFFS.open(ANALOG_FILE, "r+");
+  if (!file)
+    return false;
+  int changed = 0;
+  size_t written = 0;
+  for (int i = 0; i < MAX_ANALOG_INPUTS; i++) {
+    if (crc[i] == savedAnalogCrc[i])
+      continue;
+    changed++;
+    file.seek(ANALOG_HEADER + i * AIN_PERSISTED_SIZE);
+    written += file.write((uint8_t *)&analogInputs[i], AIN_PERSISTED_SIZE);
+  }
+  file.close();
+  if (written != changed * AIN_PERSISTED_SIZE)
+    return false;
+  Serial.printf("Analog Inputs Saved - %d changed, %d bytes\n", changed,
+                written);
+  return true;
+}
 
 void saveAnalogInputs() {
+  invalidateDisplayLayout(); // Labels/rows may change
   Serial.println("Saving Analog Inputs (SPIFFS)...");
 
-  // Initialize SPIFFS
-  if (!SPIFFS.begin(true)) {
+  if (!mountStorage()) {
     Serial.println("ERROR: SPIFFS mount failed!");
     return;
   }
 
+  uint32_t crc[MAX_ANALOG_INPUTS];
+  bool changed = false;
+  for (int i = 0; i < MAX_ANALOG_INPUTS; i++) {
+    crc[i] = analogInputCrc(i);
+    changed |= crc[i] != savedAnalogCrc[i];
+  }
+  if (analogCrcValid) {
+    if (!changed) {
+      Serial.println("Analog Inputs unchanged - nothing to write");
+      return;
+    }
+    if (saveChangedAnalogInputs(crc)) {
+      memcpy(savedAnalogCrc, crc, sizeof(crc));
+      return;
+    }
+    analogCrcValid = false; // Fall back to a full rewrite
+  }
+
   File file = SPIFFS.open(ANALOG_FILE, FILE_WRITE);
   if (!file) {
     Serial.println("ERROR: Failed to open analog file for writing!");
@@ -355,21 +638,32 @@ void saveAnalogInputs() {
   }
 
   // Version marker
-  uint8_t version = 1; // v1 of Analog Input file
+  uint8_t version = 2; // v2: record size + persisted fields only
   file.write(&version, 1);
+  uint16_t recordSize = AIN_PERSISTED_SIZE;
+  file.write((uint8_t *)&recordSize, sizeof(recordSize));
 
-  // Write array
-  size_t written = file.write((uint8_t *)analogInputs, sizeof(analogInputs));
-  Serial.printf("  analogInputs: %d/%d bytes\n", written, sizeof(analogInputs));
+  // Write config part of each input (runtime state is not saved)
+  size_t written = 0;
+  for (int i = 0; i < MAX_ANALOG_INPUTS; i++) {
+    written += file.write((uint8_t *)&analogInputs[i], recordSize);
+  }
+  Serial.printf("  analogInputs: %d/%d bytes\n", written,
+                recordSize * MAX_ANALOG_INPUTS);
 
   file.close();
+  if (written == recordSize * MAX_ANALOG_INPUTS) {
+    memcpy(savedAnalogCrc, crc, sizeof(crc));
+    analogCrcValid = true;
+  }
   Serial.println("Analog Inputs Saved");
 }
 
 void loadAnalogInputs() {
+  invalidateDisplayLayout(); // Labels/rows may change
   Serial.println("Loading Analog Inputs...");
 
-  if (!SPIFFS.begin(true)) {
+  if (!mountStorage()) {
     return;
   }
 
@@ -382,10 +676,31 @@ void loadAnalogInputs() {
     uint8_t version = 0;
     file.read(&version, 1);
 
-    // Read directly into struct
+    // v1 = raw array (record stride = whatever sizeof was when written),
+    // v2 = record size header + persisted fields
+    size_t stride = 0;
+    size_t copyLen = 0;
     if (version == 1) {
-      file.read((uint8_t *)analogInputs, sizeof(analogInputs));
-      Serial.println("✓ Analog Inputs loaded from SPIFFS");
+      stride = (file.size() - 1) / MAX_ANALOG_INPUTS;
+      copyLen = AIN_V1_PERSISTED_SIZE;
+    } else if (version == 2) {
+      uint16_t recordSize = 0;
+      file.read((uint8_t *)&recordSize, sizeof(recordSize));
+      stride = recordSize;
+      copyLen = min((size_t)recordSize, (size_t)AIN_PERSISTED_SIZE);
+    }
+
+    if (stride >= copyLen && copyLen > 0) {
+      size_t base = file.position();
+      for (int i = 0; i < MAX_ANALOG_INPUTS; i++) {
+        analogInputs[i] = AnalogInputConfig(); // Defaults for missing fields
+        file.seek(base + i * stride);
+        file.read((uint8_t *)&analogInputs[i], copyLen);
+      }
+      Serial.printf("✓ Analog Inputs loaded from SPIFFS (v%d)\n", version);
+      analogCrcValid = version == 2 && stride == AIN_PERSISTED_SIZE;
+      for (int i = 0; i < MAX_ANALOG_INPUTS; i++)
+        savedAnalogCrc[i] = analogInputCrc(i);
     } else {
       Serial.println("Unknown analog file version");
     }
@@ -446,18 +761,20 @@ void loadAnalogInputs() {
 // PRESET INDEX
 // ============================================
 
+// Preset switches are coalesced by the settings cache: stepping through
+// presets writes NVS once, after the last switch
 void saveCurrentPresetIndex() {
-  Preferences sysPrefs;
-  sysPrefs.begin("sys_cfg", false);
-  sysPrefs.putInt("preset", currentPreset);
-  sysPrefs.end();
+  settingsPutInt("sys_cfg", "preset", currentPreset);
 }
 
 void loadCurrentPresetIndex() {
+  settingsFlush(); // NVS must hold the latest values
   Preferences sysPrefs;
   sysPrefs.begin("sys_cfg", true);
   currentPreset = sysPrefs.getInt("preset", 0);
   sysPrefs.end();
+  settingsPutInt("sys_cfg", "preset", currentPreset);
+  settingsAssumeSaved();
   if (currentPreset < 0 || currentPreset > 3)
     currentPreset = 0;
 }
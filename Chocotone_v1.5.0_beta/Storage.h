@@ -3,6 +3,7 @@
 
 #include "Globals.h"
 
+bool mountStorage(); // SPIFFS, mounted on first use
 void saveSystemSettings();
 void loadSystemSettings();
 void savePresets();
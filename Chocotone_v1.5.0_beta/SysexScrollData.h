@@ -246,4 +246,22 @@ inline const uint8_t *getSysexScrollMessage(SysexScrollParamId id, int index,
   return list->data + (index * list->msgLength);
 }
 
+// Get a ready-to-send BLE MIDI frame (8080 header .. F7) straight from the
+// flash table - entries are padded, so the length is trimmed at the F7.
+// No copy: the returned pointer is the memory-mapped PROGMEM slice.
+inline const uint8_t *getSysexScrollFrame(const SysexScrollList *list,
+                                          int index, size_t *outLen) {
+  *outLen = 0;
+  if (!list || index < 0 || index >= list->msgCount)
+    return nullptr;
+  const uint8_t *msg = list->data + (index * list->msgLength);
+  for (int k = list->msgLength - 1; k >= 2; k--) {
+    if (pgm_read_byte(msg + k) == 0xF7) {
+      *outLen = k + 1; // Include F7
+      return msg;
+    }
+  }
+  return nullptr;
+}
+
 #endif // SYSEX_SCROLL_DATA_H
@@ -0,0 +1,256 @@
+#include "TftFrame.h"
+#include "DisplayScene.h"
+#include "Globals.h"
+
+#define TFT_FIXED_SLOTS 3 // Background, text, accent
+
+struct ThemeColors {
+  const char *name;
+  uint16_t bg, fg, accent;
+};
+
+static const ThemeColors themes[TFT_THEME_COUNT] = {
+    {"classic", ST7735_BLACK, ST7735_WHITE, ST7735_GREEN},
+    {"amber", ST7735_BLACK, 0xFD20, 0xFFE0},
+    {"ocean", 0x0010, 0x07FF, ST7735_WHITE},
+    {"light", ST7735_WHITE, ST7735_BLACK, 0x0400},
+};
+
+// Colors the UI code draws with for the fixed slots
+static const uint16_t fixedKeys[TFT_FIXED_SLOTS] = {ST7735_BLACK, ST7735_WHITE,
+                                                    ST7735_GREEN};
+
+// 4bpp Adafruit_GFX target, two pixels per byte (even x in the high nibble).
+// Marks the rows it touches so the flush only hashes those.
+class PaletteCanvas4 : public Adafruit_GFX {
+public:
+  PaletteCanvas4(int16_t w, int16_t h, uint8_t *buf, bool *dirty)
+      : Adafruit_GFX(w, h), rowDirty(dirty), rowBytes((w + 1) / 2),
+        buffer(buf) {
+    memcpy(keys, fixedKeys, sizeof(fixedKeys));
+  }
+
+  void drawPixel(int16_t x, int16_t y, uint16_t color) override {
+    if (x < 0 || y < 0 || x >= width() || y >= height())
+      return;
+    uint8_t idx = colorIndex(color);
+    uint8_t &b = buffer[y * rowBytes + (x >> 1)];
+    b = (x & 1) ? (b & 0xF0) | idx : (b & 0x0F) | (idx << 4);
+    rowDirty[y] = true;
+  }
+
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                uint16_t color) override {
+    int16_t x0 = max(x, (int16_t)0), y0 = max(y, (int16_t)0);
+    int16_t x1 = min((int16_t)(x + w), width());
+    int16_t y1 = min((int16_t)(y + h), height());
+    if (x1 <= x0 || y1 <= y0)
+      return;
+    uint8_t idx = colorIndex(color);
+    for (int16_t row = y0; row < y1; row++) {
+      fillSpan(buffer + row * rowBytes, x0, x1, idx);
+      rowDirty[row] = true;
+    }
+  }
+
+  void drawFastHLine(int16_t x, int16_t y, int16_t w,
+                     uint16_t color) override {
+    fillRect(x, y, w, 1, color);
+  }
+
+  void drawFastVLine(int16_t x, int16_t y, int16_t h,
+                     uint16_t color) override {
+    fillRect(x, y, 1, h, color);
+  }
+
+  // Nothing drawn before survives, so the dynamic slots start over. A
+  // screen drawn the same way gets the same slots again.
+  void fillScreen(uint16_t color) override {
+    used = TFT_FIXED_SLOTS;
+    memset(buffer, colorIndex(color) * 0x11, (size_t)rowBytes * height());
+    memset(rowDirty, true, height());
+  }
+
+  const uint8_t *row(int16_t y) const { return buffer + y * rowBytes; }
+
+  uint16_t keys[16] = {}; // Color drawn for each slot
+  uint8_t used = TFT_FIXED_SLOTS;
+  bool *rowDirty;
+  const int16_t rowBytes;
+
+private:
+  static void fillSpan(uint8_t *row, int16_t x0, int16_t x1, uint8_t idx) {
+    if (x0 & 1) {
+      row[x0 >> 1] = (row[x0 >> 1] & 0xF0) | idx;
+      x0++;
+    }
+    int16_t bytes = (x1 - x0) >> 1;
+    memset(row + (x0 >> 1), idx * 0x11, bytes);
+    x0 += bytes * 2;
+    if (x0 < x1)
+      row[x0 >> 1] = (row[x0 >> 1] & 0x0F) | (idx << 4);
+  }
+
+  uint8_t colorIndex(uint16_t color) {
+    for (uint8_t i = 0; i < used; i++)
+      if (keys[i] == color)
+        return i;
+    if (used < 16) {
+      keys[used] = color;
+      return used++;
+    }
+    tftFrameStats.nearest++;
+    uint8_t best = 0;
+    uint32_t bestDist = UINT32_MAX;
+    for (uint8_t i = 0; i < 16; i++) {
+      int dr = ((keys[i] >> 11) & 0x1F) - ((color >> 11) & 0x1F);
+      int dg = ((keys[i] >> 5) & 0x3F) - ((color >> 5) & 0x3F);
+      int db = (keys[i] & 0x1F) - (color & 0x1F);
+      uint32_t dist = dr * dr * 4 + dg * dg + db * db * 4; // 5/6/5 bits
+      if (dist < bestDist) {
+        bestDist = dist;
+        best = i;
+      }
+    }
+    return best;
+  }
+
+  uint8_t *buffer;
+};
+
+TftFrameStats tftFrameStats = {0, 0, 0, 0, 0, 0, 0, 0};
+
+static Adafruit_ST7735 *panel = nullptr;
+static PaletteCanvas4 *canvas = nullptr;
+static void *frameMem = nullptr; // Row hashes, push buffer, flags, pixels
+static uint32_t *rowHash = nullptr;
+static uint16_t *pushBuffer = nullptr;
+static uint16_t shownLut[16]; // Palette the panel was last pushed with
+static bool frameValid = false;
+
+Adafruit_GFX *tftFrameBegin(Adafruit_ST7735 *tft) {
+  tftFrameEnd();
+  int16_t w = tft->width(), h = tft->height();
+  size_t pixelBytes = (size_t)((w + 1) / 2) * h;
+  size_t bytes = h * sizeof(uint32_t) +
+                 (size_t)w * TFT_FRAME_PUSH_ROWS * sizeof(uint16_t) + h +
+                 pixelBytes;
+  if (ESP.getFreeHeap() < bytes + TFT_FRAME_MIN_FREE_HEAP) {
+    Serial.printf("TFT frame: %u bytes would leave too little heap - "
+                  "drawing direct\n",
+                  (unsigned)bytes);
+    return nullptr;
+  }
+  frameMem = malloc(bytes);
+  if (!frameMem)
+    return nullptr;
+
+  rowHash = (uint32_t *)frameMem;
+  pushBuffer = (uint16_t *)(rowHash + h);
+  bool *rowDirty = (bool *)(pushBuffer + w * TFT_FRAME_PUSH_ROWS);
+  uint8_t *pixels = (uint8_t *)(rowDirty + h);
+  canvas = new PaletteCanvas4(w, h, pixels, rowDirty);
+  canvas->fillScreen(ST7735_BLACK);
+  panel = tft;
+  frameValid = false;
+  Serial.printf("TFT frame: %dx%d, 4bpp, %u bytes\n", w, h, (unsigned)bytes);
+  return canvas;
+}
+
+Adafruit_ST7735 *tftFrameEnd() {
+  Adafruit_ST7735 *tft = panel;
+  delete canvas;
+  free(frameMem);
+  canvas = nullptr;
+  frameMem = nullptr;
+  panel = nullptr;
+  return tft;
+}
+
+bool tftFrameActive() { return canvas != nullptr; }
+
+// Expand rows [y0, y1) to RGB565 and push them, TFT_FRAME_PUSH_ROWS at a time
+static void pushRows(int16_t y0, int16_t y1, const uint16_t *lut) {
+  int16_t w = canvas->width();
+  for (int16_t y = y0; y < y1; y += TFT_FRAME_PUSH_ROWS) {
+    int16_t n = min((int16_t)TFT_FRAME_PUSH_ROWS, (int16_t)(y1 - y));
+    uint16_t *out = pushBuffer;
+    for (int16_t r = 0; r < n; r++) {
+      const uint8_t *src = canvas->row(y + r);
+      for (int16_t x = 0; x < w; x += 2) {
+        uint8_t b = *src++;
+        *out++ = lut[b >> 4];
+        if (x + 1 < w)
+          *out++ = lut[b & 0x0F];
+      }
+    }
+    panel->drawRGBBitmap(0, y, pushBuffer, w, n);
+  }
+}
+
+void tftFrameFlush() {
+  if (!canvas)
+    return;
+  unsigned long t0 = micros();
+
+  uint16_t lut[16];
+  memcpy(lut, canvas->keys, sizeof(lut));
+  const ThemeColors &t =
+      themes[displayTheme < TFT_THEME_COUNT ? displayTheme : 0];
+  lut[0] = t.bg;
+  lut[1] = t.fg;
+  lut[2] = t.accent;
+  // A slot that now stands for another color changes pixels whose index
+  // (and row hash) did not
+  bool full = !frameValid || memcmp(lut, shownLut, sizeof(lut)) != 0;
+
+  int16_t h = canvas->height();
+  uint16_t rows = 0;
+  int16_t runStart = -1;
+  for (int16_t y = 0; y <= h; y++) {
+    bool changed = false;
+    if (y < h && (full || canvas->rowDirty[y])) {
+      uint32_t hash = sceneHash(canvas->row(y), canvas->rowBytes);
+      changed = full || hash != rowHash[y];
+      rowHash[y] = hash;
+      canvas->rowDirty[y] = false;
+    }
+    if (changed && runStart < 0) {
+      runStart = y;
+    } else if (!changed && runStart >= 0) {
+      pushRows(runStart, y, lut);
+      rows += y - runStart;
+      runStart = -1;
+    }
+  }
+  memcpy(shownLut, lut, sizeof(lut));
+  frameValid = true;
+
+  uint32_t us = micros() - t0;
+  tftFrameStats.flushes++;
+  if (full)
+    tftFrameStats.fullPushes++;
+  if (rows == 0)
+    tftFrameStats.skipped++;
+  tftFrameStats.lastRows = rows;
+  tftFrameStats.totalRows += rows;
+  tftFrameStats.lastUs = us;
+  if (us > tftFrameStats.maxUs)
+    tftFrameStats.maxUs = us;
+}
+
+const char *tftThemeName(uint8_t theme) {
+  return theme < TFT_THEME_COUNT ? themes[theme].name : "?";
+}
+
+uint16_t tftThemeColor(uint16_t color) {
+  if (!canvas)
+    return color;
+  const ThemeColors &t =
+      themes[displayTheme < TFT_THEME_COUNT ? displayTheme : 0];
+  for (int i = 0; i < TFT_FIXED_SLOTS; i++) {
+    if (color == fixedKeys[i])
+      return i == 0 ? t.bg : i == 1 ? t.fg : t.accent;
+  }
+  return color;
+}
@@ -0,0 +1,64 @@
+#ifndef TFT_FRAME_H
+#define TFT_FRAME_H
+
+#include <Adafruit_ST7735.h>
+#include <Arduino.h>
+
+// ============================================
+// TFT PALETTE FRAMEBUFFER
+// A full RGB565 frame (40 KB at 128x160) does not fit next to BLE and WiFi,
+// so the TFT frame is kept at 4 bits per pixel (10 KB) with a 16-color
+// palette. All UI code draws into it through displayPtr; flushDisplay()
+// expands the rows that changed since the last flush to RGB565, a few rows
+// at a time, and pushes each block as one address window + pixel burst.
+// The panel only ever receives finished frames (no clear-then-draw
+// flicker), and a screen change costs one full push.
+//
+// Palette: 0 = theme background (drawn as ST7735_BLACK), 1 = theme text
+// (ST7735_WHITE), 2 = theme accent (ST7735_GREEN). Slots 3-15 are handed
+// out to other colors (LED strips, swatches) as they are drawn and reset on
+// fillScreen(); when they run out the nearest slot is used.
+//
+// The frame is only allocated if TFT_FRAME_MIN_FREE_HEAP stays free for
+// BLE and WiFi, which start after the display (checkHeapStatus() warns at
+// 20 KB). Otherwise the display keeps drawing direct / through the scene
+// bands and themes are not applied.
+// ============================================
+
+#define TFT_FRAME_MIN_FREE_HEAP 60000 // Left after allocating (BLE/WiFi)
+#define TFT_FRAME_PUSH_ROWS 8         // Rows expanded per SPI block (2 KB)
+
+enum TftTheme : uint8_t {
+  TFT_THEME_CLASSIC, // White on black, green accent
+  TFT_THEME_AMBER,
+  TFT_THEME_OCEAN,
+  TFT_THEME_LIGHT, // Black on white
+  TFT_THEME_COUNT
+};
+
+struct TftFrameStats {
+  uint32_t flushes;
+  uint32_t skipped;    // Nothing changed - no SPI traffic
+  uint32_t fullPushes; // Init, invalidate, theme or palette change
+  uint16_t lastRows;   // Rows pushed by the last flush
+  uint32_t totalRows;
+  uint32_t lastUs;
+  uint32_t maxUs;
+  uint32_t nearest; // Colors mapped to the nearest slot (palette full)
+};
+extern TftFrameStats tftFrameStats;
+
+// Allocate the frame for panel (current size/rotation). Returns the canvas
+// to use as displayPtr, or nullptr if there is not enough heap.
+Adafruit_GFX *tftFrameBegin(Adafruit_ST7735 *panel);
+// Free the frame and return the panel it was pushing to
+Adafruit_ST7735 *tftFrameEnd();
+bool tftFrameActive();
+void tftFrameFlush();      // Push changed rows (caller holds DisplayLock)
+void tftFrameInvalidate(); // Next flush pushes every row
+
+const char *tftThemeName(uint8_t theme);
+// RGB565 the panel shows for color (theme applied when the frame is active)
+uint16_t tftThemeColor(uint16_t color);
+
+#endif
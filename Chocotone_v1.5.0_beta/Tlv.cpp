@@ -0,0 +1,166 @@
+#include "Tlv.h"
+#include <string.h>
+
+// CRC-32 (IEEE, reflected), 4 bits per step - 64-byte table
+uint32_t tlvCrc32(uint32_t crc, const uint8_t *data, size_t len) {
+  static const uint32_t nibble[16] = {
+      0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4,
+      0x4DB26158, 0x5005713C, 0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C,
+      0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C};
+  crc = ~crc;
+  for (size_t i = 0; i < len; i++) {
+    crc ^= data[i];
+    crc = (crc >> 4) ^ nibble[crc & 0x0F];
+    crc = (crc >> 4) ^ nibble[crc & 0x0F];
+  }
+  return ~crc;
+}
+
+bool tlvCrcRange(TlvSource &src, uint32_t from, uint32_t to, uint32_t *crc) {
+  uint8_t buf[64];
+  uint32_t c = 0;
+  if (!src.seek(from))
+    return false;
+  while (from < to) {
+    size_t n = to - from < sizeof(buf) ? to - from : sizeof(buf);
+    if (src.read(buf, n) != n)
+      return false;
+    c = tlvCrc32(c, buf, n);
+    from += n;
+  }
+  *crc = c;
+  return true;
+}
+
+static void putLE(uint8_t *out, uint32_t v, int bytes) {
+  for (int i = 0; i < bytes; i++)
+    out[i] = v >> (8 * i);
+}
+
+static uint32_t getLE(const uint8_t *in, int bytes) {
+  uint32_t v = 0;
+  for (int i = 0; i < bytes; i++)
+    v |= (uint32_t)in[i] << (8 * i);
+  return v;
+}
+
+// ---- Writer ----
+
+void TlvWriter::put(const void *data, size_t len) {
+  if (measuring) {
+    length += len;
+    crc = tlvCrc32(crc, (const uint8_t *)data, len);
+    return;
+  }
+  if (sink->write((const uint8_t *)data, len) != len)
+    failed = true;
+  total += len;
+  totalCrc = tlvCrc32(totalCrc, (const uint8_t *)data, len);
+}
+
+void TlvWriter::begin(const char *magic, uint8_t version) {
+  put(magic, 4);
+  put(&version, 1);
+}
+
+void TlvWriter::section(uint8_t tag, TlvBodyFn body, void *ctx) {
+  measuring = true;
+  length = 0;
+  crc = 0;
+  body(*this, ctx);
+  measuring = false;
+
+  uint8_t header[TLV_SECTION_HEADER];
+  header[0] = tag;
+  putLE(&header[1], length, 4);
+  putLE(&header[5], crc, 4);
+  put(header, sizeof(header));
+  body(*this, ctx);
+}
+
+void TlvWriter::field(uint8_t tag, const void *data, uint8_t len) {
+  uint8_t header[2] = {tag, len};
+  put(header, 2);
+  put(data, len);
+}
+
+void TlvWriter::fieldStr(uint8_t tag, const char *s, size_t maxLen) {
+  size_t len = strnlen(s, maxLen);
+  field(tag, s, len > 255 ? 255 : len);
+}
+
+// ---- Reader ----
+
+bool TlvReader::begin(const char *magic, uint8_t *version) {
+  uint8_t header[TLV_FILE_HEADER];
+  src->seek(0);
+  if (src->read(header, sizeof(header)) != sizeof(header) ||
+      memcmp(header, magic, 4) != 0)
+    return false;
+  *version = header[4];
+  sectionEnd = TLV_FILE_HEADER;
+  fieldEnd = TLV_FILE_HEADER;
+  return true;
+}
+
+bool TlvReader::nextSection(uint8_t *tag) {
+  uint8_t header[TLV_SECTION_HEADER];
+  if (!src->seek(sectionEnd) ||
+      src->read(header, sizeof(header)) != sizeof(header))
+    return false;
+  payloadStart = sectionEnd + TLV_SECTION_HEADER;
+  sectionLen = getLE(&header[1], 4);
+  sectionCrc = getLE(&header[5], 4);
+  if (sectionLen > src->size() - payloadStart)
+    return false; // Truncated file
+  *tag = header[0];
+  sectionEnd = payloadStart + sectionLen;
+  fieldEnd = payloadStart;
+  return true;
+}
+
+bool TlvReader::atEnd() { return sectionEnd >= src->size(); }
+
+bool TlvReader::sectionValid() {
+  uint32_t crc;
+  if (!tlvCrcRange(*src, payloadStart, sectionEnd, &crc))
+    return false;
+  src->seek(payloadStart);
+  fieldEnd = payloadStart;
+  return crc == sectionCrc;
+}
+
+bool TlvReader::nextField(uint8_t *tag, uint8_t *len) {
+  uint8_t header[2];
+  if (fieldEnd + 2 > sectionEnd || !src->seek(fieldEnd) ||
+      src->read(header, 2) != 2)
+    return false;
+  if (fieldEnd + 2 + header[1] > sectionEnd)
+    return false; // Field runs past the section
+  *tag = header[0];
+  *len = header[1];
+  fieldEnd += 2 + header[1];
+  return true;
+}
+
+void TlvReader::read(void *dst, size_t size) {
+  uint32_t pos = src->position();
+  size_t avail = pos < fieldEnd ? fieldEnd - pos : 0;
+  size_t n = size < avail ? size : avail;
+  if (n)
+    n = src->read((uint8_t *)dst, n);
+  memset((uint8_t *)dst + n, 0, size - n);
+}
+
+uint8_t TlvReader::readU8() {
+  uint8_t v;
+  read(&v, 1);
+  return v;
+}
+
+void TlvReader::readStr(char *dst, size_t size) {
+  if (size == 0)
+    return;
+  read(dst, size - 1);
+  dst[size - 1] = '\0';
+}
@@ -0,0 +1,107 @@
+#ifndef TLV_H
+#define TLV_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// ============================================
+// TLV SECTION FILES
+// Self-describing container used by the preset file (PresetFile.h):
+//   file    = magic[4] version:u8 section*
+//   section = tag:u8 length:u32 crc32:u32 payload[length]
+//   payload = field*
+//   field   = tag:u8 length:u8 data[length]
+// Integers are little-endian. Readers skip section and field tags they do
+// not know, and read known fields into fixed destinations (copying what
+// fits, zero-filling the rest), so fields can grow, shrink or be added
+// without breaking older or newer firmware. A section is only decoded
+// after its CRC matched; a damaged section is skipped on its own.
+//
+// The writer runs each section body twice - once to measure length and
+// CRC, once to write - so the header can lead without seeking back or
+// buffering the payload. The reader streams with a small stack buffer and
+// seeks; neither allocates. No Arduino dependencies (host testable).
+// ============================================
+
+#define TLV_FILE_HEADER 5    // magic + version
+#define TLV_SECTION_HEADER 9 // tag + length + crc32
+
+uint32_t tlvCrc32(uint32_t crc, const uint8_t *data, size_t len);
+
+class TlvSource;
+// CRC of src bytes [from, to); false if they cannot be read
+bool tlvCrcRange(TlvSource &src, uint32_t from, uint32_t to, uint32_t *crc);
+
+class TlvSink {
+public:
+  virtual size_t write(const uint8_t *data, size_t len) = 0;
+};
+
+class TlvSource {
+public:
+  virtual size_t read(uint8_t *data, size_t len) = 0;
+  virtual bool seek(uint32_t pos) = 0;
+  virtual uint32_t position() = 0;
+  virtual uint32_t size() = 0;
+};
+
+class TlvWriter;
+typedef void (*TlvBodyFn)(TlvWriter &w, void *ctx);
+
+class TlvWriter {
+public:
+  explicit TlvWriter(TlvSink &sink) : sink(&sink) {}
+  void begin(const char *magic, uint8_t version);
+  // body is called twice and must emit the same fields both times
+  void section(uint8_t tag, TlvBodyFn body, void *ctx);
+  void field(uint8_t tag, const void *data, uint8_t len);
+  void fieldU8(uint8_t tag, uint8_t value) { field(tag, &value, 1); }
+  void fieldStr(uint8_t tag, const char *s, size_t maxLen); // Without NUL
+  bool ok() const { return !failed; } // Every byte reached the sink
+  uint32_t bytes() const { return total; }
+  uint32_t bytesCrc() const { return totalCrc; } // CRC of bytes()
+
+private:
+  void put(const void *data, size_t len);
+  TlvSink *sink;
+  bool measuring = false;
+  bool failed = false;
+  uint32_t length = 0; // Current section (measure pass)
+  uint32_t crc = 0;
+  uint32_t total = 0;
+  uint32_t totalCrc = 0;
+};
+
+class TlvReader {
+public:
+  explicit TlvReader(TlvSource &src) : src(&src) {}
+  // False if the magic does not match
+  bool begin(const char *magic, uint8_t *version);
+  // Advance to the next section header; false at the end or if the file
+  // is cut short
+  bool nextSection(uint8_t *tag);
+  // Make nextSection() continue at offset (a sectionOffset())
+  void seekSection(uint32_t offset) { sectionEnd = fieldEnd = offset; }
+  bool atEnd(); // No bytes after the last section (vs. cut short)
+  uint32_t sectionLength() const { return sectionLen; }
+  uint32_t sectionOffset() const { return payloadStart - TLV_SECTION_HEADER; }
+  // Check the payload CRC and rewind to its first field
+  bool sectionValid();
+  // Next field of the current section (skips what was not read of the
+  // previous one); false at the end of the section
+  bool nextField(uint8_t *tag, uint8_t *len);
+  // Sequential reads within the current field; past its end: zeros
+  void read(void *dst, size_t size);
+  uint8_t readU8();
+  void readStr(char *dst, size_t size); // Rest of the field, NUL-terminated
+
+private:
+  TlvSource *src;
+  uint32_t payloadStart = 0;
+  uint32_t sectionEnd = 0;
+  uint32_t sectionLen = 0;
+  uint32_t sectionCrc = 0;
+  uint32_t fieldEnd = 0;
+};
+
+#endif
@@ -1,6 +1,17 @@
 #include "UI_Display.h"
 #include "AnalogInput.h"
+#include "DisplayCapture.h"
+#include "DisplayScene.h"
+#include "DisplayTask.h"
+#include "LabelCache.h"
+#include "LedAnim.h"
+#include "LedMeter.h"
+#include "LedSegments.h"
+#include "LedTask.h"
+#include "OledFlush.h"
+#include "SettingsCache.h"
 #include "SysexScrollData.h"
+#include "TftFrame.h"
 #include <SPI.h> // For TFT displays
 #include <Wire.h>
 
@@ -14,22 +25,34 @@
        ? ST7735_BLACK                                                          \
        : SSD1306_BLACK)
 
-// Helper to flush display (OLED needs this, TFT doesn't or at least not the
-// same way)
+// Helper to flush display (OLED, and TFT when it draws into the palette
+// frame - otherwise TFT drawing is already on the panel)
 void flushDisplay() {
-  if (displayPtr == nullptr)
+  if (displayPtr == nullptr || displayCaptureActive())
     return;
-  if (oledConfig.type != TFT_128X128 && oledConfig.type != TFT_128X160) {
-    static_cast<Adafruit_SSD1306 *>(displayPtr)->display();
+  if (oledConfig.type == TFT_128X128 || oledConfig.type == TFT_128X160) {
+    tftFrameFlush(); // Changed rows only (see TftFrame.h)
+  } else {
+    // Changed pages/columns only (see OledFlush.h)
+    oledFlush(static_cast<Adafruit_SSD1306 *>(displayPtr),
+              oledConfig.type == OLED_128X32 ? 32 : 64);
   }
 }
 
+static void invalidateAnalogMeters(); // See ANALOG METERS below
+
 // Helper to clear display buffer
 void clearDisplayBuffer() {
   if (displayPtr == nullptr)
     return;
+  if (displayCaptureActive()) {
+    displayPtr->fillScreen(0); // Probe canvas - panel and scene untouched
+    return;
+  }
+  invalidateAnalogMeters();
   if (oledConfig.type == TFT_128X128 || oledConfig.type == TFT_128X160) {
     displayPtr->fillScreen(ST7735_BLACK);
+    sceneInvalidate(); // Main screen must be repainted in full
   } else {
     static_cast<Adafruit_SSD1306 *>(displayPtr)->clearDisplay();
   }
@@ -83,18 +106,11 @@ void updateBatteryLevel() {
     batteryPercent = 100;
   }
 
-  // Save calibration to NVS periodically (every 5 minutes) to avoid flash wear
-  static unsigned long lastCalibrationSave = 0;
-  if (calibrationChanged && (millis() - lastCalibrationSave > 300000)) {
-    lastCalibrationSave = millis();
-    Preferences prefs;
-    if (prefs.begin("midi_presets", false)) {
-      prefs.putInt("s_batMax", batteryAdcMax);
-      prefs.putInt("s_batMin", batteryAdcMin);
-      prefs.end();
-      Serial.printf("[BAT] Calibration saved: min=%d max=%d\n", batteryAdcMin,
-                    batteryAdcMax);
-    }
+  // Calibration is written lazily by the settings cache (at most every
+  // SETTINGS_LAZY_MS, or with the next settings batch) to avoid flash wear
+  if (calibrationChanged) {
+    settingsPutInt("midi_presets", "s_batMax", batteryAdcMax, SETTINGS_LAZY);
+    settingsPutInt("midi_presets", "s_batMin", batteryAdcMin, SETTINGS_LAZY);
   }
 
   Serial.printf("[BAT] Pin:%d ADC:%d -> %d%% (range: %d-%d)\n",
@@ -176,6 +192,13 @@ void getButtonSummary(char *b, size_t s, MidiCommandType type, int data1) {
   case CC:
     snprintf(b, s, "CC%d", data1);
     break;
+  case CC_14BIT:
+    snprintf(b, s, "H%d", data1);
+    break;
+  case NRPN:
+    strncpy(b, "NRPN", s - 1);
+    b[s - 1] = '\0';
+    break;
   case PC:
     snprintf(b, s, "PC%d", data1);
     break;
@@ -242,7 +265,7 @@ void getButtonSummary(char *b, size_t s, MidiCommandType type, int data1) {
 
 // Logic to get a label string for an input ID (e.g. "1", "A1")
 void getInputLabel(char *target, size_t targetSize, const char *labelId,
-                   int maxCharsDisplay) {
+                   int maxCharsDisplay, int preset) {
   if (labelId[0] == 'A' || labelId[0] == 'a') {
     int aIdx = atoi(&labelId[1]) - 1;
     if (aIdx >= 0 && aIdx < MAX_ANALOG_INPUTS && analogInputs[aIdx].enabled) {
@@ -254,7 +277,7 @@ void getInputLabel(char *target, size_t targetSize, const char *labelId,
   } else {
     int bIdx = atoi(labelId) - 1;
     if (bIdx >= 0 && bIdx < systemConfig.buttonCount) {
-      const ButtonConfig &config = buttonConfigs[currentPreset][bIdx];
+      const ButtonConfig &config = buttonConfigs[preset][bIdx];
       char defaultName[21];
       snprintf(defaultName, sizeof(defaultName), "B%d", bIdx + 1);
       if (strncmp(config.name, defaultName, 20) == 0 ||
@@ -279,62 +302,285 @@ void getInputLabel(char *target, size_t targetSize, const char *labelId,
   }
 }
 
-void displayOLED() {
-  // Skip display updates when heap is critically low (WiFi uses lots of memory)
-  if (ESP.getFreeHeap() < 20000) {
-    return;
-  }
+// ============================================
+// COMPILED MAIN SCREEN LAYOUT
+// The top/bottom row maps ("1,2,A1,...") are parsed into positioned items
+// once per (preset, layout generation) instead of on every frame. Anything
+// that changes labels, row maps, colors or screen geometry must call
+// invalidateDisplayLayout() (Storage save/load functions do).
+// ============================================
 
-  // Skip if no display configured (OLED_NONE)
-  if (displayPtr == nullptr || oledConfig.type == OLED_NONE) {
+#define MAX_LAYOUT_ITEMS 34 // Two 33-char maps of single-digit items
+
+struct MainLayoutItem {
+  char label[11];
+  int16_t x, y;        // Label position
+  int8_t analog;       // Analog input for a live loading bar, -1 = none
+  int16_t x0, stripY;  // Strip rect (stripW 0 = no strip)
+  int16_t stripW, stripH;
+  uint16_t stripColor;
+};
+
+static MainLayoutItem mainLayout[MAX_LAYOUT_ITEMS];
+static uint8_t mainLayoutCount = 0;
+static uint32_t layoutGeneration = 1;
+static uint32_t compiledGeneration = 0;
+static int compiledPreset = -1;
+
+MainScreenStats mainScreenStats = {0, 0, 0, 0, 0};
+
+void invalidateDisplayLayout() { layoutGeneration++; }
+
+static inline uint16_t rgbTo565(const uint8_t *rgb) {
+  return ((rgb[0] >> 3) << 11) | ((rgb[1] >> 2) << 5) | (rgb[2] >> 3);
+}
+
+static void compileRow(const char *rowMap, bool isTop, int rowY, uint8_t align,
+                       int w, int h) {
+  uint8_t labelSize = oledConfig.main.labelSize;
+  bool isVertical = (oledConfig.rotation == 1 || oledConfig.rotation == 3);
+  bool isTft =
+      oledConfig.type == TFT_128X128 || oledConfig.type == TFT_128X160;
+  bool showStrips = oledConfig.main.showColorStrips; // Analog bars on OLED
+
+  char tempMap[34];
+  strncpy(tempMap, rowMap, 33);
+  tempMap[33] = '\0';
+  int itemCount = 0;
+  for (char *p = tempMap; *p; p++) {
+    if (*p == ',')
+      itemCount++;
+  }
+  if (strlen(tempMap) > 0)
+    itemCount++;
+  if (itemCount == 0)
     return;
+
+  int lineH = labelSize * 8 + 2;
+  int yOffset = rowY; // Vertical: top row items at the top
+  if (isVertical && !isTop) {
+    // Vertical: bottom row items at the bottom
+    yOffset = h - (itemCount * lineH) - 2;
+    if (yOffset < h / 2)
+      yOffset = h / 2; // Prevent overlap
+  }
+  int maxChars = isVertical ? ((w < 40) ? 4 : 8) : ((itemCount > 4) ? 3 : 4);
+  int dynColWidth = w / itemCount;
+
+  char *saveptr = NULL;
+  char *token = strtok_r(tempMap, ",", &saveptr);
+  for (int i = 0; token != NULL && mainLayoutCount < MAX_LAYOUT_ITEMS; i++) {
+    MainLayoutItem &item = mainLayout[mainLayoutCount++];
+    getInputLabel(item.label, sizeof(item.label), token, maxChars,
+                  compiledPreset);
+    item.analog = -1;
+    item.stripW = 0;
+
+    if (isVertical) {
+      item.x = 1;
+      item.y = yOffset;
+      yOffset += lineH;
+      token = strtok_r(NULL, ",", &saveptr);
+      if (isTop && yOffset > h / 2)
+        break; // Stop if too many items
+      continue;
+    }
+
+    // Horizontal: align the label within its column
+    int textWidth = strlen(item.label) * 6 * labelSize;
+    int colStart = i * dynColWidth;
+    item.x = colStart; // Default: left align
+    if (align == 1) {
+      item.x = colStart + (dynColWidth - textWidth) / 2; // Center
+    } else if (align == 2) {
+      item.x = colStart + dynColWidth - textWidth; // Right
+    }
+    item.y = rowY;
+
+    // Color strip below (top row) / above (bottom row) the label
+    if (showStrips) {
+      int stripH = oledConfig.main.colorStripHeight > 0
+                       ? oledConfig.main.colorStripHeight
+                       : 4;
+      item.x0 = colStart;
+      item.stripH = stripH;
+      item.stripY = isTop ? rowY + (labelSize * 8) + 1 : rowY - stripH - 1;
+
+      if (token[0] == 'A' || token[0] == 'a') {
+        int ainIdx = atoi(&token[1]) - 1;
+        if (ainIdx >= 0 && ainIdx < MAX_ANALOG_INPUTS &&
+            analogInputs[ainIdx].enabled) {
+          item.analog = ainIdx;
+          item.stripW = dynColWidth - 2;
+          item.stripColor =
+              isTft ? rgbTo565(analogInputs[ainIdx].rgb) : SSD1306_WHITE;
+        }
+      } else if (isTft) {
+        // Button - full-width strip in the first action's color
+        int btnIdx = atoi(token) - 1;
+        if (btnIdx >= 0 && btnIdx < MAX_BUTTONS) {
+          ButtonConfig &btn = buttonConfigs[compiledPreset][btnIdx];
+          if (btn.messageCount > 0) {
+            item.stripW = dynColWidth - 2;
+            item.stripColor = rgbTo565(btn.messages[0].rgb);
+          }
+        }
+      }
+    }
+    token = strtok_r(NULL, ",", &saveptr);
   }
+}
 
-  // Check if in tap tempo mode
-  if (inTapTempoMode) {
-    displayTapTempoMode();
+// Rebuild the plan if the preset or anything it depends on changed. The
+// frame reads compiledPreset only: a press on core 1 may switch currentPreset
+// mid-frame, and its own refresh request redraws the new preset.
+static void compileMainLayout() {
+  int preset = currentPreset;
+  if (compiledGeneration == layoutGeneration && compiledPreset == preset)
     return;
+  compiledPreset = preset;
+  labelCacheClear(); // Old preset's / config's labels
+  invalidateAnalogMeters();
+
+  int w = displayPtr->width();
+  int h = displayPtr->height();
+  uint8_t bottomRowY = oledConfig.main.bottomRowY;
+  if (oledConfig.type == OLED_128X32 && bottomRowY > 24) {
+    bottomRowY = 24; // Clamp for 128x32 if using default 128x64 value
   }
 
-  if (buttonNameDisplayUntil > 0) {
-    if (millis() < buttonNameDisplayUntil) {
-      displayButtonName();
-      return;
-    } else {
-      buttonNameDisplayUntil = 0;
+  mainLayoutCount = 0;
+  if (oledConfig.main.showTopRow)
+    compileRow(oledConfig.main.topRowMap, true, oledConfig.main.topRowY,
+               oledConfig.main.topRowAlign, w, h);
+  if (oledConfig.main.showBottomRow)
+    compileRow(oledConfig.main.bottomRowMap, false, bottomRowY,
+               oledConfig.main.bottomRowAlign, w, h);
+
+  compiledGeneration = layoutGeneration;
+  mainScreenStats.compiles++;
+}
+
+// ============================================
+// ANALOG METERS
+// Analog bars on the main screen are not part of the retained scene: each
+// remembers the fill width on screen and a value change only paints the
+// columns between the old and new width (grow in color, shrink in black).
+// The analog pipeline flags changes (analogMeterDirty) and loop() turns them
+// into DISPLAY_REASON_ANALOG requests; a frame with no other reason runs
+// displayAnalogMeters() instead of the whole main screen.
+// ============================================
+
+static int16_t meterShownW[MAX_LAYOUT_ITEMS]; // Fill width on screen
+static bool metersValid = false; // meterShownW matches the screen
+
+static void invalidateAnalogMeters() { metersValid = false; }
+
+static int meterFillWidth(const MainLayoutItem &item) {
+  uint32_t pos = analogInputs[item.analog].meterPos;
+  int fillW = (item.stripW * pos + AIN_HIRES_MAX / 2) / AIN_HIRES_MAX;
+  if (fillW < 1 && pos > AIN_HIRES_MAX / 100)
+    fillW = 1; // Min 1px if active
+  return fillW;
+}
+
+// full: screen area is undefined (cleared, repainted, captured) - paint the
+// whole bar. record: meterShownW tracks the panel (not for captures).
+static void drawAnalogMeters(bool full, bool record) {
+  uint32_t pixels = 0;
+  for (int i = 0; i < mainLayoutCount; i++) {
+    const MainLayoutItem &item = mainLayout[i];
+    if (item.analog < 0 || item.stripW <= 0)
+      continue;
+    int fillW = meterFillWidth(item);
+    int shownW = full ? -1 : meterShownW[i];
+    if (shownW < 0) {
+      displayPtr->fillRect(item.x0, item.stripY, fillW, item.stripH,
+                           item.stripColor);
+      displayPtr->fillRect(item.x0 + fillW, item.stripY, item.stripW - fillW,
+                           item.stripH, DISPLAY_BLACK);
+      pixels += item.stripW * item.stripH;
+    } else if (fillW > shownW) {
+      displayPtr->fillRect(item.x0 + shownW, item.stripY, fillW - shownW,
+                           item.stripH, item.stripColor);
+      pixels += (fillW - shownW) * item.stripH;
+    } else if (fillW < shownW) {
+      displayPtr->fillRect(item.x0 + fillW, item.stripY, shownW - fillW,
+                           item.stripH, DISPLAY_BLACK);
+      pixels += (shownW - fillW) * item.stripH;
     }
+    if (record)
+      meterShownW[i] = fillW;
   }
+  if (record) {
+    metersValid = true;
+    mainScreenStats.lastMeterPixels = pixels;
+  }
+}
 
-  clearDisplayBuffer();
+// A scene frame cleared (or band-pushed) part of a meter strip
+static bool sceneTouchedMeters() {
+  for (int i = 0; i < mainLayoutCount; i++) {
+    const MainLayoutItem &item = mainLayout[i];
+    if (item.analog >= 0 && item.stripW > 0 &&
+        sceneTouched(item.x0, item.stripY, item.stripW, item.stripH))
+      return true;
+  }
+  return false;
+}
+
+void displayAnalogMeters() {
+  DisplayLock lock;
+  cancelDisplayRefresh();
+  if (displayPtr == nullptr || oledConfig.type == OLED_NONE)
+    return;
+  // Main screen not (fully) on the panel, or its layout is stale - the full
+  // refresh that follows such changes also draws the meters
+  if (!metersValid || compiledGeneration != layoutGeneration ||
+      compiledPreset != currentPreset)
+    return;
+
+  unsigned long t0 = micros();
+  drawAnalogMeters(false, true);
+  flushDisplay(); // OLED: only the changed columns go over I2C
+  mainScreenStats.meterFrames++;
+  mainScreenStats.lastMeterUs = micros() - t0;
+}
+
+// Scene-aware drawing for the main screen (see DisplayScene.h). Default font
+// glyphs are 6x8 per text size step.
+static void sceneText(int x, int y, uint8_t size, const char *text) {
+  size_t len = strlen(text);
+  uint32_t sig = sceneHash(text, len, sceneHash(&size, 1));
+  if (sceneWidget(x, y, len * 6 * size, 8 * size, sig))
+    labelCacheDraw(displayPtr, x, y, size, DISPLAY_WHITE, text);
+}
+
+// Strip/loading bar: fillW of w pixels filled with color
+static void sceneBar(int x, int y, int w, int h, int fillW, uint16_t color) {
+  uint32_t sig = sceneHash(&fillW, sizeof(fillW));
+  sig = sceneHash(&color, sizeof(color), sig);
+  if (sceneWidget(x, y, w, h, sig) && fillW > 0)
+    displayPtr->fillRect(x, y, fillW, h, color);
+}
 
+// Main screen layout. On TFT this runs twice per refresh (scene layout and
+// draw pass), so it must not change state.
+static void drawMainScreen() {
   // Get layout config from oledConfig (v1.5 - 128x32 support)
-  uint8_t topRowY = oledConfig.main.topRowY;
   uint8_t titleY = oledConfig.main.titleY;
   uint8_t statusY = oledConfig.main.statusY;
   uint8_t bpmY = oledConfig.main.bpmY;
-  uint8_t bottomRowY = oledConfig.main.bottomRowY;
   uint8_t labelSize = oledConfig.main.labelSize;
   uint8_t titleSize = oledConfig.main.titleSize;
   uint8_t statusSize = oledConfig.main.statusSize;
   uint8_t bpmSize = oledConfig.main.bpmSize;
   bool showBpm = oledConfig.main.showBpm;
-  bool showTopRow = oledConfig.main.showTopRow;
-  bool showBottomRow = oledConfig.main.showBottomRow;
   uint8_t titleAlign = oledConfig.main.titleAlign;
   uint8_t statusAlign = oledConfig.main.statusAlign;
   uint8_t bpmAlign = oledConfig.main.bpmAlign;
 
-  // For 128x32, adjust bottomRowY if using default 128x64 value
-  int screenHeight = (oledConfig.type == OLED_128X32)   ? 32
-                     : (oledConfig.type == TFT_128X128) ? 128
-                     : (oledConfig.type == TFT_128X160) ? 160
-                                                        : 64;
-  if (oledConfig.type == OLED_128X32 && bottomRowY > 24) {
-    bottomRowY = 24; // Clamp for 128x32
-  }
-
   displayPtr->setTextSize(labelSize);
-  char summary[10];
 
   // Dynamic layout based on button count and orientation
   // Rotation index: 0=0°, 1=90°, 2=180°, 3=270°
@@ -346,228 +592,14 @@ void displayOLED() {
   int16_t bx, by;
   uint16_t bw, bh;
 
-  // Top Row (conditional on showTopRow)
-  if (showTopRow) {
-    char tempMap[34];
-    strncpy(tempMap, oledConfig.main.topRowMap, 33);
-    tempMap[33] = '\0';
-    int itemCount = 0;
-    char *p = tempMap;
-    while (*p) {
-      if (*p == ',')
-        itemCount++;
-      p++;
-    }
-    if (strlen(tempMap) > 0)
-      itemCount++;
-
-    if (itemCount > 0) {
-      if (isVertical) {
-        // Vertical layout: top row items at the top
-        int yOffset = topRowY;
-        int maxVerticalChars = (w < 40) ? 4 : 8;
-        char *token = strtok(tempMap, ",");
-        while (token != NULL) {
-          char label[11];
-          getInputLabel(label, sizeof(label), token, maxVerticalChars);
-          displayPtr->setCursor(1, yOffset);
-          displayPtr->print(label);
-          yOffset += labelSize * 8 + 2;
-          token = strtok(NULL, ",");
-          if (yOffset > h / 2)
-            break; // Stop if too many items
-        }
-      } else {
-        // Horizontal layout: row of items
-        int dynColWidth = w / itemCount;
-        int dynMaxChars = (itemCount > 4) ? 3 : 4;
-
-        // For TFT color strips, need to re-parse to get button indices
-        char parseMap[34];
-        strncpy(parseMap, oledConfig.main.topRowMap, 33);
-        parseMap[33] = '\0';
-
-        // Use strtok_r (reentrant) to avoid interference between parsing loops
-        char *saveptr1 = NULL;
-        char *saveptr2 = NULL;
-        char *token = strtok_r(tempMap, ",", &saveptr1);
-        char *colorToken = strtok_r(parseMap, ",", &saveptr2);
-        int i = 0;
-        while (token != NULL) {
-          char label[11];
-          getInputLabel(label, sizeof(label), token, dynMaxChars);
-
-          // Calculate text width and apply alignment within column
-          int textWidth = strlen(label) * 6 * labelSize;
-          int colStart = i * dynColWidth;
-          int textX = colStart; // Default: left align
-          if (oledConfig.main.topRowAlign == 1) {
-            textX = colStart + (dynColWidth - textWidth) / 2; // Center
-          } else if (oledConfig.main.topRowAlign == 2) {
-            textX = colStart + dynColWidth - textWidth; // Right
-          }
-          displayPtr->setCursor(textX, topRowY);
-          displayPtr->print(label);
-
-          // Draw color strip below label for TFT when enabled
-          if ((oledConfig.type == TFT_128X128 ||
-               oledConfig.type == TFT_128X160) &&
-              oledConfig.main.showColorStrips && colorToken != NULL) {
-            int stripY = topRowY + (labelSize * 8) + 1;
-            int stripH = oledConfig.main.colorStripHeight > 0
-                             ? oledConfig.main.colorStripHeight
-                             : 4;
-            int maxStripW = dynColWidth - 2;
-
-            // Check if this is an analog input (starts with 'A')
-            if (colorToken[0] == 'A' || colorToken[0] == 'a') {
-              int ainIdx = atoi(&colorToken[1]) - 1;
-              if (ainIdx >= 0 && ainIdx < MAX_ANALOG_INPUTS &&
-                  analogInputs[ainIdx].enabled) {
-                uint8_t *rgb = analogInputs[ainIdx].rgb;
-                uint16_t color = ((rgb[0] >> 3) << 11) | ((rgb[1] >> 2) << 5) |
-                                 (rgb[2] >> 3);
-                // Calculate fill width as loading bar (based on reading %)
-                float percent = analogInputs[ainIdx].smoothedValue / 4095.0f;
-                int stripW = (int)(maxStripW * percent);
-                if (stripW < 1 && percent > 0.01f)
-                  stripW = 1; // Min 1px if active
-                displayPtr->fillRect(colStart, stripY, stripW, stripH, color);
-              }
-            } else {
-              // Button - full-width strip
-              int btnIdx = atoi(colorToken) - 1;
-              if (btnIdx >= 0 && btnIdx < MAX_BUTTONS) {
-                ButtonConfig &btn = buttonConfigs[currentPreset][btnIdx];
-                if (btn.messageCount > 0) {
-                  uint8_t *rgb = btn.messages[0].rgb;
-                  uint16_t color = ((rgb[0] >> 3) << 11) |
-                                   ((rgb[1] >> 2) << 5) | (rgb[2] >> 3);
-                  displayPtr->fillRect(colStart, stripY, maxStripW, stripH,
-                                       color);
-                }
-              }
-            }
-          }
-
-          token = strtok_r(NULL, ",", &saveptr1);
-          colorToken = colorToken ? strtok_r(NULL, ",", &saveptr2) : NULL;
-          i++;
-        }
-      }
-    }
-  }
-
-  // Bottom Row (conditional on showBottomRow)
-  if (showBottomRow) {
-    char tempMap[34];
-    strncpy(tempMap, oledConfig.main.bottomRowMap, 33);
-    tempMap[33] = '\0';
-    int itemCount = 0;
-    char *p = tempMap;
-    while (*p) {
-      if (*p == ',')
-        itemCount++;
-      p++;
-    }
-    if (strlen(tempMap) > 0)
-      itemCount++;
-
-    if (itemCount > 0) {
-      if (isVertical) {
-        // Vertical layout: bottom row items at the bottom
-        int yOffset = h - (itemCount * (labelSize * 8 + 2)) - 2;
-        if (yOffset < h / 2)
-          yOffset = h / 2; // Prevent overlap
-        int maxVerticalChars = (w < 40) ? 4 : 8;
-        char *token = strtok(tempMap, ",");
-        while (token != NULL) {
-          char label[11];
-          getInputLabel(label, sizeof(label), token, maxVerticalChars);
-          displayPtr->setCursor(1, yOffset);
-          displayPtr->print(label);
-          yOffset += labelSize * 8 + 2;
-          token = strtok(NULL, ",");
-        }
-      } else {
-        // Horizontal layout: row of items
-        int dynColWidth = w / itemCount;
-        int dynMaxChars = (itemCount > 4) ? 3 : 4;
-
-        // For TFT color strips, need to re-parse to get button indices
-        char parseMap[34];
-        strncpy(parseMap, oledConfig.main.bottomRowMap, 33);
-        parseMap[33] = '\0';
-
-        // Use strtok_r (reentrant) to avoid interference between parsing loops
-        char *saveptr1 = NULL;
-        char *saveptr2 = NULL;
-        char *token = strtok_r(tempMap, ",", &saveptr1);
-        char *colorToken = strtok_r(parseMap, ",", &saveptr2);
-        int i = 0;
-        while (token != NULL) {
-          char label[11];
-          getInputLabel(label, sizeof(label), token, dynMaxChars);
-
-          // Calculate text width and apply alignment within column
-          int textWidth = strlen(label) * 6 * labelSize;
-          int colStart = i * dynColWidth;
-          int textX = colStart; // Default: left align
-          if (oledConfig.main.bottomRowAlign == 1) {
-            textX = colStart + (dynColWidth - textWidth) / 2; // Center
-          } else if (oledConfig.main.bottomRowAlign == 2) {
-            textX = colStart + dynColWidth - textWidth; // Right
-          }
-          displayPtr->setCursor(textX, bottomRowY);
-          displayPtr->print(label);
-
-          // Draw color strip above label for TFT when enabled
-          if ((oledConfig.type == TFT_128X128 ||
-               oledConfig.type == TFT_128X160) &&
-              oledConfig.main.showColorStrips && colorToken != NULL) {
-            int stripH = oledConfig.main.colorStripHeight > 0
-                             ? oledConfig.main.colorStripHeight
-                             : 4;
-            int stripY = bottomRowY - stripH - 1; // Strip grows upward
-            int maxStripW = dynColWidth - 2;
-
-            // Check if this is an analog input (starts with 'A')
-            if (colorToken[0] == 'A' || colorToken[0] == 'a') {
-              int ainIdx = atoi(&colorToken[1]) - 1;
-              if (ainIdx >= 0 && ainIdx < MAX_ANALOG_INPUTS &&
-                  analogInputs[ainIdx].enabled) {
-                uint8_t *rgb = analogInputs[ainIdx].rgb;
-                uint16_t color = ((rgb[0] >> 3) << 11) | ((rgb[1] >> 2) << 5) |
-                                 (rgb[2] >> 3);
-                // Calculate fill width as loading bar (based on reading %)
-                float percent = analogInputs[ainIdx].smoothedValue / 4095.0f;
-                int stripW = (int)(maxStripW * percent);
-                if (stripW < 1 && percent > 0.01f)
-                  stripW = 1; // Min 1px if active
-                displayPtr->fillRect(colStart, stripY, stripW, stripH, color);
-              }
-            } else {
-              // Button - full-width strip
-              int btnIdx = atoi(colorToken) - 1;
-              if (btnIdx >= 0 && btnIdx < MAX_BUTTONS) {
-                ButtonConfig &btn = buttonConfigs[currentPreset][btnIdx];
-                if (btn.messageCount > 0) {
-                  uint8_t *rgb = btn.messages[0].rgb;
-                  uint16_t color = ((rgb[0] >> 3) << 11) |
-                                   ((rgb[1] >> 2) << 5) | (rgb[2] >> 3);
-                  displayPtr->fillRect(colStart, stripY, maxStripW, stripH,
-                                       color);
-                }
-              }
-            }
-          }
-
-          token = strtok_r(NULL, ",", &saveptr1);
-          colorToken = colorToken ? strtok_r(NULL, ",", &saveptr2) : NULL;
-          i++;
-        }
-      }
-    }
+  // Top/bottom rows from the compiled plan (see compileMainLayout())
+  for (int i = 0; i < mainLayoutCount; i++) {
+    const MainLayoutItem &item = mainLayout[i];
+    sceneText(item.x, item.y, labelSize, item.label);
+    // Analog bars are meters, drawn by drawAnalogMeters()
+    if (item.stripW > 0 && item.analog < 0)
+      sceneBar(item.x0, item.stripY, item.stripW, item.stripH, item.stripW,
+               item.stripColor);
   }
 
   // Middle Area - Skip rest of rendering if vertical for now to avoid mess,
@@ -577,14 +609,13 @@ void displayOLED() {
     int midY = h / 2 - (titleSize * 4);
     char truncatedName[9];
     snprintf(truncatedName, sizeof(truncatedName), "%.8s",
-             presetNames[currentPreset]);
+             presetNames[compiledPreset]);
     displayPtr->setTextSize(titleSize);
     displayPtr->getTextBounds(truncatedName, 0, 0, &bx, &by, &bw, &bh);
     int titleX = (titleAlign == 0)   ? 0
                  : (titleAlign == 2) ? (w - bw)
                                      : (w - bw) / 2;
-    displayPtr->setCursor(titleX, midY);
-    displayPtr->print(truncatedName);
+    sceneText(titleX, midY, titleSize, truncatedName);
 
     if (showBpm) {
       displayPtr->setTextSize(bpmSize);
@@ -594,10 +625,8 @@ void displayOLED() {
       int bpmX = (bpmAlign == 0)   ? 0
                  : (bpmAlign == 2) ? (w - bw)
                                    : (w - bw) / 2;
-      displayPtr->setCursor(bpmX, midY + (titleSize * 8) + 2);
-      displayPtr->print(bpmStr);
+      sceneText(bpmX, midY + (titleSize * 8) + 2, bpmSize, bpmStr);
     }
-    flushDisplay();
     return;
   }
 
@@ -608,14 +637,13 @@ void displayOLED() {
     // === 128x32 COMPACT HORIZONTAL LAYOUT ===
     char truncatedName[7];
     snprintf(truncatedName, sizeof(truncatedName), "%.6s",
-             presetNames[currentPreset]);
+             presetNames[compiledPreset]);
     displayPtr->setTextSize(titleSize);
     displayPtr->getTextBounds(truncatedName, 0, 0, &bx, &by, &bw, &bh);
     int titleX = (titleAlign == 0)   ? 0
                  : (titleAlign == 2) ? (w - bw)
                                      : (w - bw) / 2;
-    displayPtr->setCursor(titleX, titleY);
-    displayPtr->print(truncatedName);
+    sceneText(titleX, titleY, titleSize, truncatedName);
 
     // Status / Analog center or per alignment
     displayPtr->setTextSize(statusSize);
@@ -630,8 +658,7 @@ void displayOLED() {
     int statusX = (statusAlign == 0)   ? 0
                   : (statusAlign == 2) ? (w - bw)
                                        : (w - bw) / 2;
-    displayPtr->setCursor(statusX, titleY);
-    displayPtr->print(statusText);
+    sceneText(statusX, titleY, statusSize, statusText);
 
     // BPM with alignment and bpmSize
     if (showBpm) {
@@ -642,21 +669,19 @@ void displayOLED() {
       int bpmX = (bpmAlign == 0)   ? 0
                  : (bpmAlign == 2) ? (w - bw - 2)
                                    : (w - bw) / 2;
-      displayPtr->setCursor(bpmX, titleY);
-      displayPtr->print(bpmStr);
+      sceneText(bpmX, titleY, bpmSize, bpmStr);
     }
   } else {
     // === STANDARD 128x64 LAYOUT ===
     char truncatedName[11];
     snprintf(truncatedName, sizeof(truncatedName), "%.10s",
-             presetNames[currentPreset]);
+             presetNames[compiledPreset]);
     displayPtr->getTextBounds(truncatedName, 0, 0, &bx, &by, &bw, &bh);
     // Apply title alignment (0=Left, 1=Center, 2=Right)
     int titleX = (titleAlign == 0)   ? 0
                  : (titleAlign == 2) ? (w - bw)
                                      : (w - bw) / 2;
-    displayPtr->setCursor(titleX, titleY);
-    displayPtr->print(truncatedName);
+    sceneText(titleX, titleY, titleSize, truncatedName);
 
     // BPM Display (if enabled) - use bpmSize and bpmY
     if (showBpm) {
@@ -668,8 +693,7 @@ void displayOLED() {
       int bpmX = (bpmAlign == 0)   ? 0
                  : (bpmAlign == 2) ? (w - bw)
                                    : (w - bw) / 2;
-      displayPtr->setCursor(bpmX, bpmY);
-      displayPtr->print(bpmStr);
+      sceneText(bpmX, bpmY, bpmSize, bpmStr);
     }
     displayPtr->setTextSize(statusSize); // Reset for status line
   }
@@ -679,19 +703,16 @@ void displayOLED() {
   if (oledConfig.type == OLED_128X32) {
     // For 128x32, skip status line entirely (no room)
   } else if (oledConfig.main.showStatus) {
-    displayPtr->setCursor(0, statusLineY);
     if (isWifiOn) {
       // WiFi config mode - centered message
       const char *wifiMsg = "- WIFI CONFIG -";
       displayPtr->getTextBounds(wifiMsg, 0, 0, &bx, &by, &bw, &bh);
-      displayPtr->setCursor((w - bw) / 2, statusLineY);
-      displayPtr->print(wifiMsg);
+      sceneText((w - bw) / 2, statusLineY, statusSize, wifiMsg);
     } else if (isBtSerialOn) {
       // BT Serial config mode - centered message
       const char *btMsg = "- BL Serial -";
       displayPtr->getTextBounds(btMsg, 0, 0, &bx, &by, &bw, &bh);
-      displayPtr->setCursor((w - bw) / 2, statusLineY);
-      displayPtr->print(btMsg);
+      sceneText((w - bw) / 2, statusLineY, statusSize, btMsg);
     } else {
       // Normal mode - show connection state based on MIDI mode
       char statusLine[32];
@@ -726,138 +747,86 @@ void displayOLED() {
       int statusX = (statusAlign == 0)   ? 0
                     : (statusAlign == 2) ? (w - bw)
                                          : (w - bw) / 2;
-      displayPtr->setCursor(statusX, statusLineY);
-      displayPtr->print(statusLine);
+      sceneText(statusX, statusLineY, statusSize, statusLine);
     }
   }
 
   // Battery indicator (v1.5) - configurable position and scale
   if (oledConfig.main.showBattery && systemConfig.batteryAdcPin > 0) {
-    updateBatteryLevel();
     int battX = oledConfig.main.batteryX;
     int battY = oledConfig.main.batteryY;
-    int battScale = oledConfig.main.batteryScale;
-    if (battScale < 1)
-      battScale = 1;
-    drawBatteryIcon(battX, battY, battScale);
+    int battScale = constrain(oledConfig.main.batteryScale, 1, 3);
+    uint32_t sig = sceneHash(&batteryPercent, sizeof(batteryPercent));
+    // Body + tip, see drawBatteryIcon()
+    if (sceneWidget(battX, battY, 15 * battScale, 7 * battScale, sig))
+      drawBatteryIcon(battX, battY, battScale);
   }
-
-  flushDisplay();
 }
 
-// Partial update for analog color strips only (no flicker)
-// Only redraws the color strip areas for analog inputs, not the entire screen
-void updateAnalogColorStrips() {
-  if (displayPtr == nullptr)
-    return;
-  if (oledConfig.type != TFT_128X128 && oledConfig.type != TFT_128X160)
-    return;
-  if (!oledConfig.main.showColorStrips)
-    return;
+void displayOLED() {
+  DisplayLock lock;
+  cancelDisplayRefresh(); // This call covers any queued async refresh
 
-  // Get display dimensions
-  int w = 128;
-  int h = (oledConfig.type == TFT_128X160) ? 160 : 128;
-  int labelSize = oledConfig.main.labelSize > 0 ? oledConfig.main.labelSize : 1;
-  int stripH = oledConfig.main.colorStripHeight > 0
-                   ? oledConfig.main.colorStripHeight
-                   : 4;
-  int topRowY = oledConfig.main.topRowY;
-  int bottomRowY = oledConfig.main.bottomRowY;
-
-  // Process top row
-  char tempMap[34];
-  strncpy(tempMap, oledConfig.main.topRowMap, 33);
-  tempMap[33] = '\0';
-  int itemCount = 0;
-  char *p = tempMap;
-  while (*p) {
-    if (*p == ',')
-      itemCount++;
-    p++;
+  // Skip if no display configured (OLED_NONE)
+  if (displayPtr == nullptr || oledConfig.type == OLED_NONE) {
+    return;
   }
-  if (strlen(tempMap) > 0)
-    itemCount++;
-
-  if (itemCount > 0) {
-    int dynColWidth = w / itemCount;
 
-    char *token = strtok(tempMap, ",");
-    int i = 0;
-    while (token != NULL) {
-      // Check if analog input
-      if (token[0] == 'A' || token[0] == 'a') {
-        int ainIdx = atoi(&token[1]) - 1;
-        if (ainIdx >= 0 && ainIdx < MAX_ANALOG_INPUTS &&
-            analogInputs[ainIdx].enabled) {
-          uint8_t *rgb = analogInputs[ainIdx].rgb;
-          uint16_t color =
-              ((rgb[0] >> 3) << 11) | ((rgb[1] >> 2) << 5) | (rgb[2] >> 3);
-          int stripY = topRowY + (labelSize * 8) + 1;
-          int maxStripW = dynColWidth - 2;
-          float percent = analogInputs[ainIdx].smoothedValue / 4095.0f;
-          int stripW = (int)(maxStripW * percent);
-          if (stripW < 1 && percent > 0.01f)
-            stripW = 1;
-          // Clear strip area first (black), then draw filled portion
-          int colStart = i * dynColWidth;
-          displayPtr->fillRect(colStart, stripY, maxStripW, stripH,
-                               ST7735_BLACK);
-          displayPtr->fillRect(colStart, stripY, stripW, stripH, color);
-        }
-      }
-      token = strtok(NULL, ",");
-      i++;
-    }
+  // Check if in tap tempo mode
+  if (inTapTempoMode) {
+    displayTapTempoMode();
+    return;
   }
 
-  // Process bottom row
-  strncpy(tempMap, oledConfig.main.bottomRowMap, 33);
-  tempMap[33] = '\0';
-  itemCount = 0;
-  p = tempMap;
-  while (*p) {
-    if (*p == ',')
-      itemCount++;
-    p++;
+  if (buttonNameDisplayUntil > 0) {
+    if (millis() < buttonNameDisplayUntil) {
+      displayButtonName();
+      return;
+    } else {
+      buttonNameDisplayUntil = 0;
+    }
   }
-  if (strlen(tempMap) > 0)
-    itemCount++;
-
-  if (itemCount > 0) {
-    int dynColWidth = w / itemCount;
 
-    char *token = strtok(tempMap, ",");
-    int i = 0;
-    while (token != NULL) {
-      // Check if analog input
-      if (token[0] == 'A' || token[0] == 'a') {
-        int ainIdx = atoi(&token[1]) - 1;
-        if (ainIdx >= 0 && ainIdx < MAX_ANALOG_INPUTS &&
-            analogInputs[ainIdx].enabled) {
-          uint8_t *rgb = analogInputs[ainIdx].rgb;
-          uint16_t color =
-              ((rgb[0] >> 3) << 11) | ((rgb[1] >> 2) << 5) | (rgb[2] >> 3);
-          int stripY = bottomRowY - stripH - 1;
-          int maxStripW = dynColWidth - 2;
-          float percent = analogInputs[ainIdx].smoothedValue / 4095.0f;
-          int stripW = (int)(maxStripW * percent);
-          if (stripW < 1 && percent > 0.01f)
-            stripW = 1;
-          // Clear strip area first (black), then draw filled portion
-          int colStart = i * dynColWidth;
-          displayPtr->fillRect(colStart, stripY, maxStripW, stripH,
-                               ST7735_BLACK);
-          displayPtr->fillRect(colStart, stripY, stripW, stripH, color);
-        }
-      }
-      token = strtok(NULL, ",");
-      i++;
+  bool isTft =
+      oledConfig.type == TFT_128X128 || oledConfig.type == TFT_128X160;
+  if (oledConfig.main.showBattery && systemConfig.batteryAdcPin > 0)
+    updateBatteryLevel();
+  compileMainLayout();
+
+  if (isTft && !displayCaptureActive() && !tftFrameActive()) {
+    // Retained scene: only changed widgets are pushed over SPI
+    unsigned long t0 = micros();
+    uint32_t fullRepaints = sceneStats.fullRepaints;
+    sceneBeginLayout();
+    drawMainScreen(); // CPU only - nothing is drawn in the layout pass
+    mainScreenStats.lastLayoutUs = micros() - t0;
+    if (sceneHasBandBuffer()) {
+      sceneRenderBands(drawMainScreen); // Dirty areas via RAM bands
+    } else {
+      if (!sceneIsValid())
+        clearDisplayBuffer();
+      sceneBeginDraw();
+      drawMainScreen();
     }
+    sceneEnd();
+    drawAnalogMeters(!metersValid || sceneStats.fullRepaints != fullRepaints ||
+                         sceneTouchedMeters(),
+                     true);
+  } else {
+    // OLED / TFT palette frame: the flush diffs against what the panel shows
+    unsigned long t0 = micros();
+    clearDisplayBuffer();
+    drawMainScreen(); // Into the RAM buffer
+    drawAnalogMeters(true, !displayCaptureActive());
+    mainScreenStats.lastLayoutUs = micros() - t0;
   }
+
+  flushDisplay();
 }
 
 void displayTapTempoMode() {
+  DisplayLock lock;
+  cancelDisplayRefresh();
   if (displayPtr == nullptr || oledConfig.type == OLED_NONE)
     return;
   clearDisplayBuffer();
@@ -955,6 +924,8 @@ void displayTapTempoMode() {
 }
 
 void displayButtonName() {
+  DisplayLock lock;
+  cancelDisplayRefresh();
   if (displayPtr == nullptr || oledConfig.type == OLED_NONE)
     return;
   clearDisplayBuffer();
@@ -981,6 +952,9 @@ void displayButtonName() {
 }
 
 void displayMenu() {
+  DisplayLock lock;
+  cancelDisplayRefresh(); // Keep a queued main screen from drawing over it
+  invalidateDisplayLayout(); // Menu edits may change labels/colors
   clearDisplayBuffer();
   displayPtr->setTextColor(DISPLAY_WHITE);
 
@@ -1155,6 +1129,10 @@ static const char *getTypeName(MidiCommandType t) {
     return "MnDn";
   case MENU_ENTER:
     return "MnOk";
+  case CC_14BIT:
+    return "CC14";
+  case NRPN:
+    return "NRPN";
   default:
     return "?";
   }
@@ -1282,6 +1260,9 @@ void rgbToHsv(uint8_t r, uint8_t g, uint8_t b, int *h, int *s, int *v) {
 }
 
 void displayEditMenu() {
+  DisplayLock lock;
+  cancelDisplayRefresh(); // Keep a queued main screen from drawing over it
+  invalidateDisplayLayout(); // Menu edits may change labels/colors
   clearDisplayBuffer();
   displayPtr->setTextColor(DISPLAY_WHITE);
   displayPtr->setTextSize(1);
@@ -1619,6 +1600,8 @@ void displayEditMenu() {
 // Press encoder button to exit back to menu
 // ============================================================================
 void displayAnalogDebug() {
+  DisplayLock lock;
+  cancelDisplayRefresh(); // Keep a queued main screen from drawing over it
   clearDisplayBuffer();
   displayPtr->setTextColor(DISPLAY_WHITE);
 
@@ -1698,7 +1681,40 @@ void displayAnalogDebug() {
   flushDisplay();
 }
 
+LedServiceStats ledServiceStats = {0, 0, 0, 0, 0};
+
+static portMUX_TYPE ledDirtyMux = portMUX_INITIALIZER_UNLOCKED;
+static uint32_t ledDirtyMask = 0; // Bit per button (BLE callbacks set too)
+
+void markLedDirty(int button) {
+  if (button < 0 || button >= MAX_BUTTONS)
+    return;
+  portENTER_CRITICAL(&ledDirtyMux);
+  ledDirtyMask |= 1UL << button;
+  portEXIT_CRITICAL(&ledDirtyMux);
+}
+
+static void markLedsDirty() {
+  portENTER_CRITICAL(&ledDirtyMux);
+  ledDirtyMask = 0xFFFFFFFF;
+  portEXIT_CRITICAL(&ledDirtyMux);
+}
+
 void updateLeds() {
+  markLedsDirty();
+  serviceLeds();
+}
+
+void ledLayoutChanged() {
+  // LEDs of the old layout may belong to no button now, and the color cache
+  // describes the old ranges - forget both
+  for (int i = 0; i < MAX_BUTTONS; i++)
+    lastLedColors[i] = 0xFFFFFFFF;
+  ledFill(0, MAX_LEDS, 0);
+  updateLeds();
+}
+
+void serviceLeds() {
   // USB MIDI MODE: LEDs are disabled on ESP32-S3 (RMT/USB hardware conflict)
   // strip.begin() was never called, so skip all LED processing
 #if defined(CONFIG_IDF_TARGET_ESP32S3)
@@ -1706,61 +1722,46 @@ void updateLeds() {
     return; // LEDs disabled in USB MIDI mode
   }
 #endif
-
-  // WiFi-safe LED updates: use increased heap threshold and rate limiting
-  // ESP32 RMT peripheral handles NeoPixel timing, but WiFi can still
-  // interfere
-
-  // Skip LED updates when heap is critically low
-  // Threshold lowered for TFT+BLE configs which use more memory (~12KB typical)
-  int heapThreshold = isWifiOn ? 8000 : 10000;
-  if (ESP.getFreeHeap() < heapThreshold) {
-    static unsigned long lastHeapWarn = 0;
-    if (millis() - lastHeapWarn > 5000) { // Only warn every 5 seconds
-      Serial.printf("LED update skipped: heap %d < %d\n", ESP.getFreeHeap(),
-                    heapThreshold);
-      lastHeapWarn = millis();
-    }
-    return; // Safety: prevent crash from memory pressure
-  }
-
-  // Rate limit: don't update LEDs more than every 50ms when WiFi is on
-  // This gives WiFi stack time to process packets between LED updates
-  static unsigned long lastLedUpdate = 0;
-  if (isWifiOn && (millis() - lastLedUpdate < 50)) {
-    return; // Throttle to prevent WiFi interference
-  }
-  lastLedUpdate = millis();
-
+  ledServiceStats.calls++;
+  unsigned long now = millis();
+
+  // Tap tempo blink follows the FINAL delay ms (with rhythm pattern
+  // applied) - same as sent to SPM. A tempo change is an LED event.
+  static bool lastTempoActive = false;
+  static float lastBpm = 0;
+  static int lastPattern = -1;
+  bool tempoActive = currentMode == 0 && currentBPM > 0;
+  if (tempoActive != lastTempoActive || currentBPM != lastBpm ||
+      rhythmPattern != lastPattern) {
+    lastTempoActive = tempoActive;
+    lastBpm = currentBPM;
+    lastPattern = rhythmPattern;
+    uint32_t beatMs = 0;
+    if (tempoActive)
+      beatMs = (60000.0 / currentBPM) * rhythmMultipliers[rhythmPattern];
+    ledAnimSetTempo(beatMs, now);
+    markLedsDirty(); // Tap buttons start / stop their beat layer
+  }
+
+  // Animated buttons are only recomputed on animation frames
+  uint32_t animMask = ledAnimTick(now);
+  uint32_t meterMask = ledMeterTick(now);
+  portENTER_CRITICAL(&ledDirtyMux);
+  uint32_t dirty = ledDirtyMask;
+  ledDirtyMask = 0;
+  portEXIT_CRITICAL(&ledDirtyMux);
+  if (!(dirty | animMask | meterMask))
+    return; // Idle: nothing changed, nothing animating
+
+  // Colors go into the LED back buffer; the LED task pushes them to the
+  // strip (heap check and WiFi pacing happen there, see LedTask.h)
   bool needsUpdate = false;
-
-  // Update tap tempo blink timing (non-blocking state machine)
-  if (currentMode == 0 && currentBPM > 0) {
-    // Calculate the FINAL delay ms (with rhythm pattern applied) - same as
-    // sent to SPM
-    float finalDelayMs =
-        (60000.0 / currentBPM) * rhythmMultipliers[rhythmPattern];
-    unsigned long blinkInterval = (unsigned long)finalDelayMs;
-    unsigned long now = millis();
-
-    // State machine: OFF -> ON (at beat) -> OFF (after 50ms flash)
-    if (tapBlinkState && (now - lastTapBlinkTime >= 50)) {
-      tapBlinkState = false;
-    } else if (!tapBlinkState && (now - lastTapBlinkTime >= blinkInterval)) {
-      tapBlinkState = true;
-      lastTapBlinkTime = now;
-    }
-  } else {
-    tapBlinkState = false;
-  }
-
-  // LEDs per button - determines single LED mode (with mapping) vs strip mode
-  // (sequential)
-  uint8_t lpb = systemConfig.ledsPerButton;
-  if (lpb < 1)
-    lpb = 1; // Safety minimum
+  unsigned long t0 = micros();
 
   for (int i = 0; i < systemConfig.buttonCount; i++) {
+    if (!(((dirty | animMask) >> i) & 1))
+      continue;
+    ledServiceStats.recomputed++;
     const ButtonConfig &config = buttonConfigs[currentPreset][i];
 
     // Safety: bounds check messageCount to prevent garbage data crashes
@@ -1783,13 +1784,22 @@ void updateLeds() {
       msg = &config.messages[0];
     }
 
-    // TAP_TEMPO buttons use blink state, others use normal brightness
+    // TAP_TEMPO buttons blink on the beat (animation layer), others use
+    // normal brightness
     bool isTapTempo = (msg && msg->type == TAP_TEMPO);
     int brightness;
 
-    if (isTapTempo && tapBlinkState) {
-      brightness = ledBrightnessTap; // Use configured brightness during flash
-    } else if (isTapTempo) {
+    if (isTapTempo && tempoActive) {
+      ledAnimStart(i, LED_ANIM_BEAT,
+                   strip.Color((msg->rgb[0] * ledBrightnessTap) / 255,
+                               (msg->rgb[1] * ledBrightnessTap) / 255,
+                               (msg->rgb[2] * ledBrightnessTap) / 255),
+                   0, 0, now);
+    } else if (ledAnimLoopType(i) == LED_ANIM_BEAT) {
+      ledAnimStop(i);
+    }
+
+    if (isTapTempo) {
       // v1.5.5: TAP_TEMPO buttons always show at dim state when not blinking
       // This ensures they're visible even when not in tap tempo mode
       brightness = ledBrightnessDim > 0 ? ledBrightnessDim : 30;
@@ -1825,212 +1835,162 @@ void updateLeds() {
 
     uint32_t newColor = strip.Color(r, g, b);
 
-    if (lpb == 1) {
-      // SINGLE LED MODE: Use systemConfig.ledMap for backward compatibility
-      // ledMap remaps button index to physical LED index
-      if (isTapTempo || newColor != lastLedColors[i]) {
-        strip.setPixelColor(systemConfig.ledMap[i], newColor);
-        lastLedColors[i] = newColor;
-        needsUpdate = true;
-      }
-    } else {
-      // STRIP MODE: Each button controls a segment of consecutive LEDs
-      // Button i controls LEDs: (i * lpb) to ((i+1) * lpb - 1)
-      int startLed = i * lpb;
-      int endLed = startLed + lpb;
-
-      for (int led = startLed; led < endLed; led++) {
-        if (isTapTempo || newColor != lastLedColors[i]) {
-          strip.setPixelColor(led, newColor);
-          needsUpdate = true;
-        }
-      }
-      lastLedColors[i] = newColor; // Track by button
-    }
-  }
-
-  // Only call strip.show() if something actually changed
-  if (needsUpdate) {
-    // USB MIDI mode: Only update LEDs on preset change to avoid RMT/USB
-    // conflict
-#if defined(CONFIG_IDF_TARGET_ESP32S3)
-    if (systemConfig.bleMode == MIDI_USB_ONLY) {
-      if (usbMidiLedUpdatePending) {
-        yield();
-        strip.show();
-        yield();
-        usbMidiLedUpdatePending = false; // Reset flag after update
-      }
-      // Skip show() if not pending - LEDs only change on preset change in USB
-      // mode
-    } else {
-      yield(); // Give WiFi stack time before LED update
-      strip.show();
-      yield(); // Give WiFi stack time after LED update
+    bool animated = ledAnimActive(i);
+    if (!animated && newColor == lastLedColors[i])
+      continue;
+    // Never a strip.Color() value - the base color is rewritten once the
+    // animation ends
+    lastLedColors[i] = animated ? 0xFFFFFFFF : newColor;
+    needsUpdate = true;
+
+    // The button's LED ranges (LedSegments.h): a static color is a fill
+    // per range, animations run pixel by pixel across all of them
+    if (!animated) {
+      ledSegmentsFill(i, newColor);
+      continue;
     }
-#else
-    yield(); // Give WiFi stack time before LED update
-    strip.show();
-    yield(); // Give WiFi stack time after LED update
-#endif
-  }
+    LedRange ranges[LED_SEG_MAX_PER_OWNER];
+    uint8_t n = ledSegmentsOf(i, ranges, LED_SEG_MAX_PER_OWNER);
+    uint16_t pixels = 0;
+    for (uint8_t r = 0; r < n; r++)
+      pixels += ranges[r].count;
+    uint16_t p = 0;
+    for (uint8_t r = 0; r < n; r++)
+      for (uint16_t k = 0; k < ranges[r].count; k++)
+        ledSetPixel(ranges[r].start + k,
+                    ledAnimColor(i, newColor, p++, pixels, now));
+  }
+
+  // Analog meters sit on top of the buttons: redrawn on their frame tick,
+  // and all of them when buttons were repainted (segments may overlap)
+  if (needsUpdate)
+    meterMask = LED_METER_ALL;
+  for (uint8_t a = 0; a < MAX_ANALOG_INPUTS; a++)
+    if (((meterMask >> a) & 1) && ledMeterRender(a, now))
+      needsUpdate = true;
+
+  uint32_t us = micros() - t0;
+  ledServiceStats.busy++;
+  ledServiceStats.lastUs = us;
+  if (us > ledServiceStats.maxUs)
+    ledServiceStats.maxUs = us;
+  if (animMask) {
+    ledAnimStats.frames++;
+    ledAnimStats.lastUs = us;
+    if (us > ledAnimStats.maxUs)
+      ledAnimStats.maxUs = us;
+  }
+
+  // Only commit a frame if something actually changed
+  if (needsUpdate)
+    ledShow();
 }
 
-void updateIndividualLed(uint8_t index, uint8_t r, uint8_t g, uint8_t b) {
-  if (index >= strip.numPixels())
+void updateIndividualLed(uint16_t index, uint8_t r, uint8_t g, uint8_t b) {
+  if (index >= ledStripLength)
     return;
-  strip.setPixelColor(index, strip.Color(r, g, b));
-  strip.show();
+  ledSetPixel(index, strip.Color(r, g, b));
+  ledShow();
 }
 
 void blinkAllLeds() {
-  // Save current state
-  uint32_t savedColors[NUM_LEDS];
-  for (int i = 0; i < NUM_LEDS; i++) {
-    savedColors[i] = strip.getPixelColor(i);
-  }
-
   // Flash at REDUCED brightness (25% instead of 100%)
   // Prevents power spike: 60mA instead of 480mA
-  for (int i = 0; i < NUM_LEDS; i++) {
-    strip.setPixelColor(i, strip.Color(64, 64, 64)); // Was 255,255,255
-  }
-  strip.show();
-  delay(100);
-
-  // Restore
-  for (int i = 0; i < NUM_LEDS; i++) {
-    strip.setPixelColor(i, savedColors[i]);
-  }
-  strip.show();
+  unsigned long now = millis();
+  for (int i = 0; i < systemConfig.buttonCount; i++)
+    ledAnimStart(i, LED_ANIM_FLASH, strip.Color(64, 64, 64), 0, 100, now);
+  updateLeds(); // Restored by the animation tick, no delay()
 }
 
 void blinkTapButton(int buttonIndex) {
   // Blink only the tap tempo button's LED using configurable brightness
-  uint8_t lpb = systemConfig.ledsPerButton;
-  if (lpb < 1)
-    lpb = 1;
-
-  // Calculate white color at configured brightness
   uint8_t tapBright = constrain(ledBrightnessTap, 0, 255);
-
-  if (lpb == 1) {
-    // Single LED mode - use ledMap
-    int ledIndex = systemConfig.ledMap[buttonIndex];
-    uint32_t savedColor = strip.getPixelColor(ledIndex);
-
-    strip.setPixelColor(ledIndex, strip.Color(tapBright, tapBright, tapBright));
-    strip.show();
-    delay(50);
-
-    strip.setPixelColor(ledIndex, savedColor);
-    strip.show();
-  } else {
-    // Strip mode - button controls multiple LEDs
-    int startLed = buttonIndex * lpb;
-    int endLed = startLed + lpb;
-    uint32_t savedColors[lpb];
-
-    // Save and flash
-    for (int i = startLed; i < endLed; i++) {
-      savedColors[i - startLed] = strip.getPixelColor(i);
-      strip.setPixelColor(i, strip.Color(tapBright, tapBright, tapBright));
-    }
-    strip.show();
-    delay(50);
-
-    // Restore
-    for (int i = startLed; i < endLed; i++) {
-      strip.setPixelColor(i, savedColors[i - startLed]);
-    }
-    strip.show();
-  }
+  ledAnimStart(buttonIndex, LED_ANIM_FLASH,
+               strip.Color(tapBright, tapBright, tapBright), 0, 50, millis());
+  updateLeds();
 }
 
 // ============================================================================
 // OLED Health Monitoring & Auto-Recovery System
 // ============================================================================
 
-bool checkOledHealth() {
-  // NOTE: Uses global oledHealthy from Globals.cpp (not static local)
-  static unsigned long lastOledCheck = 0;
-
+// Bus recovery runs as a state machine, one short step per loop() pass:
+// unlock the bus, wait for it to settle, re-init the panel and resend the
+// RAM buffer; on failure wait (doubling up to OLED_RECOVERY_MAX_BACKOFF_MS)
+// and start over. Input and MIDI keep running in between.
+enum OledRecoveryStep : uint8_t {
+  OLED_RECOVERY_IDLE,
+  OLED_RECOVERY_UNLOCK,
+  OLED_RECOVERY_REINIT,
+  OLED_RECOVERY_BACKOFF
+};
+
+static OledRecoveryStep recoveryStep = OLED_RECOVERY_IDLE;
+static unsigned long recoveryAt = 0;
+static uint16_t recoveryBackoffMs = OLED_RECOVERY_MIN_BACKOFF_MS;
+
+void serviceOledHealth() {
   // TFT displays use SPI, not I2C - always consider them healthy
-  if (oledConfig.type == TFT_128X128 || oledConfig.type == TFT_128X160) {
-    return true;
-  }
+  if (displayPtr == nullptr || oledConfig.type == OLED_NONE ||
+      oledConfig.type == TFT_128X128 || oledConfig.type == TFT_128X160)
+    return;
 
-  if (displayPtr == nullptr) {
-    return false;
-  }
+  unsigned long now = millis();
+  switch (recoveryStep) {
+  case OLED_RECOVERY_IDLE:
+    if (!oledBusDown())
+      return;
+    oledHealthy = false;
+    recoveryBackoffMs = OLED_RECOVERY_MIN_BACKOFF_MS;
+    recoveryStep = OLED_RECOVERY_UNLOCK;
+    Serial.println("OLED not responding, starting recovery...");
+    return;
 
-  // Check every 500ms to avoid overhead
-  if (millis() - lastOledCheck < 500) {
-    return oledHealthy;
+  case OLED_RECOVERY_UNLOCK: {
+    DisplayLock lock;
+    if (!oledBusUnlock(systemConfig.oledSdaPin, systemConfig.oledSclPin))
+      Serial.println("OLED recovery: SDA still held low");
+    recoveryAt = now + OLED_RECOVERY_SETTLE_MS;
+    recoveryStep = OLED_RECOVERY_REINIT;
+    return;
   }
-  lastOledCheck = millis();
-
-  // Try a simple I2C communication test to 0x3C (OLED address)
-  Wire.beginTransmission(0x3C);
-  byte error = Wire.endTransmission();
 
-  if (error != 0) {
-    // OLED not responding
-    if (oledHealthy) {
-      Serial.println("OLED not responding, attempting recovery...");
-    }
-    oledHealthy = false;
-    recoverOled();
-  } else {
-    if (!oledHealthy) {
-      Serial.println("OLED communication restored");
+  case OLED_RECOVERY_REINIT: {
+    if ((long)(now - recoveryAt) < 0)
+      return;
+    DisplayLock lock;
+    Adafruit_SSD1306 *oled = static_cast<Adafruit_SSD1306 *>(displayPtr);
+    bool ok = oledReinit(&oled, oledConfig.type == OLED_128X32 ? 32 : 64);
+    displayPtr = oled; // Rebuilt if the bus clock changed
+    if (ok) {
+      oledHealthy = true;
+      recoveryStep = OLED_RECOVERY_IDLE;
+      Serial.println("OLED recovered successfully!");
+      // Retained frame is back on the panel; catch up on anything newer
+      requestDisplay(VIEW_CURRENT, DISPLAY_REASON_RECOVERY, DISPLAY_LOW);
+      return;
     }
-    oledHealthy = true;
-  }
-
-  return oledHealthy;
-}
-
-void recoverOled() {
-  Serial.println("Attempting display recovery...");
-
-  // Try to reinitialize display
-  bool success = false;
-  if (oledConfig.type == TFT_128X128 || oledConfig.type == TFT_128X160) {
-    // TFT uses SPI, not I2C - skip I2C recovery
-    // For TFT, we could potentially re-init the display, but typically SPI
-    // doesn't fail
-    success = true;
-  } else {
-    // Reset I2C bus for OLED displays
-    Wire.end();
-    delay(10);
-    Wire.begin(OLED_SDA_PIN, OLED_SCL_PIN);
-    Wire.setClock(100000); // 100kHz for stability
-    delay(10);
-
-    // Reinitialize OLED
-    success = static_cast<Adafruit_SSD1306 *>(displayPtr)
-                  ->begin(SSD1306_SWITCHCAPVCC, 0x3C);
+    Serial.printf("OLED recovery failed - retry in %u ms\n",
+                  recoveryBackoffMs);
+    recoveryAt = now + recoveryBackoffMs;
+    recoveryBackoffMs = min(recoveryBackoffMs * 2, OLED_RECOVERY_MAX_BACKOFF_MS);
+    recoveryStep = OLED_RECOVERY_BACKOFF;
+    return;
   }
 
-  if (success) {
-    oledHealthy = true;
-    Serial.println("OLED recovered successfully!");
-    displayOLED(); // Redraw screen
-  } else {
-    Serial.println("OLED recovery failed - will retry");
+  case OLED_RECOVERY_BACKOFF:
+    if ((long)(now - recoveryAt) >= 0)
+      recoveryStep = OLED_RECOVERY_UNLOCK;
+    return;
   }
 }
 
-void safeDisplayOLED() {
-  // v1.5.5: Removed I2C health check as it interferes with BLE scanning
-  // and causes display freezes. The OLED library handles errors internally.
-  displayOLED();
-}
-
 // Hardware Init
 void initDisplayHardware() {
+  DisplayLock lock; // displayPtr is replaced below
+  if (tftFrameActive())
+    displayPtr = tftFrameEnd(); // Panel behind the palette frame
+
   // Skip display initialization if OLED_NONE is set
   if (oledConfig.type == OLED_NONE) {
     Serial.println("Display type is NONE - skipping initialization");
@@ -2076,13 +2036,18 @@ void initDisplayHardware() {
 
     Serial.println("Clearing screen...");
     tft->fillScreen(ST7735_BLACK);
+    sceneInvalidate();
+    // Palette frame if the heap allows, else scene bands / direct drawing
+    Adafruit_GFX *frame = tftFrameBegin(tft);
+    if (!frame)
+      sceneInitBandBuffer();
 
     // Setup Backlight - use configurable pin
     Serial.println("Setting up backlight...");
     pinMode(systemConfig.tftLedPin, OUTPUT);
     digitalWrite(systemConfig.tftLedPin, HIGH); // Turn on backlight
 
-    displayPtr = tft;
+    displayPtr = frame ? frame : static_cast<Adafruit_GFX *>(tft);
     Serial.printf("TFT %s Initialized Successfully!\n",
                   is160 ? "128x160" : "128x128");
   } else {
@@ -2092,8 +2057,8 @@ void initDisplayHardware() {
                   SCREEN_WIDTH, h, systemConfig.oledSdaPin,
                   systemConfig.oledSclPin);
 
-    Adafruit_SSD1306 *oled =
-        new Adafruit_SSD1306(SCREEN_WIDTH, h, &Wire, OLED_RESET);
+    // Keep the library's own transactions on our bus clock
+    Adafruit_SSD1306 *oled = oledCreate(h);
 
     if (!oled->begin(SSD1306_SWITCHCAPVCC, 0x3C)) {
       Serial.println(F("SSD1306 allocation failed (re-init)"));
@@ -2104,6 +2069,7 @@ void initDisplayHardware() {
     oled->clearDisplay();
     oled->setTextColor(SSD1306_WHITE);
     oled->display();
+    oledInvalidateShadow();
 
     displayPtr = oled;
     Serial.printf("OLED Initialized: %dx%d, rotation=%d\n", SCREEN_WIDTH, h,
@@ -10,8 +10,27 @@ void hsvToRgb(int h, int s, int v, uint8_t *r, uint8_t *g, uint8_t *b);
 void rgbToHsv(uint8_t r, uint8_t g, uint8_t b, int *h, int *s, int *v);
 
 void displayAnalogDebug(); // v1.5: Dedicated analog debug screen
-void updateLeds();
-void updateIndividualLed(uint8_t index, uint8_t r, uint8_t g, uint8_t b);
+// LED state is recomputed per button only when marked dirty: input events,
+// sync messages, preset/config changes and tempo changes call updateLeds()
+// (all buttons) or markLedDirty(); loop() calls serviceLeds(), which also
+// runs animation and analog meter frames (LedMeter.h) and otherwise returns
+// without touching the LEDs
+void updateLeds(); // Mark all buttons dirty and recompute now
+// Segments / ledsPerButton / ledMap changed at runtime: clear the strip and
+// repaint every button into the new layout
+void ledLayoutChanged();
+void markLedDirty(int button);
+void serviceLeds();
+
+struct LedServiceStats {
+  uint32_t calls;      // serviceLeds() calls (incl. via updateLeds())
+  uint32_t busy;       // Calls that recomputed at least one button
+  uint32_t recomputed; // Buttons recomputed
+  uint32_t lastUs;     // CPU time of the last busy call
+  uint32_t maxUs;
+};
+extern LedServiceStats ledServiceStats;
+void updateIndividualLed(uint16_t index, uint8_t r, uint8_t g, uint8_t b);
 void blinkAllLeds();
 void blinkTapButton(int buttonIndex);
 void displayTapTempoMode();
@@ -19,16 +38,30 @@ void displayButtonName();
 void midiNoteNumberToString(char *buffer, size_t bufferSize, int note);
 void getButtonSummary(char *b, size_t s, MidiCommandType type, int data1);
 
-// OLED Health Monitoring & Recovery
-bool checkOledHealth();
-void recoverOled();
-void safeDisplayOLED();
-void updateAnalogColorStrips(); // Partial update for analog loading bars (no
-                                // flicker)
+// OLED Health Monitoring & Recovery (non-blocking, call from loop())
+#define OLED_RECOVERY_SETTLE_MS 10 // Bus idle time before re-init
+#define OLED_RECOVERY_MIN_BACKOFF_MS 250
+#define OLED_RECOVERY_MAX_BACKOFF_MS 8000
+void serviceOledHealth();
 
 // Hardware Init
 void initDisplayHardware();
 
+// Main screen layout plan - call after changing row maps, button/analog
+// names or colors, or screen geometry
+void invalidateDisplayLayout();
+// Redraw only the analog bar columns that changed (main screen on panel)
+void displayAnalogMeters();
+
+struct MainScreenStats {
+  uint32_t compiles;     // Layout plan rebuilds
+  uint32_t lastLayoutUs; // CPU time of the last main screen layout
+  uint32_t meterFrames;  // Frames that only moved analog meters
+  uint32_t lastMeterPixels;
+  uint32_t lastMeterUs;  // Incl. the OLED flush
+};
+extern MainScreenStats mainScreenStats;
+
 // Display abstraction helpers
 void flushDisplay();
 void clearDisplayBuffer();
@@ -1,6 +1,20 @@
 #include "WebInterface.h"
 #include "AnalogInput.h"
+#include "AnalogTrace.h"
 #include "BleMidi.h"
+#include "DisplayCapture.h"
+#include "DisplayScene.h"
+#include "DisplayTask.h"
+#include "LabelCache.h"
+#include "LedMeter.h"
+#include "LedPower.h"
+#include "LedSegments.h"
+#include "LedAnim.h"
+#include "LedTask.h"
+#include "OledFlush.h"
+#include "SettingsCache.h"
+#include "TftFrame.h"
+#include "MidiCoalescer.h"
 #if !defined(CONFIG_IDF_TARGET_ESP32S3)
 #include "BluetoothSerial.h"
 #endif
@@ -8,6 +22,7 @@
 #include "UI_Display.h"
 #include <ArduinoJson.h>
 #include <WebServer.h> // Ensure WebServer is included
+#include <SPIFFS.h>
 
 // Bluetooth Serial (SPP) for wireless editor connection
 #if !defined(CONFIG_IDF_TARGET_ESP32S3)
@@ -144,6 +159,10 @@ const char *getCommandTypeName(MidiCommandType t) {
     return "Clear BLE Bonds";
   case WIFI_TOGGLE:
     return "WiFi Toggle";
+  case CC_14BIT:
+    return "CC 14-bit";
+  case NRPN:
+    return "NRPN";
   default:
     return "Off";
   }
@@ -188,6 +207,10 @@ const char *getCommandTypeString(MidiCommandType t) {
     return "MENU_DOWN";
   case MENU_ENTER:
     return "MENU_ENTER";
+  case CC_14BIT:
+    return "CC_14BIT";
+  case NRPN:
+    return "NRPN";
   default:
     return "OFF";
   }
@@ -255,6 +278,10 @@ MidiCommandType parseCommandType(String s) {
     return MENU_DOWN;
   if (s == "MENU_ENTER")
     return MENU_ENTER;
+  if (s == "CC_14BIT")
+    return CC_14BIT;
+  if (s == "NRPN")
+    return NRPN;
   return MIDI_OFF;
 }
 ActionType parseActionType(String s) {
@@ -521,9 +548,11 @@ void handleRoot() {
   requestInProgress = false;
 }
 
-void handleSave() {
+// Copy the editor form into the preset. The display task renders names and
+// button configs from core 0, so they only change under DisplayLock.
+static bool applyPresetForm(int preset) {
+  DisplayLock lock;
   bool changed = false;
-  int preset = server.hasArg("preset") ? server.arg("preset").toInt() : 0;
 
   if (server.hasArg("name")) {
     String newName = server.arg("name");
@@ -823,6 +852,12 @@ void handleSave() {
 
     yield(); // Allow WDT to reset after each button
   }
+  return changed;
+}
+
+void handleSave() {
+  int preset = server.hasArg("preset") ? server.arg("preset").toInt() : 0;
+  bool changed = applyPresetForm(preset);
 
   if (changed) {
     yield(); // Before blocking NVS write
@@ -831,9 +866,10 @@ void handleSave() {
     Serial.println("Save complete - deferring display update...");
     Serial.printf("Free heap after save: %d bytes\n", ESP.getFreeHeap());
 
-    // DEFER display/LED updates to main loop - calling them here crashes due to
-    // low heap with WiFi
-    pendingDisplayUpdate = true;
+    // Drawn from loop() by the display scheduler - calling it here crashes
+    // due to low heap with WiFi
+    requestDisplay(VIEW_MAIN, DISPLAY_REASON_CONFIG);
+    updateLeds(); // LED modes / colors may have changed
 
     // Give time for memory to stabilize before redirect
     delay(150);
@@ -869,6 +905,7 @@ void handleSave() {
 }
 
 void handleSaveSystem() {
+  DisplayLock lock; // Held until the reboot - no frame sees half a config
   bool changed = false;
   if (server.hasArg("ble")) {
     String newName = server.arg("ble");
@@ -1032,6 +1069,7 @@ void rebootESP(String message) {
   html += F("</h1><p>Device is rebooting. Please reconnect to the new Wi-Fi AP "
             "if you changed it.</p></div></body></html>");
   server.send(200, "text/html", html);
+  settingsFlush(); // Pending settings must reach NVS first
   delay(1000);
   ESP.restart();
 }
@@ -1325,6 +1363,7 @@ void handleImportUploadResponse() {
   // Check if we should restart (set by upload handler after successful save)
   if (pendingRestart) {
     Serial.println("=== Rebooting device now... ===");
+    settingsFlush();
     Serial.flush();
     delay(500);
     ESP.restart();
@@ -1396,8 +1435,7 @@ void handleImportUploadData() {
     Serial.println("Configuration saved!");
 
     currentPreset = 0;
-    pendingDisplayUpdate = true;
-    displayOLED(); // Update OLED with new config
+    requestDisplay(VIEW_MAIN, DISPLAY_REASON_CONFIG); // Show the new config
     updateLeds();  // Update LEDs with new config
 
     Serial.println(
@@ -1488,7 +1526,7 @@ void turnWifiOn() {
   Serial.flush();
 
   yield();
-  displayOLED();
+  requestDisplay(VIEW_CURRENT, DISPLAY_REASON_CONFIG); // WiFi status
 }
 
 void turnWifiOff() {
@@ -1525,7 +1563,7 @@ void turnWifiOff() {
     Serial.println("BLE scanning will resume");
   }
 
-  displayOLED();
+  requestDisplay(VIEW_CURRENT, DISPLAY_REASON_CONFIG); // WiFi status
 }
 
 // Handle preset change from web editor - sync to controller display
@@ -1548,8 +1586,7 @@ void handlePreset() {
 
   // Update display and LEDs
   Serial.printf("handlePreset: Changing to preset %d\n", preset);
-  pendingDisplayUpdate = true;
-  displayOLED(); // Update OLED immediately
+  requestDisplay(VIEW_MAIN, DISPLAY_REASON_CONFIG, DISPLAY_HIGH);
   updateLeds();  // WiFi-safe LED update
 
   server.send(200, "text/plain", "OK");
@@ -1630,6 +1667,11 @@ void setup_web_server() {
       json += String(cfg.emaAlpha, 2);
       json += ",\"hysteresis\":";
       json += String(cfg.hysteresis);
+      json += ",\"autoCal\":";
+      json += cfg.autoCalibrate ? "true" : "false";
+      json += ",\"ledStyle\":\"";
+      json += ledMeterStyleName(cfg.ledStyle);
+      json += "\"";
       json += ",\"calibrating\":";
       json += cfg.calibrating ? "true" : "false";
 
@@ -1707,6 +1749,10 @@ void setup_web_server() {
       cfg.emaAlpha = doc["emaAlpha"];
     if (doc.containsKey("hysteresis"))
       cfg.hysteresis = doc["hysteresis"];
+    if (doc.containsKey("autoCal"))
+      cfg.autoCalibrate = doc["autoCal"];
+    if (doc.containsKey("ledStyle"))
+      cfg.ledStyle = ledMeterParseStyle(doc["ledStyle"]);
 
     // Messages
     JsonArray msgs = doc["messages"];
@@ -1738,6 +1784,36 @@ void setup_web_server() {
     server.send(200, "text/plain", "OK");
   });
 
+  // Download the last analog capture (see AnalogTrace.h)
+  server.on("/api/analog/trace", HTTP_GET, []() {
+    if (!mountStorage() || !SPIFFS.exists(AIN_TRACE_FILE)) {
+      server.send(404, "text/plain", "No trace captured");
+      return;
+    }
+    File file = SPIFFS.open(AIN_TRACE_FILE, FILE_READ);
+    server.sendHeader("Content-Disposition",
+                      "attachment; filename=ain_trace.bin");
+    server.streamFile(file, "application/octet-stream");
+    file.close();
+  });
+
+  // Screenshot of a screen rendered into RAM (PPM) - see DisplayCapture.h
+  server.on("/api/display/screenshot", HTTP_GET, []() {
+    CaptureScreen screen;
+    if (!parseCaptureScreen(server.arg("screen"), &screen)) {
+      server.send(400, "text/plain", "Unknown screen");
+      return;
+    }
+    server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+    server.send(200, "image/x-portable-pixmap", "");
+    bool ok = captureDisplay(screen, [](const uint8_t *rgb, size_t len) {
+      server.sendContent((const char *)rgb, len);
+    });
+    if (!ok)
+      Serial.println("Screenshot failed (no display or heap)");
+    server.sendContent("");
+  });
+
   server.on("/api/expression/calibrate", HTTP_POST, []() {
     if (!server.hasArg("plain")) {
       server.send(400, "text/plain", "Missing JSON body");
@@ -1758,8 +1834,10 @@ void setup_web_server() {
       server.send(200, "text/plain", "Calibration started");
     } else {
       stopCalibration(idx);
+      // Write-behind like the on-device path; the HTTP reply does not wait
+      // for SPIFFS
+      scheduleAnalogCalibrationSave(AIN_CAL_SAVE_DELAY_MS);
       AnalogInputConfig &cfg = analogInputs[idx];
-      saveAnalogInputs();
       String response = "{\"minVal\":";
       response += String(cfg.minVal);
       response += ",\"maxVal\":";
@@ -1912,6 +1990,11 @@ String buildFullConfigJson() {
   json += String(systemConfig.buttonCount);
   json += ",\"ledsPerButton\":";
   json += String(systemConfig.ledsPerButton);
+  json += ",\"ledCount\":";
+  json += String(ledStripLength);
+  json += ",\"ledSegments\":\"";
+  json += ledSegmentsText();
+  json += "\"";
   json += ",\"bleDeviceName\":\"";
   json += systemConfig.bleDeviceName;
   json += "\",\"apSSID\":\"";
@@ -1922,6 +2005,10 @@ String buildFullConfigJson() {
   json += String(ledBrightnessDim);
   json += ",\"brightnessTap\":";
   json += String(ledBrightnessTap);
+  json += ",\"ledMaxMa\":";
+  json += String(ledPowerBudgetMa);
+  json += ",\"ccMaxRate\":";
+  json += String(ccMaxRateHz);
   json += ",\"debugAnalogIn\":";
   json += systemConfig.debugAnalogIn ? "true" : "false";
   json += ",\"batteryAdcPin\":";
@@ -1934,6 +2021,8 @@ String buildFullConfigJson() {
       (int)oledConfig.type); // 0=none, 1=128x64, 2=128x32, 3=128x128, 4=128x160
   json += ",\"rotation\":";
   json += String(oledConfig.rotation);
+  json += ",\"theme\":";
+  json += String(displayTheme); // TFT color theme (TftFrame.h)
   // Display pins (v1.5.2)
   json += ",\"sdaPin\":";
   json += String(oledConfig.sdaPin);
@@ -2148,6 +2237,13 @@ String buildFullConfigJson() {
     json += String(cfg.emaAlpha, 2);
     json += ",\"hysteresis\":";
     json += String(cfg.hysteresis);
+    if (cfg.autoCalibrate)
+      json += ",\"autoCal\":true";
+    if (cfg.ledStyle != AIN_LED_LEVEL) {
+      json += ",\"ledStyle\":\"";
+      json += ledMeterStyleName(cfg.ledStyle);
+      json += "\"";
+    }
 
     json += ",\"messages\":[";
     for (int m = 0; m < cfg.messageCount; m++) {
@@ -2177,6 +2273,8 @@ String buildFullConfigJson() {
 
 // Consolidated Configuration Parsing (v1.5)
 bool applyConfigJson(JsonObject doc) {
+  DisplayLock lock; // Display task reads the config from core 0
+
   // Config Metadata
   if (doc.containsKey("configName")) {
     strncpy(configProfileName, doc["configName"] | "", 31);
@@ -2328,6 +2426,11 @@ bool applyConfigJson(JsonObject doc) {
       ledBrightnessDim = sys["brightnessDim"];
     if (sys.containsKey("brightnessTap"))
       ledBrightnessTap = sys["brightnessTap"];
+    if (sys.containsKey("ledMaxMa"))
+      ledPowerBudgetMa = ledPowerClampBudget(sys["ledMaxMa"].as<int>());
+    if (sys.containsKey("ccMaxRate"))
+      ccMaxRateHz = constrain((int)sys["ccMaxRate"], CC_MAX_RATE_MIN_HZ,
+                              CC_MAX_RATE_MAX_HZ);
     if (sys.containsKey("debounce"))
       buttonDebounce = sys["debounce"];
     if (sys.containsKey("wifiOnAtBoot"))
@@ -2372,6 +2475,10 @@ bool applyConfigJson(JsonObject doc) {
       systemConfig.ledPin = sys["ledPin"];
     if (sys.containsKey("ledsPerButton"))
       systemConfig.ledsPerButton = sys["ledsPerButton"];
+    if (sys.containsKey("ledCount"))
+      ledStripLength = constrain((int)sys["ledCount"], 1, MAX_LEDS);
+    if (sys.containsKey("ledSegments"))
+      ledSegmentsParse(sys["ledSegments"] | "");
     if (sys.containsKey("ledMap")) {
       String mapStr = sys["ledMap"].as<String>();
       int idx = 0;
@@ -2381,6 +2488,9 @@ bool applyConfigJson(JsonObject doc) {
         token = strtok(NULL, ", ");
       }
     }
+    if (sys.containsKey("ledsPerButton") || sys.containsKey("ledSegments") ||
+        sys.containsKey("ledMap"))
+      ledLayoutChanged();
     if (sys.containsKey("encoderA"))
       systemConfig.encoderA = sys["encoderA"];
     if (sys.containsKey("encoderB"))
@@ -2474,6 +2584,9 @@ bool applyConfigJson(JsonObject doc) {
       else
         oledConfig.rotation = 0;
 
+      uint8_t theme = oled["theme"] | 0;
+      displayTheme = theme < TFT_THEME_COUNT ? theme : 0;
+
       // Display pins (v1.5.2)
       oledConfig.sdaPin = oled["sdaPin"] | 21;
       oledConfig.sclPin = oled["sclPin"] | 22;
@@ -2695,6 +2808,8 @@ bool applyConfigJson(JsonObject doc) {
         acfg.hysteresis = aObj["hysteresis"];
       else if (acfg.hysteresis == 0)
         acfg.hysteresis = 3; // DEFAULT_HYSTERESIS
+      acfg.autoCalibrate = aObj["autoCal"] | false;
+      acfg.ledStyle = ledMeterParseStyle(aObj["ledStyle"] | "level");
 
       JsonArray amsgs = aObj["messages"];
       if (!amsgs.isNull()) {
@@ -2772,7 +2887,7 @@ void finalizeConfigUpload() {
   // Update display
   // Update display
   initDisplayHardware(); // Re-initialize in case type changed
-  displayOLED();
+  requestDisplay(VIEW_MAIN, DISPLAY_REASON_CONFIG);
   updateLeds();
 
   Serial.println("Config saved to NVS");
@@ -2804,7 +2919,7 @@ void handleSerialConfig() {
         int preset = serialBuffer.substring(11).toInt();
         if (preset >= 0 && preset < 4) {
           currentPreset = preset;
-          displayOLED();
+          requestDisplay(VIEW_MAIN, DISPLAY_REASON_CONFIG, DISPLAY_HIGH);
           updateLeds();
           Serial.println("OK:PRESET_SET");
         } else {
@@ -2982,6 +3097,11 @@ void handleSerialConfig() {
         Serial.print(systemConfig.ledPin);
         Serial.print(",\"ledsPerButton\":");
         Serial.print(systemConfig.ledsPerButton);
+        Serial.print(",\"ledCount\":");
+        Serial.print(ledStripLength);
+        Serial.print(",\"ledSegments\":\"");
+        Serial.print(ledSegmentsText());
+        Serial.print("\"");
         Serial.print(",\"ledMap\":\"");
         for (int i = 0; i < 10; i++) {
           if (i > 0)
@@ -3008,6 +3128,10 @@ void handleSerialConfig() {
         Serial.print(ledBrightnessDim);
         Serial.print(",\"brightnessTap\":");
         Serial.print(ledBrightnessTap);
+        Serial.print(",\"ledMaxMa\":");
+        Serial.print(ledPowerBudgetMa);
+        Serial.print(",\"ccMaxRate\":");
+        Serial.print(ccMaxRateHz);
         Serial.print(",\"analogInputCount\":");
         Serial.print(systemConfig.analogInputCount);
         Serial.print(",\"targetDevice\":");
@@ -3050,6 +3174,8 @@ void handleSerialConfig() {
                                                       : "128x64");
         Serial.print("\",\"rotation\":");
         Serial.print(oledConfig.rotation * 90);
+        Serial.print(",\"theme\":");
+        Serial.print(displayTheme);
         Serial.print(",\"screens\":{");
 
         // Main Screen
@@ -3212,6 +3338,13 @@ void handleSerialConfig() {
           Serial.print(cfg.emaAlpha);
           Serial.print(",\"hysteresis\":");
           Serial.print(cfg.hysteresis);
+          if (cfg.autoCalibrate)
+            Serial.print(",\"autoCal\":true");
+          if (cfg.ledStyle != AIN_LED_LEVEL) {
+            Serial.print(",\"ledStyle\":\"");
+            Serial.print(ledMeterStyleName(cfg.ledStyle));
+            Serial.print("\"");
+          }
 
           Serial.print(",\"messages\":[");
           for (int m = 0; m < cfg.messageCount; m++) {
@@ -3316,6 +3449,134 @@ void handleSerialConfig() {
         }
         Serial.println("SCAN_RESUMED");
       }
+      // MIDI_STATS - CC coalescer counters (sweep lag / traffic check)
+      else if (serialBuffer == "MIDI_STATS") {
+        Serial.printf("MIDI_STATS:queued=%u,sent=%u,superseded=%u,"
+                      "dropped=%u,maxLagMs=%u,rateHz=%d\n",
+                      coalesceStats.queued, coalesceStats.sent,
+                      coalesceStats.superseded, coalesceStats.dropped,
+                      coalesceStats.maxLagMs, ccMaxRateHz);
+        coalesceStats = CoalesceStats{0, 0, 0, 0, 0};
+      }
+      // LED_STATS - LED task, animation, service, meter and power counters
+      else if (serialBuffer == "LED_STATS") {
+        LedTaskStats &lt = ledTaskStats;
+        Serial.printf("LED_STATS:commits=%u,frames=%u,coalesced=%u,"
+                      "heapSkipped=%u,lastShowUs=%u,maxShowUs=%u,"
+                      "maxCommitUs=%u\n",
+                      lt.commits, lt.frames, lt.coalesced, lt.heapSkipped,
+                      lt.lastShowUs, lt.maxShowUs, lt.maxCommitUs);
+        Serial.printf("LED_ANIM:frames=%u,lastUs=%u,maxUs=%u\n",
+                      ledAnimStats.frames, ledAnimStats.lastUs,
+                      ledAnimStats.maxUs);
+        LedServiceStats &ls = ledServiceStats;
+        Serial.printf("LED_SERVICE:calls=%u,busy=%u,recomputed=%u,"
+                      "lastUs=%u,maxUs=%u\n",
+                      ls.calls, ls.busy, ls.recomputed, ls.lastUs, ls.maxUs);
+        Serial.printf("LED_METER:updates=%u,frames=%u,renders=%u\n",
+                      ledMeterStats.updates, ledMeterStats.frames,
+                      ledMeterStats.renders);
+        Serial.printf("LED_POWER:budgetMa=%u,lastMa=%u,maxMa=%u,limited=%u,"
+                      "lastScale=%u\n",
+                      ledPowerBudgetMa, ledPowerStats.lastMa,
+                      ledPowerStats.maxMa, ledPowerStats.limited,
+                      ledPowerStats.lastScale);
+      }
+      // NVS_STATS - Settings cache counters and NVS writes per key
+      else if (serialBuffer == "NVS_STATS") {
+        settingsPrintStats(Serial);
+      }
+      // DISPLAY_STATS - Pixels pushed by the TFT scene (see DisplayScene.h)
+      else if (serialBuffer == "DISPLAY_STATS") {
+        Serial.printf("DISPLAY_STATS:frames=%u,full=%u,lastPx=%u,"
+                      "lastWidgets=%u,maxPartialPx=%u,totalPx=%llu\n",
+                      sceneStats.frames, sceneStats.fullRepaints,
+                      sceneStats.lastPixels, sceneStats.lastWidgets,
+                      sceneStats.maxPixels, sceneStats.totalPixels);
+        DisplayTaskStats &ds = displayTaskStats;
+        Serial.printf("DISPLAY_TASK:requests=%u,frames=%u,lastFrameUs=%u,"
+                      "avgFrameUs=%u,maxFrameUs=%u,maxPostUs=%u,bands=%u\n",
+                      ds.requests, ds.frames, ds.lastFrameUs,
+                      ds.frames ? (uint32_t)(ds.totalFrameUs / ds.frames) : 0,
+                      ds.maxFrameUs, ds.maxPostUs, sceneStats.lastBands);
+        MainScreenStats &ms = mainScreenStats;
+        Serial.printf("MAIN_SCREEN:layoutCompiles=%u,layoutUs=%u,"
+                      "meterFrames=%u,meterPx=%u,meterUs=%u\n",
+                      ms.compiles, ms.lastLayoutUs, ms.meterFrames,
+                      ms.lastMeterPixels, ms.lastMeterUs);
+        LabelCacheStats &ls = labelCacheStats;
+        Serial.printf("LABEL_CACHE:hits=%u,misses=%u,evictions=%u,entries=%u,"
+                      "bytes=%u\n",
+                      ls.hits, ls.misses, ls.evictions, ls.entries, ls.bytes);
+        OledFlushStats &os = oledFlushStats;
+        Serial.printf("OLED_FLUSH:flushes=%u,skipped=%u,full=%u,lastBytes=%u,"
+                      "totalBytes=%llu,lastUs=%u,maxUs=%u,errors=%u,"
+                      "fallbacks=%u,clockHz=%u,busDowns=%u,recoveries=%u\n",
+                      os.flushes, os.skipped, os.fullFlushes, os.lastBytes,
+                      os.totalBytes, os.lastUs, os.maxUs, os.errors,
+                      os.fallbacks, oledBusClock(), os.busDowns,
+                      os.recoveries);
+        DisplaySchedulerStats &ss = displaySchedulerStats;
+        Serial.printf("DISPLAY_SCHED:frames=%u,coalesced=%u,heapDeferred=%u,"
+                      "input=%u,config=%u,midi=%u,analog=%u,periodic=%u,"
+                      "overlay=%u,recovery=%u\n",
+                      ss.frames, ss.coalesced, ss.heapDeferred,
+                      ss.requests[DISPLAY_REASON_INPUT],
+                      ss.requests[DISPLAY_REASON_CONFIG],
+                      ss.requests[DISPLAY_REASON_MIDI],
+                      ss.requests[DISPLAY_REASON_ANALOG],
+                      ss.requests[DISPLAY_REASON_PERIODIC],
+                      ss.requests[DISPLAY_REASON_OVERLAY],
+                      ss.requests[DISPLAY_REASON_RECOVERY]);
+        TftFrameStats &fs = tftFrameStats;
+        Serial.printf("TFT_FRAME:active=%d,theme=%s,flushes=%u,skipped=%u,"
+                      "full=%u,lastRows=%u,totalRows=%u,lastUs=%u,maxUs=%u,"
+                      "nearest=%u\n",
+                      tftFrameActive(), tftThemeName(displayTheme),
+                      fs.flushes, fs.skipped, fs.fullPushes, fs.lastRows,
+                      fs.totalRows, fs.lastUs, fs.maxUs, fs.nearest);
+      }
+      // DISPLAY_PROFILE - Draw calls / pixels / CPU time per screen
+      else if (serialBuffer == "DISPLAY_PROFILE") {
+        for (int i = CAPTURE_MAIN; i < CAPTURE_SCREEN_COUNT; i++) {
+          DisplayProfile p;
+          if (!profileDisplay((CaptureScreen)i, &p)) {
+            Serial.println("DISPLAY_PROFILE:ERROR:No display");
+            break;
+          }
+          Serial.printf("DISPLAY_PROFILE:screen=%s,calls=%u,pixels=%u,us=%u\n",
+                        captureScreenName((CaptureScreen)i), p.calls,
+                        p.pixels, p.us);
+        }
+      }
+      // AIN_CAPTURE:<mask>,<ms> - Record raw ADC samples to SPIFFS
+      else if (serialBuffer.startsWith("AIN_CAPTURE:")) {
+        String args = serialBuffer.substring(12);
+        int comma = args.indexOf(',');
+        uint16_t mask = strtoul(args.c_str(), NULL, 0);
+        uint32_t ms = comma > 0 ? args.substring(comma + 1).toInt() : 10000;
+        Serial.println(startAnalogCapture(mask, ms) ? "CAPTURE_STARTED"
+                                                    : "CAPTURE_ERROR");
+      } else if (serialBuffer == "AIN_CAPTURE_STOP") {
+        stopAnalogCapture();
+        Serial.println("CAPTURE_STOPPED");
+      }
+      // AIN_REPLAY[:MIDI] - Run the capture through the current settings
+      else if (serialBuffer.startsWith("AIN_REPLAY")) {
+        AnalogReplayResult res;
+        bool sendMidi = serialBuffer.endsWith(":MIDI");
+        if (replayAnalogTrace(sendMidi, res)) {
+          Serial.printf("AIN_REPLAY:samples=%u,emitted=%u,cpuAvgUs=%u,"
+                        "cpuMaxUs=%u,tailLatencyMs=%u,durationMs=%u",
+                        res.samples, res.emitted, res.cpuAvgUs, res.cpuMaxUs,
+                        res.tailLatencyMs, res.durationMs);
+          if (sendMidi)
+            Serial.printf(",sent=%u,wireTailMs=%u", res.sent, res.wireTailMs);
+          Serial.println();
+        } else {
+          Serial.println("AIN_REPLAY_ERROR");
+        }
+      }
       // SET_CONFIG_CHUNK:{data} - Receive a chunk of config data
       else if (serialBuffer.startsWith("SET_CONFIG_CHUNK:")) {
         String chunk = serialBuffer.substring(17);
@@ -3335,6 +3596,9 @@ void handleSerialConfig() {
         Serial.printf("Parsing %d bytes of config...\n", uploadBufferLen);
         Serial.printf("Free heap before cleanup: %d\n", ESP.getFreeHeap());
 
+        // Until the new config is applied the arrays are zeroed - no frames
+        DisplayLock lock;
+
         // Clear existing config arrays to free memory before parsing
         // This returns ~10KB+ of RAM consumed by loaded config
         for (int p = 0; p < CHOCO_MAX_PRESETS; p++) {
@@ -3428,12 +3692,13 @@ void handleSerialConfig() {
 
           // Reinitialize display
           initDisplayHardware();
-          displayOLED();
+          requestDisplay(VIEW_MAIN, DISPLAY_REASON_CONFIG);
           updateLeds();
 
           Serial.println("SAVE_OK");
           Serial.println("Config saved successfully!");
           Serial.println("Rebooting in 1 second...");
+          settingsFlush();
           delay(1000);
           ESP.restart();
         }
@@ -3542,7 +3807,7 @@ void turnBtSerialOn() {
   Serial.println("Then select the Bluetooth COM port in the editor.");
   Serial.flush();
 
-  displayOLED();
+  requestDisplay(VIEW_CURRENT, DISPLAY_REASON_CONFIG); // BT Serial status
 #else
   Serial.println("BT Serial not supported on ESP32-S3");
 #endif
@@ -3579,7 +3844,7 @@ void turnBtSerialOff() {
   Serial.println("BLE reinitialized");
   Serial.flush();
 
-  displayOLED();
+  requestDisplay(VIEW_CURRENT, DISPLAY_REASON_CONFIG); // BT Serial status
 #endif
 }
 
@@ -3775,6 +4040,11 @@ void handleBtSerialConfig() {
         SerialBT.print(systemConfig.ledPin);
         SerialBT.print(",\"ledsPerButton\":");
         SerialBT.print(systemConfig.ledsPerButton);
+        SerialBT.print(",\"ledCount\":");
+        SerialBT.print(ledStripLength);
+        SerialBT.print(",\"ledSegments\":\"");
+        SerialBT.print(ledSegmentsText());
+        SerialBT.print("\"");
         yield(); // Feed watchdog mid-system config
         SerialBT.print(",\"ledMap\":\"");
         for (int i = 0; i < 10; i++) {
@@ -3803,6 +4073,10 @@ void handleBtSerialConfig() {
         SerialBT.print(ledBrightnessDim);
         SerialBT.print(",\"brightnessTap\":");
         SerialBT.print(ledBrightnessTap);
+        SerialBT.print(",\"ledMaxMa\":");
+        SerialBT.print(ledPowerBudgetMa);
+        SerialBT.print(",\"ccMaxRate\":");
+        SerialBT.print(ccMaxRateHz);
         SerialBT.print(",\"analogInputCount\":");
         SerialBT.print(systemConfig.analogInputCount);
         SerialBT.print(",\"targetDevice\":");
@@ -3841,6 +4115,8 @@ void handleBtSerialConfig() {
         SerialBT.print(oledConfig.type == OLED_128X32 ? "128x32" : "128x64");
         SerialBT.print("\",\"rotation\":");
         SerialBT.print(oledConfig.rotation * 90);
+        SerialBT.print(",\"theme\":");
+        SerialBT.print(displayTheme);
         SerialBT.print(",\"screens\":{");
 
         // Main Screen
@@ -3966,6 +4242,13 @@ void handleBtSerialConfig() {
           SerialBT.print(cfg.emaAlpha);
           SerialBT.print(",\"hysteresis\":");
           SerialBT.print(cfg.hysteresis);
+          if (cfg.autoCalibrate)
+            SerialBT.print(",\"autoCal\":true");
+          if (cfg.ledStyle != AIN_LED_LEVEL) {
+            SerialBT.print(",\"ledStyle\":\"");
+            SerialBT.print(ledMeterStyleName(cfg.ledStyle));
+            SerialBT.print("\"");
+          }
 
           SerialBT.print(",\"messages\":[");
           for (int m = 0; m < cfg.messageCount; m++) {
@@ -4046,7 +4329,7 @@ void handleBtSerialConfig() {
         int preset = btSerialBuffer.substring(11).toInt();
         if (preset >= 0 && preset < 4) {
           currentPreset = preset;
-          displayOLED();
+          requestDisplay(VIEW_MAIN, DISPLAY_REASON_CONFIG, DISPLAY_HIGH);
           updateLeds();
           SerialBT.print("PRESET_OK:");
           SerialBT.println(preset);
@@ -4109,7 +4392,7 @@ void handleBtSerialConfig() {
 
           // Reinitialize display
           initDisplayHardware();
-          displayOLED();
+          requestDisplay(VIEW_MAIN, DISPLAY_REASON_CONFIG);
           updateLeds();
 
           currentPreset = 0;
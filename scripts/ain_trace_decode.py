@@ -0,0 +1,60 @@
+#!/usr/bin/env python3
+"""
+Decode an analog trace captured with AIN_CAPTURE (/ain_trace.bin, downloaded
+from http://<device>/api/analog/trace) into CSV and print per-input stats.
+
+Usage: python ain_trace_decode.py ain_trace.bin [out.csv]
+"""
+import struct
+import sys
+
+HEADER = struct.Struct("<IBBHIHH")
+RECORD = struct.Struct("<HH")
+MAGIC = 0x54414843
+
+
+def decode(path):
+    with open(path, "rb") as f:
+        data = f.read()
+    magic, version, rec_size, mask, start_ms, interval_ms, _ = HEADER.unpack_from(data, 0)
+    if magic != MAGIC:
+        raise SystemExit("Not an analog trace file")
+    if version != 1 or rec_size != RECORD.size:
+        raise SystemExit("Unsupported trace version %d / record size %d" % (version, rec_size))
+
+    samples = []
+    t = 0
+    for off in range(HEADER.size, len(data) - rec_size + 1, rec_size):
+        dt, input_raw = RECORD.unpack_from(data, off)
+        t += dt
+        if dt == 0xFFFF:
+            continue  # time-only marker
+        samples.append((t, (input_raw >> 12) + 1, input_raw & 0x0FFF))
+    return mask, interval_ms, samples
+
+
+def main():
+    if len(sys.argv) < 2:
+        print(__doc__)
+        return
+    mask, interval_ms, samples = decode(sys.argv[1])
+    print("Inputs mask: 0x%04X, read interval: %d ms, samples: %d" % (mask, interval_ms, len(samples)))
+
+    per_input = {}
+    for t, ain, raw in samples:
+        per_input.setdefault(ain, []).append(raw)
+    for ain in sorted(per_input):
+        vals = per_input[ain]
+        jitter = max(abs(a - b) for a, b in zip(vals, vals[1:])) if len(vals) > 1 else 0
+        print("  A%d: n=%d min=%d max=%d max-step=%d" % (ain, len(vals), min(vals), max(vals), jitter))
+
+    if len(sys.argv) > 2:
+        with open(sys.argv[2], "w") as out:
+            out.write("ms,input,raw\n")
+            for t, ain, raw in samples:
+                out.write("%d,A%d,%d\n" % (t, ain, raw))
+        print("Wrote", sys.argv[2])
+
+
+if __name__ == "__main__":
+    main()
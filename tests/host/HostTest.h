@@ -0,0 +1,38 @@
+#ifndef HOST_TEST_H
+#define HOST_TEST_H
+
+#include <stdio.h>
+
+// ============================================
+// HOST TEST CHECKS
+// CHECK* report the failing line and keep going; main() returns
+// hostTestResult() so ctest sees any failure.
+// ============================================
+
+static int hostTestFailures = 0;
+
+#define CHECK(cond)                                                            \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond);          \
+      hostTestFailures++;                                                      \
+    }                                                                          \
+  } while (0)
+
+#define CHECK_EQ(a, b)                                                         \
+  do {                                                                         \
+    long long va_ = (long long)(a), vb_ = (long long)(b);                      \
+    if (va_ != vb_) {                                                          \
+      printf("%s:%d: CHECK_EQ(%s, %s) failed: %lld != %lld\n", __FILE__,       \
+             __LINE__, #a, #b, va_, vb_);                                      \
+      hostTestFailures++;                                                      \
+    }                                                                          \
+  } while (0)
+
+static inline int hostTestResult() {
+  if (hostTestFailures)
+    printf("%d check(s) failed\n", hostTestFailures);
+  return hostTestFailures ? 1 : 0;
+}
+
+#endif
@@ -0,0 +1,134 @@
+#ifndef PRESET_FIXTURE_H
+#define PRESET_FIXTURE_H
+
+#include "PresetFile.h"
+#include <string.h>
+#include <vector>
+
+// ============================================
+// PRESET TEST FIXTURE
+// An in-memory TLV file that can lose power after a given number of
+// bytes, and deterministic preset content that exercises every field.
+// ============================================
+
+struct MemFile : TlvSink, TlvSource {
+  std::vector<uint8_t> bytes;
+  uint32_t pos = 0;
+  size_t cutAt = ~(size_t)0; // Bytes accepted before the power goes
+
+  size_t write(const uint8_t *data, size_t len) override {
+    size_t n = bytes.size() + len > cutAt ? cutAt - bytes.size() : len;
+    bytes.insert(bytes.end(), data, data + n);
+    return n;
+  }
+  size_t read(uint8_t *data, size_t len) override {
+    size_t n = pos + len > bytes.size() ? bytes.size() - pos : len;
+    if (n) // data may be null for an empty read
+      memcpy(data, bytes.data() + pos, n);
+    pos += n;
+    return n;
+  }
+  bool seek(uint32_t p) override {
+    if (p > bytes.size())
+      return false;
+    pos = p;
+    return true;
+  }
+  uint32_t position() override { return pos; }
+  uint32_t size() override { return bytes.size(); }
+};
+
+// Every preset/button/message distinct, SysEx and long-press unions used
+inline void fillTestPresets() {
+  for (int p = 0; p < CHOCO_MAX_PRESETS; p++) {
+    snprintf(presetNames[p], 21, "Preset %d", p);
+    presetLedModes[p] = (PresetLedMode)(p & 1);
+    presetSyncMode[p] = (SyncMode)(p % 3);
+    for (int b = 0; b < MAX_BUTTONS; b++) {
+      ButtonConfig &c = buttonConfigs[p][b];
+      memset(&c, 0, sizeof(c));
+      snprintf(c.name, sizeof(c.name), "B%d-%d", p, b);
+      c.ledMode = (LedMode)(b & 1);
+      c.inSelectionGroup = b & 1;
+      c.messageCount = b % 4;
+      for (int m = 0; m < c.messageCount; m++) {
+        ActionMessage &a = c.messages[m];
+        a.action = (ActionType)m;
+        a.type = m == 2 ? SYSEX : CC;
+        a.channel = m + 1;
+        a.data1 = b;
+        a.data2 = p;
+        a.rgb[0] = p;
+        a.rgb[1] = b;
+        a.rgb[2] = m;
+        strcpy(a.label, "ab");
+        a.minInput = 1;
+        a.maxInput = 99;
+        a.minOut = 3;
+        a.maxOut = 120;
+        if (a.type == SYSEX) {
+          a.sysex.length = 40;
+          for (int i = 0; i < 40; i++)
+            a.sysex.data[i] = i;
+        } else {
+          a.longPress.holdMs = 700 + m;
+        }
+      }
+    }
+  }
+  for (int i = 0; i < MAX_BUTTONS; i++) {
+    GlobalSpecialAction &s = globalSpecialActions[i];
+    memset(&s, 0, sizeof(s));
+    s.hasCombo = i & 1;
+    s.partner = i - 1;
+    s.comboAction.data1 = i;
+  }
+  strcpy(configProfileName, "prof");
+  strcpy(configLastModified, "2026");
+}
+
+// Saved records, as the globals the codec reads and writes
+struct PresetSnapshot {
+  ButtonConfig buttons[CHOCO_MAX_PRESETS][MAX_BUTTONS];
+  char names[CHOCO_MAX_PRESETS][21];
+  PresetLedMode ledModes[CHOCO_MAX_PRESETS];
+  SyncMode syncModes[CHOCO_MAX_PRESETS];
+  GlobalSpecialAction specials[MAX_BUTTONS];
+
+  void take() {
+    memcpy(buttons, buttonConfigs, sizeof(buttons));
+    memcpy(names, presetNames, sizeof(names));
+    memcpy(ledModes, presetLedModes, sizeof(ledModes));
+    memcpy(syncModes, presetSyncMode, sizeof(syncModes));
+    memcpy(specials, globalSpecialActions, sizeof(specials));
+  }
+  // Records that differ from the globals (saved fields only)
+  int diff() const {
+    int n = 0;
+    for (int p = 0; p < CHOCO_MAX_PRESETS; p++) {
+      for (int b = 0; b < MAX_BUTTONS; b++) {
+        const ButtonConfig &x = buttonConfigs[p][b], &y = buttons[p][b];
+        n += strcmp(x.name, y.name) || x.ledMode != y.ledMode ||
+             x.inSelectionGroup != y.inSelectionGroup ||
+             x.messageCount != y.messageCount ||
+             memcmp(x.messages, y.messages,
+                    y.messageCount * sizeof(ActionMessage));
+      }
+      n += strcmp(presetNames[p], names[p]) ||
+           presetLedModes[p] != ledModes[p] || presetSyncMode[p] != syncModes[p];
+    }
+    return n + (memcmp(globalSpecialActions, specials, sizeof(specials)) != 0);
+  }
+};
+
+// Wipe the globals the codec decodes into
+inline void clearPresets() {
+  memset(buttonConfigs, 0, sizeof(buttonConfigs));
+  memset(presetNames, 0, sizeof(presetNames));
+  memset(presetLedModes, 0, sizeof(presetLedModes));
+  memset(presetSyncMode, 0, sizeof(presetSyncMode));
+  memset(globalSpecialActions, 0, sizeof(globalSpecialActions));
+  configProfileName[0] = 0;
+}
+
+#endif
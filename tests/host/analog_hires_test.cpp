@@ -0,0 +1,140 @@
+#include "HostTest.h"
+#include "AnalogInput.h"
+#include "MidiCoalescer.h"
+#include <HostHal.h>
+
+// 14-bit CC and NRPN output of analog inputs (user-026): a pedal trace is
+// read through readAnalogInputs() and the coalescer on the virtual clock,
+// and the controller bytes on the wire are checked - MSB/LSB pairs, NRPN
+// select + data entry, no traffic for LSB jitter inside the x4 hysteresis
+// and at most one hi-res update per AIN_HIRES_MIN_INTERVAL_MS.
+
+#define PEDAL_PIN 34
+#define CC14_MSB 4
+#define NRPN_PARAM ((2 << 7) | 16)
+
+// Pedal position as a function of time, stepped 1 ms at a time
+typedef int (*Trace)(unsigned long t);
+
+static void run(Trace trace, unsigned long ms) {
+  for (unsigned long t = 0; t < ms; t++) {
+    hostSetAnalog(PEDAL_PIN, trace(t));
+    readAnalogInputs();
+    flushMidiCoalescer();
+    hostAdvanceMillis(1);
+  }
+}
+
+static void setup(MidiCommandType type) {
+  AnalogInputConfig &cfg = analogInputs[0];
+  cfg.enabled = true;
+  cfg.pin = PEDAL_PIN;
+  cfg.emaAlpha = 1.0f; // Trace values reach the output unfiltered
+  cfg.hysteresis = DEFAULT_HYSTERESIS;
+  cfg.messageCount = 1;
+  ActionMessage &m = cfg.messages[0];
+  m.type = type;
+  m.channel = 1;
+  m.data1 = type == NRPN ? (NRPN_PARAM & 0x7F) : CC14_MSB;
+  m.data2 = type == NRPN ? NRPN_PARAM >> 7 : 0;
+  m.minInput = 0;
+  m.maxInput = 100;
+  m.minOut = 0;
+  m.maxOut = 127;
+  hostSetAnalog(PEDAL_PIN, 1800);
+  setupAnalogInputs();
+  hostAdvanceMillis(1000); // Coalescer slots from earlier runs are idle
+}
+
+static size_t logged(size_t from) { return hostMidiLog.size() - from; }
+
+static const HostMidiEvent &at(size_t i) { return hostMidiLog[i]; }
+
+static int rest(unsigned long) { return 1800; }
+static int jitter(unsigned long t) { return 1800 + (int)(t % 5) - 2; }
+static int nudge(unsigned long) { return 1805; } // +20 hi-res, same MSB
+static int sweep(unsigned long t) { return 1000 + (int)t * 10; }
+static int top(unsigned long) { return 3990; } // Where the sweep ends
+
+int main() {
+  hostSetMillis(10000);
+
+  // CC14: first value goes out as MSB + LSB on CC n / n+32
+  setup(CC_14BIT);
+  size_t from = hostMidiLog.size();
+  run(rest, 10);
+  CHECK_EQ(logged(from), 2);
+  CHECK_EQ(at(from).kind, HOST_MIDI_CC);
+  CHECK_EQ(at(from).a, CC14_MSB);
+  CHECK_EQ(at(from + 1).a, CC14_MSB + 32);
+  int v = at(from).b << 7 | at(from + 1).b;
+  CHECK(abs(v - 1800 * AIN_HIRES_MAX / 4095) <= 1);
+
+  // LSB jitter (+-2 ADC counts = +-8 hi-res) stays inside the x4 hysteresis
+  from = hostMidiLog.size();
+  uint32_t emits = analogEmitCount;
+  run(jitter, 2000);
+  CHECK_EQ(logged(from), 0);
+  CHECK_EQ(analogEmitCount, emits);
+
+  // A real move that keeps the MSB costs one LSB message
+  from = hostMidiLog.size();
+  run(nudge, 50);
+  CHECK_EQ(logged(from), 1);
+  CHECK_EQ(at(from).a, CC14_MSB + 32);
+  int moved = (v & ~0x7F) | at(from).b;
+  CHECK(moved - v > DEFAULT_HYSTERESIS * AIN_HIRES_HYST_SCALE);
+  CHECK_EQ(moved >> 7, v >> 7);
+
+  // Fast sweep: 40 hi-res per read passes the hysteresis every read, the
+  // hi-res rate limit keeps triggers to one per AIN_HIRES_MIN_INTERVAL_MS
+  from = hostMidiLog.size();
+  emits = analogEmitCount;
+  run(sweep, 300);
+  uint32_t triggers = analogEmitCount - emits;
+  CHECK(triggers <= 300 / AIN_HIRES_MIN_INTERVAL_MS + 1);
+  CHECK(triggers >= 300 / AIN_HIRES_MIN_INTERVAL_MS - 1);
+  run(top, 100); // Rate limits release the resting value
+  // The wire carries LSBs always, MSBs only when they changed, and the
+  // last message is the LSB of the final position
+  int msb = v >> 7, lsbs = 0, msbs = 0;
+  for (size_t i = from; i < hostMidiLog.size(); i++) {
+    if (at(i).a == CC14_MSB) {
+      CHECK(at(i).b != msb);
+      msb = at(i).b;
+      msbs++;
+    } else {
+      CHECK_EQ(at(i).a, CC14_MSB + 32);
+      lsbs++;
+    }
+  }
+  CHECK(lsbs > 0 && msbs > 0 && msbs <= lsbs);
+  CHECK_EQ(at(hostMidiLog.size() - 1).a, CC14_MSB + 32);
+  int last = msb << 7 | at(hostMidiLog.size() - 1).b;
+  CHECK(abs(last - 3990 * AIN_HIRES_MAX / 4095) <=
+        DEFAULT_HYSTERESIS * AIN_HIRES_HYST_SCALE);
+  printf("CC14 sweep: %u triggers, %d MSB + %d LSB messages\n", triggers,
+         msbs, lsbs);
+
+  // NRPN: select (CC99/98) then data entry (CC6/38), all four every time
+  setup(NRPN);
+  from = hostMidiLog.size();
+  run(rest, 10);
+  CHECK_EQ(logged(from), 4);
+  CHECK_EQ(at(from).a, 99);
+  CHECK_EQ(at(from).b, NRPN_PARAM >> 7);
+  CHECK_EQ(at(from + 1).a, 98);
+  CHECK_EQ(at(from + 1).b, NRPN_PARAM & 0x7F);
+  CHECK_EQ(at(from + 2).a, 6);
+  CHECK_EQ(at(from + 3).a, 38);
+  CHECK_EQ(at(from + 2).b << 7 | at(from + 3).b, v);
+
+  from = hostMidiLog.size();
+  run(jitter, 2000);
+  CHECK_EQ(logged(from), 0);
+  run(nudge, 50);
+  CHECK_EQ(logged(from), 4);
+  CHECK_EQ(at(from + 2).b, v >> 7);
+
+  return hostTestResult();
+}
@@ -0,0 +1,188 @@
+#include "HostTest.h"
+#include "AnalogInput.h"
+#include "AnalogTrace.h"
+#include "MidiCoalescer.h"
+#include <HostHal.h>
+
+// Analog input pipeline and trace capture/replay (user-029): a scripted
+// pedal, piezo and switch are read through readAnalogInputs() on the
+// virtual clock while being captured, then the trace is replayed with the
+// same and with changed settings, dry and through the CC coalescer.
+
+#define POT_PIN 34
+#define PIEZO_PIN 35
+#define SWITCH_PIN 36
+#define RUN_MS 2000
+
+static void setMessage(AnalogInputConfig &cfg, MidiCommandType type,
+                       uint8_t data1) {
+  cfg.enabled = true;
+  cfg.messageCount = 1;
+  ActionMessage &m = cfg.messages[0];
+  m.type = type;
+  m.channel = 1;
+  m.data1 = data1;
+  m.minInput = 0;
+  m.maxInput = 100;
+  m.minOut = 0;
+  m.maxOut = 127;
+}
+
+// Pot: sweep up over the first second, then rest at 3000 with +-3 counts
+// of noise. Piezo: hits at 500 ms, 510 ms (same peak scan) and 1500 ms.
+// Switch: pressed 700-1200 ms.
+static void setInputs(unsigned long t) {
+  hostSetAnalog(POT_PIN, t < 1000 ? t * 3 : 3000 + (int)(t % 7) - 3);
+  bool hit = (t >= 500 && t < 505) || (t >= 510 && t < 515) ||
+             (t >= 1500 && t < 1505);
+  hostSetAnalog(PIEZO_PIN, hit ? 3000 : 20);
+  hostSetAnalog(SWITCH_PIN, t >= 700 && t < 1200 ? 4095 : 0);
+}
+
+static int countKind(size_t from, HostMidiKind kind) {
+  int n = 0;
+  for (size_t i = from; i < hostMidiLog.size(); i++)
+    n += hostMidiLog[i].kind == kind;
+  return n;
+}
+
+// Value of the last CC n logged since from (-1 = none)
+static int lastCC(size_t from, uint8_t n) {
+  int v = -1;
+  for (size_t i = from; i < hostMidiLog.size(); i++) {
+    if (hostMidiLog[i].kind == HOST_MIDI_CC && hostMidiLog[i].a == n)
+      v = hostMidiLog[i].b;
+  }
+  return v;
+}
+
+int main() {
+  hostFsReset();
+  hostSetMillis(10000);
+  AnalogInputConfig &pot = analogInputs[0];
+  AnalogInputConfig &piezo = analogInputs[1];
+  AnalogInputConfig &sw = analogInputs[2];
+  pot.pin = POT_PIN;
+  setMessage(pot, CC, 7);
+  piezo.pin = PIEZO_PIN;
+  piezo.inputMode = AIN_MODE_PIEZO;
+  setMessage(piezo, NOTE_ON, 38);
+  sw.pin = SWITCH_PIN;
+  sw.inputMode = AIN_MODE_SWITCH;
+  setMessage(sw, CC, 80);
+  setInputs(0);
+  setupAnalogInputs();
+
+  // Live run, captured
+  CHECK(startAnalogCapture(0x7, RUN_MS + 100));
+  uint32_t emitStart = analogEmitCount;
+  size_t logStart = hostMidiLog.size();
+  for (unsigned long t = 0; t < RUN_MS; t++) {
+    setInputs(t);
+    readAnalogInputs();
+    flushMidiCoalescer();
+    hostAdvanceMillis(1);
+  }
+  stopAnalogCapture();
+  uint32_t liveEmits = analogEmitCount - emitStart;
+
+  CHECK_EQ(countKind(logStart, HOST_MIDI_NOTE_ON), 4); // 2 hits, on + off
+  int swCC = 0, lastPot = lastCC(logStart, 7);
+  for (size_t i = logStart; i < hostMidiLog.size(); i++) {
+    const HostMidiEvent &e = hostMidiLog[i];
+    if (e.kind == HOST_MIDI_CC && e.a == 80)
+      swCC++;
+  }
+  CHECK_EQ(swCC, 2); // Press and release
+  // The resting value reached the wire (within the hysteresis)
+  CHECK(abs(lastPot - 3000 * 127 / 4095) <= DEFAULT_HYSTERESIS);
+
+  // Trace file: header plus one record per input per read interval
+  std::vector<uint8_t> *trace = hostFsFile(AIN_TRACE_FILE);
+  CHECK(trace != nullptr);
+  if (!trace)
+    return hostTestResult();
+  AnalogTraceHeader hdr;
+  memcpy(&hdr, trace->data(), sizeof(hdr));
+  CHECK_EQ(hdr.magic, AIN_TRACE_MAGIC);
+  CHECK_EQ(hdr.inputMask, 0x7);
+  size_t records = (trace->size() - sizeof(hdr)) / sizeof(AnalogTraceRecord);
+  CHECK_EQ(records, 3 * RUN_MS / ANALOG_READ_INTERVAL_MS);
+
+  // Dry replay with the same settings reproduces the live run exactly and
+  // sends nothing
+  AnalogReplayResult res;
+  size_t logBefore = hostMidiLog.size();
+  CHECK(replayAnalogTrace(false, res));
+  CHECK_EQ(res.samples, records);
+  CHECK_EQ(res.emitted, liveEmits);
+  CHECK_EQ(hostMidiLog.size(), logBefore);
+  CHECK_EQ(res.durationMs, RUN_MS - ANALOG_READ_INTERVAL_MS);
+  CHECK(res.tailLatencyMs < 300);
+  printf("replay: %u samples, %u emitted, tail %u ms\n", res.samples,
+         res.emitted, res.tailLatencyMs);
+
+  // Replay is deterministic
+  AnalogReplayResult again;
+  CHECK(replayAnalogTrace(false, again));
+  CHECK_EQ(again.emitted, res.emitted);
+
+  // Without hysteresis the resting noise gets through
+  pot.hysteresis = 0;
+  AnalogReplayResult noisy;
+  CHECK(replayAnalogTrace(false, noisy));
+  CHECK(noisy.emitted > res.emitted);
+  pot.hysteresis = DEFAULT_HYSTERESIS;
+
+  // A piezo mask longer than the gap swallows the hit at 1500 ms
+  piezo.piezoMaskTime = 1200;
+  AnalogReplayResult masked;
+  CHECK(replayAnalogTrace(false, masked));
+  CHECK_EQ(masked.emitted, res.emitted - 1);
+
+  // Replay with MIDI sends the piezo notes again, and the pot goes through
+  // the coalescer on the trace clock: its resting value reaches the wire
+  // within one rate-limit interval of being queued
+  logBefore = hostMidiLog.size();
+  piezo.piezoMaskTime = 30;
+  CHECK(replayAnalogTrace(true, res));
+  CHECK_EQ(countKind(logBefore, HOST_MIDI_NOTE_ON), 4);
+  CHECK_EQ(lastCC(logBefore, 7), lastPot);
+  CHECK(res.sent > 0);
+  CHECK(res.wireTailMs <= 1000u / ccMaxRateHz);
+  printf("MIDI replay at %d Hz: %u sent, wire tail %u ms\n", ccMaxRateHz,
+         res.sent, res.wireTailMs);
+
+  // At 10 Hz most of the sweep is coalesced away; the end still lands
+  ccMaxRateHz = 10;
+  logBefore = hostMidiLog.size();
+  AnalogReplayResult slow;
+  CHECK(replayAnalogTrace(true, slow));
+  CHECK_EQ(lastCC(logBefore, 7), lastPot);
+  CHECK(slow.sent < res.sent);
+  CHECK(slow.sent <= slow.durationMs / 100 + 1);
+  CHECK(slow.wireTailMs <= 100);
+  printf("MIDI replay at 10 Hz: %u sent, wire tail %u ms\n", slow.sent,
+         slow.wireTailMs);
+  ccMaxRateHz = DEFAULT_CC_MAX_RATE_HZ;
+
+  // A reconnect forgets what the old receiver had: the same value goes
+  // out again, a CC14 with its MSB
+  hostAdvanceMillis(1000);
+  logBefore = hostMidiLog.size();
+  queueMidiCC14(1, 2, 5000);
+  CHECK_EQ(hostMidiLog.size() - logBefore, 2); // MSB + LSB
+  hostAdvanceMillis(1000);
+  queueMidiCC14(1, 2, 5000);
+  CHECK_EQ(hostMidiLog.size() - logBefore, 2); // Already on the wire
+  hostMidiLinkUp = false;
+  resetMidiCoalescer(MIDI_OUT_SPM);
+  hostMidiLinkUp = true;
+  resetMidiCoalescer(MIDI_OUT_SPM);
+  queueMidiCC14(1, 2, 5000);
+  CHECK_EQ(hostMidiLog.size() - logBefore, 4);
+  CHECK_EQ(hostMidiLog[logBefore + 2].a, 2);
+  CHECK_EQ(hostMidiLog[logBefore + 3].a, 34);
+
+  return hostTestResult();
+}
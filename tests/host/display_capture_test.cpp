@@ -0,0 +1,105 @@
+#include "HostTest.h"
+#include "DisplayCapture.h"
+#include "Globals.h"
+#include "Storage.h"
+#include "UI_Display.h"
+#include <HostHal.h>
+#include <vector>
+
+// Display capture (user-036): every screen on every display type and
+// rotation, rendered by the real UI code and compared byte for byte with
+// the PPMs in golden/. CHOCO_UPDATE_GOLDEN=1 rewrites the goldens; a
+// mismatch writes the rendered image to the build directory.
+
+static std::vector<uint8_t> captured;
+
+static void sink(const uint8_t *rgb, size_t len) {
+  captured.insert(captured.end(), rgb, rgb + len);
+}
+
+static bool readFile(const std::string &path, std::vector<uint8_t> *out) {
+  FILE *f = fopen(path.c_str(), "rb");
+  if (!f)
+    return false;
+  uint8_t buf[4096];
+  size_t n;
+  out->clear();
+  while ((n = fread(buf, 1, sizeof(buf), f)) > 0)
+    out->insert(out->end(), buf, buf + n);
+  fclose(f);
+  return true;
+}
+
+static bool writeFile(const std::string &path, const std::vector<uint8_t> &v) {
+  FILE *f = fopen(path.c_str(), "wb");
+  if (!f)
+    return false;
+  bool ok = fwrite(v.data(), 1, v.size(), f) == v.size();
+  return fclose(f) == 0 && ok;
+}
+
+static const struct {
+  OledType type;
+  const char *name;
+  int w, h; // Rotation 0
+} displays[] = {{OLED_128X64, "oled64", 128, 64},
+                {OLED_128X32, "oled32", 128, 32},
+                {TFT_128X128, "tft128", 128, 128},
+                {TFT_128X160, "tft160", 128, 160}};
+
+int main() {
+  bool update = getenv("CHOCO_UPDATE_GOLDEN") != nullptr;
+  hostFsReset();
+  loadPresets(); // Empty flash: factory presets
+
+  int checked = 0;
+  for (const auto &d : displays) {
+    for (uint8_t rot = 0; rot < 4; rot++) {
+      oledConfig.type = d.type;
+      oledConfig.rotation = rot;
+      initDisplayHardware();
+      CHECK(displayPtr != nullptr);
+      if (!displayPtr)
+        continue;
+      bool swap = rot & 1;
+      CHECK_EQ(displayPtr->width(), swap ? d.h : d.w);
+      CHECK_EQ(displayPtr->height(), swap ? d.w : d.h);
+
+      for (int s = CAPTURE_MAIN; s < CAPTURE_SCREEN_COUNT; s++) {
+        CaptureScreen screen = (CaptureScreen)s;
+        char name[64];
+        snprintf(name, sizeof(name), "%s_r%d_%s.ppm", d.name, rot,
+                 captureScreenName(screen));
+        captured.clear();
+        DisplayProfile profile;
+        CHECK(captureDisplay(screen, sink, &profile));
+        CHECK(profile.pixels > 0);
+        CHECK_EQ(editMenuState, EDIT_NONE); // Edit capture leaves no trace
+
+        std::string golden = std::string("golden/") + name;
+        if (update) {
+          CHECK(writeFile(golden, captured));
+          continue;
+        }
+        std::vector<uint8_t> want;
+        if (!readFile(golden, &want)) {
+          printf("%s: missing (run with CHOCO_UPDATE_GOLDEN=1)\n",
+                 golden.c_str());
+          CHECK(false);
+          continue;
+        }
+        if (want != captured) {
+          std::string actual = std::string(HOST_TEST_OUTPUT_DIR "/") + name;
+          writeFile(actual, captured);
+          printf("%s: differs, rendered image in %s\n", golden.c_str(),
+                 actual.c_str());
+          CHECK(false);
+        }
+        checked++;
+      }
+    }
+  }
+  if (!update)
+    CHECK_EQ(checked, 4 * 4 * (CAPTURE_SCREEN_COUNT - CAPTURE_MAIN));
+  return hostTestResult();
+}
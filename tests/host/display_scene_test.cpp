@@ -0,0 +1,86 @@
+#include "HostTest.h"
+#include "DisplayScene.h"
+#include "Globals.h"
+#include "Storage.h"
+#include "TftFrame.h"
+#include "UI_Display.h"
+#include <Adafruit_ST7735.h>
+#include <HostHal.h>
+#include <vector>
+
+// Retained TFT main screen (user-031): pixels pushed to the panel for
+// typical events, against a full repaint. Runs the scene path (no palette
+// frame: the heap is set too low for it) with band rendering.
+
+#define BATTERY_PIN 35
+
+static Adafruit_SPITFT *panel() {
+  return static_cast<Adafruit_SPITFT *>(displayPtr);
+}
+
+// Pixels the next main screen frame pushes
+static uint32_t frame() {
+  uint32_t before = panel()->pixelsWritten;
+  displayOLED();
+  return panel()->pixelsWritten - before;
+}
+
+int main() {
+  hostFsReset();
+  loadPresets(); // Factory presets
+  hostFreeHeap = TFT_FRAME_MIN_FREE_HEAP; // No room for the palette frame
+  oledConfig.type = TFT_128X160;
+  oledConfig.rotation = 0;
+  oledConfig.main.showBattery = true;
+  systemConfig.batteryAdcPin = BATTERY_PIN;
+  batteryAdcMin = 1000;
+  batteryAdcMax = 3000;
+  hostSetAnalog(BATTERY_PIN, 2500);
+  hostSetMillis(100000);
+  initDisplayHardware();
+  CHECK(!tftFrameActive());
+  CHECK(sceneHasBandBuffer());
+
+  uint32_t full = frame(); // First frame paints everything
+  CHECK_EQ(sceneStats.fullRepaints, 1);
+  CHECK(full >= 128 * 160);
+  CHECK_EQ(frame(), 0); // Nothing changed
+
+  // Toggle: LED state only, nothing on screen moves
+  ledToggleState[1] = !ledToggleState[1];
+  uint32_t toggle = frame();
+
+  currentBPM = 121.5f;
+  uint32_t bpm = frame();
+
+  hostSetAnalog(BATTERY_PIN, 2300);
+  hostAdvanceMillis(5000);
+  uint32_t battery = frame();
+
+  currentPreset = 1;
+  uint32_t preset = frame();
+
+  // A full repaint must not change what the partial frames left on screen
+  std::vector<uint16_t> partial;
+  for (int y = 0; y < 160; y++)
+    for (int x = 0; x < 128; x++)
+      partial.push_back(panel()->getPixel(x, y));
+  sceneInvalidate();
+  uint32_t repaint = frame();
+  size_t differ = 0;
+  for (int y = 0; y < 160; y++)
+    for (int x = 0; x < 128; x++)
+      differ += panel()->getPixel(x, y) != partial[y * 128 + x];
+  CHECK_EQ(differ, 0);
+
+  printf("pixels pushed: full %u, toggle %u, BPM %u, battery %u, preset %u, "
+         "repaint %u\n",
+         full, toggle, bpm, battery, preset, repaint);
+  CHECK_EQ(toggle, 0);
+  CHECK(bpm > 0 && bpm < full / 10);
+  CHECK(battery > 0 && battery < full / 20);
+  CHECK(preset > 0 && preset < full / 4);
+  CHECK_EQ(repaint, full);
+  CHECK_EQ(sceneStats.fullRepaints, 2);
+  return hostTestResult();
+}
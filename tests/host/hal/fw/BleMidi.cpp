@@ -0,0 +1,63 @@
+#include "BleMidi.h"
+#include "Globals.h"
+#include <HostHal.h>
+
+// ============================================
+// BLE MIDI FAKE
+// Stands in for BleMidi.cpp: one always-present SPM link (hostMidiLinkUp)
+// and every message appended to hostMidiLog instead of going on air.
+// ============================================
+
+std::vector<HostMidiEvent> hostMidiLog;
+bool hostMidiLinkUp = true;
+
+BLEAdvertisedDevice *myDevice = nullptr;
+BLEClient *pClient = nullptr;
+BLERemoteCharacteristic *pRemoteCharacteristic = nullptr;
+bool doConnect = false;
+bool clientConnected = false;
+bool doScan = false;
+bool bleConfigMode = false;
+BLEServer *pServer = nullptr;
+BLECharacteristic *pServerMidiCharacteristic = nullptr;
+bool serverConnected = false;
+
+static void logMidi(HostMidiKind kind, uint8_t ch, uint16_t a, uint16_t b,
+                    const uint8_t *data = nullptr) {
+  hostMidiLog.push_back({kind, ch, a, b, (uint64_t)micros(), data});
+}
+
+void sendMidiNoteOn(byte ch, byte n, byte v) {
+  logMidi(HOST_MIDI_NOTE_ON, ch, n, v);
+}
+void sendMidiNoteOff(byte ch, byte n, byte v) {
+  logMidi(HOST_MIDI_NOTE_ON, ch, n, 0);
+}
+void sendMidiCC(byte ch, byte n, byte v) { logMidi(HOST_MIDI_CC, ch, n, v); }
+void sendMidiPC(byte ch, byte n) { logMidi(HOST_MIDI_PC, ch, n, 0); }
+void sendMidiCC14(byte ch, byte n, uint16_t v, bool sendMsb) {
+  logMidi(HOST_MIDI_CC14, ch, n, v);
+}
+void sendMidiNRPN(byte ch, uint16_t param, uint16_t v) {
+  logMidi(HOST_MIDI_NRPN, ch, param, v);
+}
+
+bool sendSysexFramed(const uint8_t *blePacket, size_t length) {
+  if (length <= 2 || !hostMidiLinkUp)
+    return false;
+  logMidi(HOST_MIDI_SYSEX, 0, length, 0, blePacket);
+  return true;
+}
+
+bool isMidiOutConnected(MidiTransport t) {
+  return t == MIDI_OUT_SPM && hostMidiLinkUp;
+}
+
+// The coalescer's flush - each pair is logged as a plain CC
+void sendControlChangesTo(MidiTransport t, byte ch, const uint8_t *ccPairs,
+                          uint8_t pairCount) {
+  for (uint8_t i = 0; i < pairCount; i++)
+    logMidi(HOST_MIDI_CC, ch, ccPairs[i * 2], ccPairs[i * 2 + 1]);
+}
+
+void requestPresetState() {}
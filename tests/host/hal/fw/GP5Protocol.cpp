@@ -0,0 +1,4 @@
+#include "GP5Protocol.h"
+
+// GP5Protocol.cpp talks to the BLE client directly; nothing to request here
+void gp5_request_current_preset() {}
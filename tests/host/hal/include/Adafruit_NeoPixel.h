@@ -0,0 +1,43 @@
+#ifndef HOST_ADAFRUIT_NEOPIXEL_H
+#define HOST_ADAFRUIT_NEOPIXEL_H
+
+#include <Arduino.h>
+
+#define NEO_GRB 0x52
+#define NEO_RGB 0x06
+#define NEO_KHZ800 0x0000
+typedef uint16_t neoPixelType;
+
+// Pixels are stored as 0x00RRGGBB; show() counts frames
+class Adafruit_NeoPixel {
+public:
+  Adafruit_NeoPixel(uint16_t n, int16_t pin = 6,
+                    neoPixelType type = NEO_GRB + NEO_KHZ800);
+  Adafruit_NeoPixel();
+  ~Adafruit_NeoPixel();
+  void begin() {}
+  void show() { shows++; }
+  void setPin(int16_t p) {}
+  void setPixelColor(uint16_t n, uint8_t r, uint8_t g, uint8_t b);
+  void setPixelColor(uint16_t n, uint32_t c);
+  void fill(uint32_t c = 0, uint16_t first = 0, uint16_t count = 0);
+  void setBrightness(uint8_t b) { brightness = b; }
+  void clear() { fill(0); }
+  void updateLength(uint16_t n);
+  void updateType(neoPixelType t) {}
+  bool canShow() { return true; }
+  uint8_t getBrightness() const { return brightness; }
+  uint16_t numPixels() const { return count; }
+  uint32_t getPixelColor(uint16_t n) const;
+  static uint32_t Color(uint8_t r, uint8_t g, uint8_t b) {
+    return ((uint32_t)r << 16) | ((uint32_t)g << 8) | b;
+  }
+  uint32_t shows = 0;
+
+private:
+  uint32_t *pixels = nullptr;
+  uint16_t count = 0;
+  uint8_t brightness = 0;
+};
+
+#endif
@@ -0,0 +1,26 @@
+#ifndef HOST_ADAFRUIT_SPITFT_H
+#define HOST_ADAFRUIT_SPITFT_H
+
+#include <Adafruit_GFX.h>
+#include <SPI.h>
+
+// Panel memory is kept in RAM (RGB565, panel orientation) so tests can
+// read back what was drawn
+class Adafruit_SPITFT : public Adafruit_GFX {
+public:
+  Adafruit_SPITFT(uint16_t w, uint16_t h);
+  ~Adafruit_SPITFT();
+  void drawPixel(int16_t x, int16_t y, uint16_t color) override;
+  void drawRGBBitmap(int16_t x, int16_t y, uint16_t *pcolors, int16_t w,
+                     int16_t h);
+  static uint16_t color565(uint8_t r, uint8_t g, uint8_t b) {
+    return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
+  }
+  uint16_t getPixel(int16_t x, int16_t y) const; // Rotated coordinates
+  uint32_t pixelsWritten = 0; // Pixels that would have crossed the SPI bus
+
+protected:
+  uint16_t *panel;
+};
+
+#endif
@@ -0,0 +1,34 @@
+#ifndef HOST_ADAFRUIT_SSD1306_H
+#define HOST_ADAFRUIT_SSD1306_H
+
+#include <Adafruit_GFX.h>
+#include <Wire.h>
+
+#define SSD1306_BLACK 0
+#define SSD1306_WHITE 1
+#define SSD1306_INVERSE 2
+#define SSD1306_SWITCHCAPVCC 0x02
+
+// Page-ordered 1-bit buffer like the real driver; display() counts frames
+class Adafruit_SSD1306 : public Adafruit_GFX {
+public:
+  Adafruit_SSD1306(uint8_t w, uint8_t h, TwoWire *twi = &Wire,
+                   int8_t rst_pin = -1, uint32_t clkDuring = 400000UL,
+                   uint32_t clkAfter = 100000UL);
+  ~Adafruit_SSD1306();
+  bool begin(uint8_t switchvcc = SSD1306_SWITCHCAPVCC, uint8_t i2caddr = 0,
+             bool reset = true, bool periphBegin = true);
+  void display() { displays++; }
+  void clearDisplay();
+  void dim(bool dim) {}
+  void drawPixel(int16_t x, int16_t y, uint16_t color) override;
+  void ssd1306_command(uint8_t c) {}
+  uint8_t *getBuffer() { return buffer; }
+  bool getPixel(int16_t x, int16_t y);
+  uint32_t displays = 0;
+
+private:
+  uint8_t *buffer = nullptr;
+};
+
+#endif
@@ -0,0 +1,29 @@
+#ifndef HOST_ADAFRUIT_ST7735_H
+#define HOST_ADAFRUIT_ST7735_H
+
+#include <Adafruit_SPITFT.h>
+
+#define ST7735_BLACK 0x0000
+#define ST7735_WHITE 0xFFFF
+#define ST7735_RED 0xF800
+#define ST7735_GREEN 0x07E0
+#define ST7735_BLUE 0x001F
+#define ST7735_YELLOW 0xFFE0
+#define ST7735_CYAN 0x07FF
+#define ST7735_MAGENTA 0xF81F
+#define ST7735_ORANGE 0xFC00
+#define INITR_GREENTAB 0x00
+#define INITR_REDTAB 0x01
+#define INITR_BLACKTAB 0x02
+#define INITR_144GREENTAB 0x01
+#define INITR_MINI160x80 0x04
+
+class Adafruit_ST7735 : public Adafruit_SPITFT {
+public:
+  Adafruit_ST7735(int8_t cs, int8_t dc, int8_t rst);
+  Adafruit_ST7735(int8_t cs, int8_t dc, int8_t mosi, int8_t sclk, int8_t rst);
+  Adafruit_ST7735(SPIClass *spiClass, int8_t cs, int8_t dc, int8_t rst);
+  void initR(uint8_t options = INITR_GREENTAB);
+};
+
+#endif
@@ -0,0 +1,228 @@
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+// ============================================
+// HOST ARDUINO CORE
+// Just enough of the ESP32 Arduino core (and FreeRTOS) for the firmware
+// sources to compile and run on Linux. Time comes from a virtual clock
+// (HostHal.h), tasks are never created (callers take their inline
+// fallback) and Serial output is dropped unless CHOCO_HOST_SERIAL is set.
+// ============================================
+
+#include <algorithm>
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define PROGMEM
+#define pgm_read_byte(p) (*(const uint8_t *)(p))
+#define pgm_read_word(p) (*(const uint16_t *)(p))
+#define pgm_read_dword(p) (*(const uint32_t *)(p))
+#define F(x) x
+#define IRAM_ATTR
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 1
+#define OUTPUT 3
+#define INPUT_PULLUP 5
+#define OUTPUT_OPEN_DRAIN 0x12
+#define HEX 16
+#define DEC 10
+#define ADC_11db 3
+
+template <class T, class L, class H>
+auto constrain(T a, L l, H h) -> decltype(a + l + h) {
+  return a < l ? l : (a > h ? h : a);
+}
+using std::max;
+using std::min;
+
+long map(long x, long inMin, long inMax, long outMin, long outMax);
+unsigned long millis();
+unsigned long micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield();
+int analogRead(uint8_t pin);
+void analogSetAttenuation(int atten);
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+long random(long max);
+long random(long min, long max);
+
+class String {
+public:
+  String(const char *s = "") : s(s ? s : "") {}
+  String(const std::string &v) : s(v) {}
+  String(char c) : s(1, c) {}
+  String(int v, int base = DEC) : s(fmt(v, base)) {}
+  String(unsigned int v, int base = DEC) : s(fmt(v, base)) {}
+  String(long v, int base = DEC) : s(fmt(v, base)) {}
+  String(unsigned long v, int base = DEC) : s(fmt(v, base)) {}
+  String(uint8_t v, int base) : s(fmt(v, base)) {}
+  String(float v, int digits = 2);
+  String(double v, int digits = 2);
+
+  const char *c_str() const { return s.c_str(); }
+  unsigned int length() const { return s.size(); }
+  bool isEmpty() const { return s.empty(); }
+  void reserve(unsigned int n) { s.reserve(n); }
+  char charAt(unsigned int i) const { return i < s.size() ? s[i] : 0; }
+  char operator[](unsigned int i) const { return charAt(i); }
+
+  String &operator+=(const String &o) {
+    s += o.s;
+    return *this;
+  }
+  String &operator+=(const char *o) {
+    s += o;
+    return *this;
+  }
+  String &operator+=(char c) {
+    s += c;
+    return *this;
+  }
+  friend String operator+(const String &a, const String &b) {
+    return String(a.s + b.s);
+  }
+  friend String operator+(const String &a, const char *b) {
+    return String(a.s + b);
+  }
+  friend String operator+(const char *a, const String &b) {
+    return String(a + b.s);
+  }
+  bool operator==(const String &o) const { return s == o.s; }
+  bool operator==(const char *o) const { return s == o; }
+  bool operator!=(const String &o) const { return s != o.s; }
+  bool operator!=(const char *o) const { return s != o; }
+
+  bool startsWith(const String &p) const { return s.rfind(p.s, 0) == 0; }
+  bool endsWith(const String &p) const {
+    return s.size() >= p.s.size() &&
+           s.compare(s.size() - p.s.size(), p.s.size(), p.s) == 0;
+  }
+  String substring(unsigned int from, unsigned int to = ~0u) const;
+  int indexOf(char c, unsigned int from = 0) const;
+  int indexOf(const String &v, unsigned int from = 0) const;
+  long toInt() const { return strtol(s.c_str(), nullptr, 10); }
+  float toFloat() const { return strtof(s.c_str(), nullptr); }
+  void trim();
+  void toUpperCase();
+  void replace(const String &from, const String &to);
+
+private:
+  static std::string fmt(unsigned long v, int base, bool neg = false);
+  static std::string fmt(long v, int base) {
+    return v < 0 && base == DEC ? fmt((unsigned long)-v, base, true)
+                                : fmt((unsigned long)v, base);
+  }
+  static std::string fmt(int v, int base) { return fmt((long)v, base); }
+  static std::string fmt(unsigned int v, int base) {
+    return fmt((unsigned long)v, base);
+  }
+  static std::string fmt(uint8_t v, int base) {
+    return fmt((unsigned long)v, base);
+  }
+  std::string s;
+};
+
+class Print {
+public:
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t *buf, size_t len);
+  size_t write(const char *str) { return write((const uint8_t *)str, strlen(str)); }
+  size_t print(const char *s) { return write(s); }
+  size_t print(const String &s) { return write(s.c_str()); }
+  size_t print(char c) { return write((uint8_t)c); }
+  size_t print(int v, int base = DEC) { return print(String(v, base)); }
+  size_t print(unsigned int v, int base = DEC) { return print(String(v, base)); }
+  size_t print(long v, int base = DEC) { return print(String(v, base)); }
+  size_t print(unsigned long v, int base = DEC) {
+    return print(String(v, base));
+  }
+  size_t print(double v, int digits = 2) { return print(String(v, digits)); }
+  size_t println() { return write("\r\n"); }
+  template <class T> size_t println(const T &v) { return print(v) + println(); }
+  template <class T> size_t println(const T &v, int f) {
+    return print(v, f) + println();
+  }
+  size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3)));
+  virtual ~Print() {}
+};
+
+class Stream : public Print {
+public:
+  virtual int available() { return 0; }
+  virtual int read() { return -1; }
+  virtual int peek() { return -1; }
+  void setTimeout(unsigned long) {}
+};
+
+class HardwareSerial : public Stream {
+public:
+  void begin(unsigned long) {}
+  size_t write(uint8_t c) override;
+  using Print::write;
+  operator bool() const { return true; }
+  void flush() {}
+};
+extern HardwareSerial Serial;
+
+class EspClass {
+public:
+  uint32_t getFreeHeap();
+  uint32_t getMinFreeHeap();
+  uint32_t getMaxAllocHeap();
+  void restart();
+  uint32_t getCycleCount();
+};
+extern EspClass ESP;
+
+// FreeRTOS
+typedef void *TaskHandle_t;
+typedef void *SemaphoreHandle_t;
+typedef void *QueueHandle_t;
+typedef int BaseType_t;
+typedef unsigned UBaseType_t;
+typedef uint32_t TickType_t;
+#define pdTRUE 1
+#define pdFALSE 0
+#define pdPASS 1
+#define pdFAIL 0
+#define portMAX_DELAY 0xffffffff
+#define pdMS_TO_TICKS(x) (x)
+#define portMUX_TYPE int
+#define portMUX_INITIALIZER_UNLOCKED 0
+#define portENTER_CRITICAL(x) ((void)(x))
+#define portEXIT_CRITICAL(x) ((void)(x))
+#define eSetBits 1
+BaseType_t xTaskCreatePinnedToCore(void (*fn)(void *), const char *name,
+                                   uint32_t stack, void *arg,
+                                   UBaseType_t prio, TaskHandle_t *handle,
+                                   BaseType_t core);
+void vTaskDelay(TickType_t ticks);
+uint32_t ulTaskNotifyTake(BaseType_t clear, TickType_t wait);
+void xTaskNotifyGive(TaskHandle_t task);
+TaskHandle_t xTaskGetCurrentTaskHandle();
+SemaphoreHandle_t xSemaphoreCreateMutex();
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t wait);
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem);
+SemaphoreHandle_t xSemaphoreCreateRecursiveMutex();
+BaseType_t xSemaphoreTakeRecursive(SemaphoreHandle_t sem, TickType_t wait);
+BaseType_t xSemaphoreGiveRecursive(SemaphoreHandle_t sem);
+int xPortGetCoreID();
+void *heap_caps_malloc(size_t size, uint32_t caps);
+#define MALLOC_CAP_8BIT 1
+#define MALLOC_CAP_DMA 2
+#define MALLOC_CAP_INTERNAL 4
+
+#endif
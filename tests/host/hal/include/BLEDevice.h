@@ -0,0 +1,12 @@
+#ifndef HOST_BLEDEVICE_H
+#define HOST_BLEDEVICE_H
+
+// Globals.h only needs the BLE handle types; BleMidi.cpp is not built on
+// the host (its functions are faked in hal/Midi.cpp)
+class BLEClient;
+class BLERemoteCharacteristic;
+class BLEAdvertisedDevice;
+class BLEServer;
+class BLECharacteristic;
+
+#endif
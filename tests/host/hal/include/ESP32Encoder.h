@@ -0,0 +1,19 @@
+#ifndef HOST_ESP32ENCODER_H
+#define HOST_ESP32ENCODER_H
+
+#include <Arduino.h>
+
+class ESP32Encoder {
+public:
+  void attachHalfQuad(int a, int b) {}
+  int64_t getCount() { return count; }
+  void setCount(int64_t c) { count = c; }
+  void clearCount() { count = 0; }
+  static void useInternalWeakPullResistors(int) {}
+
+private:
+  int64_t count = 0;
+};
+enum puType { UP, DOWN, NONE };
+
+#endif
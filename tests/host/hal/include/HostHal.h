@@ -0,0 +1,65 @@
+#ifndef HOST_HAL_H
+#define HOST_HAL_H
+
+#include <Arduino.h>
+#include <string>
+#include <vector>
+
+// ============================================
+// HOST HAL CONTROLS
+// Test-side handles on the fakes behind Arduino.h and the library stubs:
+// the virtual clock, ADC/GPIO levels, the in-memory NVS and SPIFFS, and
+// the MIDI messages the firmware sent.
+// ============================================
+
+// Virtual clock - only moves when a test (or delay()) moves it
+void hostSetMicros(uint64_t us);
+void hostAdvanceMicros(uint64_t us);
+inline void hostSetMillis(unsigned long ms) { hostSetMicros((uint64_t)ms * 1000); }
+inline void hostAdvanceMillis(unsigned long ms) {
+  hostAdvanceMicros((uint64_t)ms * 1000);
+}
+
+// analogRead() / digitalRead() results (pins 0-63)
+void hostSetAnalog(uint8_t pin, uint16_t value);
+void hostSetDigital(uint8_t pin, int level);
+
+// ESP.getFreeHeap()
+extern uint32_t hostFreeHeap;
+
+// In-memory NVS (Preferences)
+struct HostNvsStats {
+  uint32_t begins; // Successful begin() calls
+  uint32_t writes; // put*() calls
+};
+extern HostNvsStats hostNvsStats;
+extern bool hostNvsFailBegin; // begin() returns false while set
+uint32_t hostNvsKeyWrites(const char *ns, const char *key);
+bool hostNvsHasKey(const char *ns, const char *key);
+void hostNvsReset(); // Erase everything, zero the counters
+
+// In-memory SPIFFS
+std::vector<uint8_t> *hostFsFile(const char *path); // nullptr = no file
+void hostFsReset();
+
+// MIDI sent through the BleMidi.h functions
+enum HostMidiKind : uint8_t {
+  HOST_MIDI_NOTE_ON,
+  HOST_MIDI_CC,
+  HOST_MIDI_PC,
+  HOST_MIDI_CC14,
+  HOST_MIDI_NRPN,
+  HOST_MIDI_SYSEX
+};
+struct HostMidiEvent {
+  HostMidiKind kind;
+  uint8_t channel;
+  uint16_t a; // Note / controller / program / NRPN parameter / SysEx length
+  uint16_t b; // Velocity / value
+  uint64_t us; // Virtual time of the send
+  const uint8_t *data; // SysEx frame as passed (not copied), else nullptr
+};
+extern std::vector<HostMidiEvent> hostMidiLog;
+extern bool hostMidiLinkUp; // BLE client link state seen by the firmware
+
+#endif
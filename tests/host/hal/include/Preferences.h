@@ -0,0 +1,53 @@
+#ifndef HOST_PREFERENCES_H
+#define HOST_PREFERENCES_H
+
+#include <Arduino.h>
+
+// In-memory NVS (see HostHal.h for the write counters)
+class Preferences {
+public:
+  bool begin(const char *name, bool readOnly = false,
+             const char *partition = NULL);
+  void end();
+  bool clear();
+  bool remove(const char *key);
+  bool isKey(const char *key);
+
+  size_t putChar(const char *key, int8_t v);
+  size_t putUChar(const char *key, uint8_t v);
+  size_t putShort(const char *key, int16_t v);
+  size_t putUShort(const char *key, uint16_t v);
+  size_t putInt(const char *key, int32_t v);
+  size_t putUInt(const char *key, uint32_t v);
+  size_t putLong(const char *key, int32_t v);
+  size_t putULong(const char *key, uint32_t v);
+  size_t putFloat(const char *key, float v);
+  size_t putBool(const char *key, bool v);
+  size_t putString(const char *key, const char *v);
+  size_t putString(const char *key, String v);
+  size_t putBytes(const char *key, const void *v, size_t len);
+
+  int8_t getChar(const char *key, int8_t d = 0);
+  uint8_t getUChar(const char *key, uint8_t d = 0);
+  int16_t getShort(const char *key, int16_t d = 0);
+  uint16_t getUShort(const char *key, uint16_t d = 0);
+  int32_t getInt(const char *key, int32_t d = 0);
+  uint32_t getUInt(const char *key, uint32_t d = 0);
+  int32_t getLong(const char *key, int32_t d = 0);
+  uint32_t getULong(const char *key, uint32_t d = 0);
+  float getFloat(const char *key, float d = NAN);
+  bool getBool(const char *key, bool d = false);
+  size_t getString(const char *key, char *buf, size_t len);
+  String getString(const char *key, String d = String());
+  size_t getBytesLength(const char *key);
+  size_t getBytes(const char *key, void *buf, size_t len);
+  size_t freeEntries();
+
+private:
+  size_t put(const char *key, const void *v, size_t len);
+  bool get(const char *key, void *v, size_t len);
+  std::string ns;
+  bool open = false;
+};
+
+#endif
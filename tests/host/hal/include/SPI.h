@@ -0,0 +1,19 @@
+#ifndef HOST_SPI_H
+#define HOST_SPI_H
+
+#include <Arduino.h>
+
+class SPIClass {
+public:
+  SPIClass(uint8_t bus = 0) {}
+  void begin(int8_t sck = -1, int8_t miso = -1, int8_t mosi = -1,
+             int8_t ss = -1) {}
+  void end() {}
+};
+extern SPIClass SPI;
+
+#define VSPI 3
+#define HSPI 2
+#define FSPI 0
+
+#endif
@@ -0,0 +1,17 @@
+#ifndef HOST_SPIFFS_H
+#define HOST_SPIFFS_H
+
+#include <FS.h>
+
+class SPIFFSFS : public fs::FS {
+public:
+  bool begin(bool formatOnFail = false, const char *basePath = "/spiffs",
+             uint8_t maxOpenFiles = 10, const char *label = NULL);
+  bool format();
+  size_t totalBytes();
+  size_t usedBytes();
+  void end() {}
+};
+extern SPIFFSFS SPIFFS;
+
+#endif
@@ -0,0 +1,12 @@
+#ifndef HOST_WEBSERVER_H
+#define HOST_WEBSERVER_H
+
+#include <WiFi.h>
+
+// Only constructed (Globals.cpp); WebInterface.cpp is not built on the host
+class WebServer {
+public:
+  WebServer(int port = 80) {}
+};
+
+#endif
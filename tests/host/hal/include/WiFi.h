@@ -0,0 +1,9 @@
+#ifndef HOST_WIFI_H
+#define HOST_WIFI_H
+
+#include <Arduino.h>
+
+#define WIFI_AP 2
+#define WIFI_OFF 0
+
+#endif
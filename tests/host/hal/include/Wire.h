@@ -0,0 +1,25 @@
+#ifndef HOST_WIRE_H
+#define HOST_WIRE_H
+
+#include <Arduino.h>
+
+// No device answers: transmissions are accepted and dropped
+class TwoWire : public Stream {
+public:
+  bool begin(int sda = -1, int scl = -1, uint32_t freq = 0);
+  bool end() { return true; }
+  void setClock(uint32_t hz) { clock = hz; }
+  uint32_t getClock() { return clock; }
+  void beginTransmission(uint8_t addr) {}
+  uint8_t endTransmission(bool sendStop = true) { return 0; }
+  size_t write(uint8_t) override { return 1; }
+  size_t write(const uint8_t *buf, size_t len) override { return len; }
+  uint8_t requestFrom(uint8_t addr, uint8_t len) { return 0; }
+  void setTimeOut(uint16_t ms) {}
+
+private:
+  uint32_t clock = 100000;
+};
+extern TwoWire Wire;
+
+#endif
@@ -0,0 +1,182 @@
+#include <Arduino.h>
+#include <HostHal.h>
+#include <stdarg.h>
+
+// ============================================
+// CLOCK, GPIO, ADC
+// ============================================
+
+static uint64_t nowUs = 0;
+static uint16_t adc[64];
+static uint8_t gpio[64];
+
+void hostSetMicros(uint64_t us) { nowUs = us; }
+void hostAdvanceMicros(uint64_t us) { nowUs += us; }
+void hostSetAnalog(uint8_t pin, uint16_t value) { adc[pin & 63] = value; }
+void hostSetDigital(uint8_t pin, int level) { gpio[pin & 63] = level; }
+
+unsigned long millis() { return (unsigned long)(nowUs / 1000); }
+unsigned long micros() { return (unsigned long)nowUs; }
+void delay(uint32_t ms) { nowUs += (uint64_t)ms * 1000; }
+void delayMicroseconds(uint32_t us) { nowUs += us; }
+void yield() {}
+
+long map(long x, long inMin, long inMax, long outMin, long outMax) {
+  return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+int analogRead(uint8_t pin) { return adc[pin & 63]; }
+void analogSetAttenuation(int atten) {}
+void pinMode(uint8_t pin, uint8_t mode) {
+  if (mode == INPUT_PULLUP)
+    gpio[pin & 63] = HIGH;
+}
+void digitalWrite(uint8_t pin, uint8_t value) { gpio[pin & 63] = value; }
+int digitalRead(uint8_t pin) { return gpio[pin & 63]; }
+
+long random(long max) { return max > 0 ? rand() % max : 0; }
+long random(long min, long max) {
+  return max > min ? min + rand() % (max - min) : min;
+}
+
+// ============================================
+// STRING
+// ============================================
+
+std::string String::fmt(unsigned long v, int base, bool neg) {
+  char buf[34];
+  int i = sizeof(buf) - 1;
+  buf[i] = 0;
+  do {
+    int d = v % base;
+    buf[--i] = d < 10 ? '0' + d : 'A' + d - 10;
+    v /= base;
+  } while (v);
+  if (neg)
+    buf[--i] = '-';
+  return &buf[i];
+}
+
+String::String(float v, int digits) : String((double)v, digits) {}
+
+String::String(double v, int digits) {
+  char buf[40];
+  snprintf(buf, sizeof(buf), "%.*f", digits, v);
+  s = buf;
+}
+
+String String::substring(unsigned int from, unsigned int to) const {
+  if (to > s.size())
+    to = s.size();
+  if (from >= to)
+    return String();
+  return String(s.substr(from, to - from));
+}
+
+int String::indexOf(char c, unsigned int from) const {
+  size_t i = s.find(c, from);
+  return i == std::string::npos ? -1 : (int)i;
+}
+
+int String::indexOf(const String &v, unsigned int from) const {
+  size_t i = s.find(v.s, from);
+  return i == std::string::npos ? -1 : (int)i;
+}
+
+void String::trim() {
+  size_t a = s.find_first_not_of(" \t\r\n");
+  size_t b = s.find_last_not_of(" \t\r\n");
+  s = a == std::string::npos ? "" : s.substr(a, b - a + 1);
+}
+
+void String::toUpperCase() {
+  for (char &c : s)
+    c = toupper((unsigned char)c);
+}
+
+void String::replace(const String &from, const String &to) {
+  if (from.s.empty())
+    return;
+  for (size_t i = 0; (i = s.find(from.s, i)) != std::string::npos;
+       i += to.s.size())
+    s.replace(i, from.s.size(), to.s);
+}
+
+// ============================================
+// PRINT, SERIAL, ESP
+// ============================================
+
+size_t Print::write(const uint8_t *buf, size_t len) {
+  for (size_t i = 0; i < len; i++)
+    write(buf[i]);
+  return len;
+}
+
+size_t Print::printf(const char *format, ...) {
+  char small[256];
+  va_list args;
+  va_start(args, format);
+  int n = vsnprintf(small, sizeof(small), format, args);
+  va_end(args);
+  if (n < 0)
+    return 0;
+  if ((size_t)n < sizeof(small))
+    return write((const uint8_t *)small, n);
+  std::string big(n + 1, 0);
+  va_start(args, format);
+  vsnprintf(&big[0], n + 1, format, args);
+  va_end(args);
+  return write((const uint8_t *)big.data(), n);
+}
+
+HardwareSerial Serial;
+
+size_t HardwareSerial::write(uint8_t c) {
+  static const bool echo = getenv("CHOCO_HOST_SERIAL") != nullptr;
+  if (echo)
+    fputc(c, stdout);
+  return 1;
+}
+
+EspClass ESP;
+uint32_t hostFreeHeap = 120000;
+
+uint32_t EspClass::getFreeHeap() { return hostFreeHeap; }
+uint32_t EspClass::getMinFreeHeap() { return hostFreeHeap; }
+uint32_t EspClass::getMaxAllocHeap() { return hostFreeHeap; }
+void EspClass::restart() {}
+uint32_t EspClass::getCycleCount() { return (uint32_t)(nowUs * 240); }
+
+// ============================================
+// FREERTOS
+// Single-threaded: task creation fails so LedTask and DisplayTask run
+// their work inline, and the mutexes are always free.
+// ============================================
+
+BaseType_t xTaskCreatePinnedToCore(void (*fn)(void *), const char *name,
+                                   uint32_t stack, void *arg,
+                                   UBaseType_t prio, TaskHandle_t *handle,
+                                   BaseType_t core) {
+  if (handle)
+    *handle = nullptr;
+  return pdFAIL;
+}
+
+void vTaskDelay(TickType_t ticks) { delay(ticks); }
+uint32_t ulTaskNotifyTake(BaseType_t clear, TickType_t wait) { return 0; }
+void xTaskNotifyGive(TaskHandle_t task) {}
+TaskHandle_t xTaskGetCurrentTaskHandle() { return nullptr; }
+
+static int mutexToken;
+SemaphoreHandle_t xSemaphoreCreateMutex() { return &mutexToken; }
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t wait) {
+  return pdTRUE;
+}
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem) { return pdTRUE; }
+SemaphoreHandle_t xSemaphoreCreateRecursiveMutex() { return &mutexToken; }
+BaseType_t xSemaphoreTakeRecursive(SemaphoreHandle_t sem, TickType_t wait) {
+  return pdTRUE;
+}
+BaseType_t xSemaphoreGiveRecursive(SemaphoreHandle_t sem) { return pdTRUE; }
+int xPortGetCoreID() { return 1; }
+void *heap_caps_malloc(size_t size, uint32_t caps) { return malloc(size); }
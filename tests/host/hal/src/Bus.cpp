@@ -0,0 +1,11 @@
+#include <SPI.h>
+#include <Wire.h>
+
+TwoWire Wire;
+SPIClass SPI;
+
+bool TwoWire::begin(int sda, int scl, uint32_t freq) {
+  if (freq)
+    clock = freq;
+  return true;
+}
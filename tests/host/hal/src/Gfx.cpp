@@ -0,0 +1,711 @@
+#include <Adafruit_GFX.h>
+#include <Adafruit_NeoPixel.h>
+#include <Adafruit_SSD1306.h>
+#include <Adafruit_ST7735.h>
+
+// ============================================
+// CLASSIC FONT (5x7 in a 6x8 cell, columns LSB = top row)
+// Same glyphs as glcdfont.c for ASCII; anything else draws a box.
+// ============================================
+
+static const uint8_t font[95][5] = {
+    {0x00, 0x00, 0x00, 0x00, 0x00}, // space
+    {0x00, 0x00, 0x5F, 0x00, 0x00}, // !
+    {0x00, 0x07, 0x00, 0x07, 0x00}, // "
+    {0x14, 0x7F, 0x14, 0x7F, 0x14}, // #
+    {0x24, 0x2A, 0x7F, 0x2A, 0x12}, // $
+    {0x23, 0x13, 0x08, 0x64, 0x62}, // %
+    {0x36, 0x49, 0x55, 0x22, 0x50}, // &
+    {0x00, 0x05, 0x03, 0x00, 0x00}, // '
+    {0x00, 0x1C, 0x22, 0x41, 0x00}, // (
+    {0x00, 0x41, 0x22, 0x1C, 0x00}, // )
+    {0x08, 0x2A, 0x1C, 0x2A, 0x08}, // *
+    {0x08, 0x08, 0x3E, 0x08, 0x08}, // +
+    {0x00, 0x50, 0x30, 0x00, 0x00}, // ,
+    {0x08, 0x08, 0x08, 0x08, 0x08}, // -
+    {0x00, 0x60, 0x60, 0x00, 0x00}, // .
+    {0x20, 0x10, 0x08, 0x04, 0x02}, // /
+    {0x3E, 0x51, 0x49, 0x45, 0x3E}, // 0
+    {0x00, 0x42, 0x7F, 0x40, 0x00}, // 1
+    {0x42, 0x61, 0x51, 0x49, 0x46}, // 2
+    {0x21, 0x41, 0x45, 0x4B, 0x31}, // 3
+    {0x18, 0x14, 0x12, 0x7F, 0x10}, // 4
+    {0x27, 0x45, 0x45, 0x45, 0x39}, // 5
+    {0x3C, 0x4A, 0x49, 0x49, 0x30}, // 6
+    {0x01, 0x71, 0x09, 0x05, 0x03}, // 7
+    {0x36, 0x49, 0x49, 0x49, 0x36}, // 8
+    {0x06, 0x49, 0x49, 0x29, 0x1E}, // 9
+    {0x00, 0x36, 0x36, 0x00, 0x00}, // :
+    {0x00, 0x56, 0x36, 0x00, 0x00}, // ;
+    {0x00, 0x08, 0x14, 0x22, 0x41}, // <
+    {0x14, 0x14, 0x14, 0x14, 0x14}, // =
+    {0x41, 0x22, 0x14, 0x08, 0x00}, // >
+    {0x02, 0x01, 0x51, 0x09, 0x06}, // ?
+    {0x32, 0x49, 0x79, 0x41, 0x3E}, // @
+    {0x7E, 0x11, 0x11, 0x11, 0x7E}, // A
+    {0x7F, 0x49, 0x49, 0x49, 0x36}, // B
+    {0x3E, 0x41, 0x41, 0x41, 0x22}, // C
+    {0x7F, 0x41, 0x41, 0x22, 0x1C}, // D
+    {0x7F, 0x49, 0x49, 0x49, 0x41}, // E
+    {0x7F, 0x09, 0x09, 0x01, 0x01}, // F
+    {0x3E, 0x41, 0x41, 0x51, 0x32}, // G
+    {0x7F, 0x08, 0x08, 0x08, 0x7F}, // H
+    {0x00, 0x41, 0x7F, 0x41, 0x00}, // I
+    {0x20, 0x40, 0x41, 0x3F, 0x01}, // J
+    {0x7F, 0x08, 0x14, 0x22, 0x41}, // K
+    {0x7F, 0x40, 0x40, 0x40, 0x40}, // L
+    {0x7F, 0x02, 0x04, 0x02, 0x7F}, // M
+    {0x7F, 0x04, 0x08, 0x10, 0x7F}, // N
+    {0x3E, 0x41, 0x41, 0x41, 0x3E}, // O
+    {0x7F, 0x09, 0x09, 0x09, 0x06}, // P
+    {0x3E, 0x41, 0x51, 0x21, 0x5E}, // Q
+    {0x7F, 0x09, 0x19, 0x29, 0x46}, // R
+    {0x46, 0x49, 0x49, 0x49, 0x31}, // S
+    {0x01, 0x01, 0x7F, 0x01, 0x01}, // T
+    {0x3F, 0x40, 0x40, 0x40, 0x3F}, // U
+    {0x1F, 0x20, 0x40, 0x20, 0x1F}, // V
+    {0x3F, 0x40, 0x38, 0x40, 0x3F}, // W
+    {0x63, 0x14, 0x08, 0x14, 0x63}, // X
+    {0x07, 0x08, 0x70, 0x08, 0x07}, // Y
+    {0x61, 0x51, 0x49, 0x45, 0x43}, // Z
+    {0x00, 0x00, 0x7F, 0x41, 0x41}, // [
+    {0x02, 0x04, 0x08, 0x10, 0x20}, // backslash
+    {0x41, 0x41, 0x7F, 0x00, 0x00}, // ]
+    {0x04, 0x02, 0x01, 0x02, 0x04}, // ^
+    {0x40, 0x40, 0x40, 0x40, 0x40}, // _
+    {0x00, 0x01, 0x02, 0x04, 0x00}, // `
+    {0x20, 0x54, 0x54, 0x54, 0x78}, // a
+    {0x7F, 0x48, 0x44, 0x44, 0x38}, // b
+    {0x38, 0x44, 0x44, 0x44, 0x20}, // c
+    {0x38, 0x44, 0x44, 0x48, 0x7F}, // d
+    {0x38, 0x54, 0x54, 0x54, 0x18}, // e
+    {0x08, 0x7E, 0x09, 0x01, 0x02}, // f
+    {0x08, 0x14, 0x54, 0x54, 0x3C}, // g
+    {0x7F, 0x08, 0x04, 0x04, 0x78}, // h
+    {0x00, 0x44, 0x7D, 0x40, 0x00}, // i
+    {0x20, 0x40, 0x44, 0x3D, 0x00}, // j
+    {0x00, 0x7F, 0x10, 0x28, 0x44}, // k
+    {0x00, 0x41, 0x7F, 0x40, 0x00}, // l
+    {0x7C, 0x04, 0x18, 0x04, 0x78}, // m
+    {0x7C, 0x08, 0x04, 0x04, 0x78}, // n
+    {0x38, 0x44, 0x44, 0x44, 0x38}, // o
+    {0x7C, 0x14, 0x14, 0x14, 0x08}, // p
+    {0x08, 0x14, 0x14, 0x18, 0x7C}, // q
+    {0x7C, 0x08, 0x04, 0x04, 0x08}, // r
+    {0x48, 0x54, 0x54, 0x54, 0x20}, // s
+    {0x04, 0x3F, 0x44, 0x40, 0x20}, // t
+    {0x3C, 0x40, 0x40, 0x20, 0x7C}, // u
+    {0x1C, 0x20, 0x40, 0x20, 0x1C}, // v
+    {0x3C, 0x40, 0x30, 0x40, 0x3C}, // w
+    {0x44, 0x28, 0x10, 0x28, 0x44}, // x
+    {0x0C, 0x50, 0x50, 0x50, 0x3C}, // y
+    {0x44, 0x64, 0x54, 0x4C, 0x44}, // z
+    {0x00, 0x08, 0x36, 0x41, 0x00}, // {
+    {0x00, 0x00, 0x77, 0x00, 0x00}, // |
+    {0x00, 0x41, 0x36, 0x08, 0x00}, // }
+    {0x02, 0x01, 0x02, 0x04, 0x02}, // ~
+};
+static const uint8_t boxGlyph[5] = {0x7F, 0x41, 0x41, 0x41, 0x7F};
+
+static const uint8_t *glyph(unsigned char c) {
+  return c >= 32 && c < 127 ? font[c - 32] : boxGlyph;
+}
+
+// ============================================
+// ADAFRUIT_GFX
+// Ports of the classic Adafruit_GFX routines, so rounding, clipping and
+// text layout match the device pixel for pixel.
+// ============================================
+
+Adafruit_GFX::Adafruit_GFX(int16_t w, int16_t h) : WIDTH(w), HEIGHT(h) {
+  _width = w;
+  _height = h;
+  rotation = 0;
+  cursor_x = cursor_y = 0;
+  textsize_x = textsize_y = 1;
+  textcolor = textbgcolor = 0xFFFF;
+  wrap = true;
+  _cp437 = false;
+}
+
+void Adafruit_GFX::writePixel(int16_t x, int16_t y, uint16_t color) {
+  drawPixel(x, y, color);
+}
+
+void Adafruit_GFX::writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                                 uint16_t color) {
+  fillRect(x, y, w, h, color);
+}
+
+void Adafruit_GFX::writeFastVLine(int16_t x, int16_t y, int16_t h,
+                                  uint16_t color) {
+  drawFastVLine(x, y, h, color);
+}
+
+void Adafruit_GFX::writeFastHLine(int16_t x, int16_t y, int16_t w,
+                                  uint16_t color) {
+  drawFastHLine(x, y, w, color);
+}
+
+void Adafruit_GFX::writeLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                             uint16_t color) {
+  bool steep = abs(y1 - y0) > abs(x1 - x0);
+  if (steep) {
+    std::swap(x0, y0);
+    std::swap(x1, y1);
+  }
+  if (x0 > x1) {
+    std::swap(x0, x1);
+    std::swap(y0, y1);
+  }
+  int16_t dx = x1 - x0, dy = abs(y1 - y0);
+  int16_t err = dx / 2;
+  int16_t ystep = y0 < y1 ? 1 : -1;
+  for (; x0 <= x1; x0++) {
+    if (steep)
+      writePixel(y0, x0, color);
+    else
+      writePixel(x0, y0, color);
+    err -= dy;
+    if (err < 0) {
+      y0 += ystep;
+      err += dx;
+    }
+  }
+}
+
+void Adafruit_GFX::setRotation(uint8_t r) {
+  rotation = r & 3;
+  if (rotation & 1) {
+    _width = HEIGHT;
+    _height = WIDTH;
+  } else {
+    _width = WIDTH;
+    _height = HEIGHT;
+  }
+}
+
+void Adafruit_GFX::drawFastVLine(int16_t x, int16_t y, int16_t h,
+                                 uint16_t color) {
+  writeLine(x, y, x, y + h - 1, color);
+}
+
+void Adafruit_GFX::drawFastHLine(int16_t x, int16_t y, int16_t w,
+                                 uint16_t color) {
+  writeLine(x, y, x + w - 1, y, color);
+}
+
+void Adafruit_GFX::fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                            uint16_t color) {
+  for (int16_t i = x; i < x + w; i++)
+    writeFastVLine(i, y, h, color);
+}
+
+void Adafruit_GFX::fillScreen(uint16_t color) {
+  fillRect(0, 0, _width, _height, color);
+}
+
+void Adafruit_GFX::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                            uint16_t color) {
+  if (x0 == x1) {
+    if (y0 > y1)
+      std::swap(y0, y1);
+    drawFastVLine(x0, y0, y1 - y0 + 1, color);
+  } else if (y0 == y1) {
+    if (x0 > x1)
+      std::swap(x0, x1);
+    drawFastHLine(x0, y0, x1 - x0 + 1, color);
+  } else {
+    writeLine(x0, y0, x1, y1, color);
+  }
+}
+
+void Adafruit_GFX::drawRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                            uint16_t color) {
+  writeFastHLine(x, y, w, color);
+  writeFastHLine(x, y + h - 1, w, color);
+  writeFastVLine(x, y, h, color);
+  writeFastVLine(x + w - 1, y, h, color);
+}
+
+static void circleQuadrants(Adafruit_GFX *g, int16_t x0, int16_t y0, int16_t r,
+                            uint8_t corners, uint16_t color) {
+  int16_t f = 1 - r, ddFx = 1, ddFy = -2 * r, x = 0, y = r;
+  while (x < y) {
+    if (f >= 0) {
+      y--;
+      ddFy += 2;
+      f += ddFy;
+    }
+    x++;
+    ddFx += 2;
+    f += ddFx;
+    if (corners & 0x4) {
+      g->writePixel(x0 + x, y0 + y, color);
+      g->writePixel(x0 + y, y0 + x, color);
+    }
+    if (corners & 0x2) {
+      g->writePixel(x0 + x, y0 - y, color);
+      g->writePixel(x0 + y, y0 - x, color);
+    }
+    if (corners & 0x8) {
+      g->writePixel(x0 - y, y0 + x, color);
+      g->writePixel(x0 - x, y0 + y, color);
+    }
+    if (corners & 0x1) {
+      g->writePixel(x0 - y, y0 - x, color);
+      g->writePixel(x0 - x, y0 - y, color);
+    }
+  }
+}
+
+static void fillCircleHalves(Adafruit_GFX *g, int16_t x0, int16_t y0,
+                             int16_t r, uint8_t corners, int16_t delta,
+                             uint16_t color) {
+  int16_t f = 1 - r, ddFx = 1, ddFy = -2 * r, x = 0, y = r;
+  int16_t px = x, py = y;
+  delta++;
+  while (x < y) {
+    if (f >= 0) {
+      y--;
+      ddFy += 2;
+      f += ddFy;
+    }
+    x++;
+    ddFx += 2;
+    f += ddFx;
+    if (x < y + 1) {
+      if (corners & 1)
+        g->writeFastVLine(x0 + x, y0 - y, 2 * y + delta, color);
+      if (corners & 2)
+        g->writeFastVLine(x0 - x, y0 - y, 2 * y + delta, color);
+    }
+    if (y != py) {
+      if (corners & 1)
+        g->writeFastVLine(x0 + py, y0 - px, 2 * px + delta, color);
+      if (corners & 2)
+        g->writeFastVLine(x0 - py, y0 - px, 2 * px + delta, color);
+      py = y;
+    }
+    px = x;
+  }
+}
+
+void Adafruit_GFX::drawCircle(int16_t x0, int16_t y0, int16_t r,
+                              uint16_t color) {
+  writePixel(x0, y0 + r, color);
+  writePixel(x0, y0 - r, color);
+  writePixel(x0 + r, y0, color);
+  writePixel(x0 - r, y0, color);
+  circleQuadrants(this, x0, y0, r, 0xF, color);
+}
+
+void Adafruit_GFX::fillCircle(int16_t x0, int16_t y0, int16_t r,
+                              uint16_t color) {
+  writeFastVLine(x0, y0 - r, 2 * r + 1, color);
+  fillCircleHalves(this, x0, y0, r, 3, 0, color);
+}
+
+void Adafruit_GFX::drawTriangle(int16_t x0, int16_t y0, int16_t x1,
+                                int16_t y1, int16_t x2, int16_t y2,
+                                uint16_t color) {
+  drawLine(x0, y0, x1, y1, color);
+  drawLine(x1, y1, x2, y2, color);
+  drawLine(x2, y2, x0, y0, color);
+}
+
+void Adafruit_GFX::fillTriangle(int16_t x0, int16_t y0, int16_t x1,
+                                int16_t y1, int16_t x2, int16_t y2,
+                                uint16_t color) {
+  if (y0 > y1) {
+    std::swap(y0, y1);
+    std::swap(x0, x1);
+  }
+  if (y1 > y2) {
+    std::swap(y2, y1);
+    std::swap(x2, x1);
+  }
+  if (y0 > y1) {
+    std::swap(y0, y1);
+    std::swap(x0, x1);
+  }
+  int16_t a, b, y, last;
+  if (y0 == y2) { // All on one line
+    a = b = x0;
+    a = std::min({a, x1, x2});
+    b = std::max({b, x1, x2});
+    writeFastHLine(a, y0, b - a + 1, color);
+    return;
+  }
+  int16_t dx01 = x1 - x0, dy01 = y1 - y0, dx02 = x2 - x0, dy02 = y2 - y0,
+          dx12 = x2 - x1, dy12 = y2 - y1;
+  int32_t sa = 0, sb = 0;
+  last = y1 == y2 ? y1 : y1 - 1;
+  for (y = y0; y <= last; y++) {
+    a = x0 + sa / dy01;
+    b = x0 + sb / dy02;
+    sa += dx01;
+    sb += dx02;
+    if (a > b)
+      std::swap(a, b);
+    writeFastHLine(a, y, b - a + 1, color);
+  }
+  sa = (int32_t)dx12 * (y - y1);
+  sb = (int32_t)dx02 * (y - y0);
+  for (; y <= y2; y++) {
+    a = x1 + sa / dy12;
+    b = x0 + sb / dy02;
+    sa += dx12;
+    sb += dx02;
+    if (a > b)
+      std::swap(a, b);
+    writeFastHLine(a, y, b - a + 1, color);
+  }
+}
+
+void Adafruit_GFX::drawRoundRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                                 int16_t r, uint16_t color) {
+  int16_t maxRadius = std::min(w, h) / 2;
+  if (r > maxRadius)
+    r = maxRadius;
+  writeFastHLine(x + r, y, w - 2 * r, color);
+  writeFastHLine(x + r, y + h - 1, w - 2 * r, color);
+  writeFastVLine(x, y + r, h - 2 * r, color);
+  writeFastVLine(x + w - 1, y + r, h - 2 * r, color);
+  circleQuadrants(this, x + r, y + r, r, 1, color);
+  circleQuadrants(this, x + w - r - 1, y + r, r, 2, color);
+  circleQuadrants(this, x + w - r - 1, y + h - r - 1, r, 4, color);
+  circleQuadrants(this, x + r, y + h - r - 1, r, 8, color);
+}
+
+void Adafruit_GFX::fillRoundRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                                 int16_t r, uint16_t color) {
+  int16_t maxRadius = std::min(w, h) / 2;
+  if (r > maxRadius)
+    r = maxRadius;
+  writeFillRect(x + r, y, w - 2 * r, h, color);
+  fillCircleHalves(this, x + w - r - 1, y + r, r, 1, h - 2 * r - 1, color);
+  fillCircleHalves(this, x + r, y + r, r, 2, h - 2 * r - 1, color);
+}
+
+void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, const uint8_t *bitmap,
+                              int16_t w, int16_t h, uint16_t color) {
+  int16_t byteWidth = (w + 7) / 8;
+  for (int16_t j = 0; j < h; j++)
+    for (int16_t i = 0; i < w; i++)
+      if (bitmap[j * byteWidth + i / 8] & (0x80 >> (i & 7)))
+        writePixel(x + i, y + j, color);
+}
+
+void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, const uint8_t *bitmap,
+                              int16_t w, int16_t h, uint16_t color,
+                              uint16_t bg) {
+  int16_t byteWidth = (w + 7) / 8;
+  for (int16_t j = 0; j < h; j++)
+    for (int16_t i = 0; i < w; i++)
+      writePixel(x + i, y + j,
+                 bitmap[j * byteWidth + i / 8] & (0x80 >> (i & 7)) ? color
+                                                                   : bg);
+}
+
+void Adafruit_GFX::drawRGBBitmap(int16_t x, int16_t y, const uint16_t *bitmap,
+                                 int16_t w, int16_t h) {
+  for (int16_t j = 0; j < h; j++)
+    for (int16_t i = 0; i < w; i++)
+      writePixel(x + i, y + j, bitmap[j * w + i]);
+}
+
+void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char c,
+                            uint16_t color, uint16_t bg, uint8_t size) {
+  drawChar(x, y, c, color, bg, size, size);
+}
+
+void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char c,
+                            uint16_t color, uint16_t bg, uint8_t sizeX,
+                            uint8_t sizeY) {
+  if (x >= _width || y >= _height || x + 6 * sizeX - 1 < 0 ||
+      y + 8 * sizeY - 1 < 0)
+    return;
+  const uint8_t *g = glyph(c);
+  for (int8_t i = 0; i < 5; i++) {
+    uint8_t line = g[i];
+    for (int8_t j = 0; j < 8; j++, line >>= 1) {
+      if (line & 1) {
+        if (sizeX == 1 && sizeY == 1)
+          writePixel(x + i, y + j, color);
+        else
+          writeFillRect(x + i * sizeX, y + j * sizeY, sizeX, sizeY, color);
+      } else if (bg != color) {
+        if (sizeX == 1 && sizeY == 1)
+          writePixel(x + i, y + j, bg);
+        else
+          writeFillRect(x + i * sizeX, y + j * sizeY, sizeX, sizeY, bg);
+      }
+    }
+  }
+  if (bg != color) { // Spacing column
+    if (sizeX == 1 && sizeY == 1)
+      writeFastVLine(x + 5, y, 8, bg);
+    else
+      writeFillRect(x + 5 * sizeX, y, sizeX, 8 * sizeY, bg);
+  }
+}
+
+size_t Adafruit_GFX::write(uint8_t c) {
+  if (c == '\n') {
+    cursor_x = 0;
+    cursor_y += textsize_y * 8;
+  } else if (c != '\r') {
+    if (wrap && cursor_x + textsize_x * 6 > _width) {
+      cursor_x = 0;
+      cursor_y += textsize_y * 8;
+    }
+    drawChar(cursor_x, cursor_y, c, textcolor, textbgcolor, textsize_x,
+             textsize_y);
+    cursor_x += textsize_x * 6;
+  }
+  return 1;
+}
+
+void Adafruit_GFX::setTextSize(uint8_t sx, uint8_t sy) {
+  textsize_x = sx > 0 ? sx : 1;
+  textsize_y = sy > 0 ? sy : 1;
+}
+
+void Adafruit_GFX::charBounds(unsigned char c, int16_t *x, int16_t *y,
+                              int16_t *minx, int16_t *miny, int16_t *maxx,
+                              int16_t *maxy) {
+  if (c == '\n') {
+    *x = 0;
+    *y += textsize_y * 8;
+  } else if (c != '\r') {
+    if (wrap && *x + textsize_x * 6 > _width) {
+      *x = 0;
+      *y += textsize_y * 8;
+    }
+    int16_t x2 = *x + textsize_x * 6 - 1, y2 = *y + textsize_y * 8 - 1;
+    if (x2 > *maxx)
+      *maxx = x2;
+    if (y2 > *maxy)
+      *maxy = y2;
+    if (*x < *minx)
+      *minx = *x;
+    if (*y < *miny)
+      *miny = *y;
+    *x += textsize_x * 6;
+  }
+}
+
+void Adafruit_GFX::getTextBounds(const char *str, int16_t x, int16_t y,
+                                 int16_t *x1, int16_t *y1, uint16_t *w,
+                                 uint16_t *h) {
+  int16_t minx = _width, miny = _height, maxx = -1, maxy = -1;
+  *x1 = x;
+  *y1 = y;
+  *w = *h = 0;
+  uint8_t c;
+  while ((c = *str++))
+    charBounds(c, &x, &y, &minx, &miny, &maxx, &maxy);
+  if (maxx >= minx) {
+    *x1 = minx;
+    *w = maxx - minx + 1;
+  }
+  if (maxy >= miny) {
+    *y1 = miny;
+    *h = maxy - miny + 1;
+  }
+}
+
+void Adafruit_GFX::getTextBounds(const String &str, int16_t x, int16_t y,
+                                 int16_t *x1, int16_t *y1, uint16_t *w,
+                                 uint16_t *h) {
+  getTextBounds(str.c_str(), x, y, x1, y1, w, h);
+}
+
+// Rotated (x, y) to unrotated panel coordinates, false when off screen
+static bool toPanel(int16_t &x, int16_t &y, int16_t width, int16_t height,
+                    uint8_t rotation, int16_t W, int16_t H) {
+  if (x < 0 || y < 0 || x >= width || y >= height)
+    return false;
+  int16_t t;
+  switch (rotation) {
+  case 1:
+    t = x;
+    x = W - 1 - y;
+    y = t;
+    break;
+  case 2:
+    x = W - 1 - x;
+    y = H - 1 - y;
+    break;
+  case 3:
+    t = x;
+    x = y;
+    y = H - 1 - t;
+    break;
+  }
+  return true;
+}
+
+// ============================================
+// GFXCANVAS1
+// ============================================
+
+GFXcanvas1::GFXcanvas1(uint16_t w, uint16_t h) : Adafruit_GFX(w, h) {
+  buffer = (uint8_t *)calloc(((w + 7) / 8) * h, 1);
+}
+
+GFXcanvas1::~GFXcanvas1() { free(buffer); }
+
+void GFXcanvas1::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  if (!buffer || !toPanel(x, y, _width, _height, rotation, WIDTH, HEIGHT))
+    return;
+  uint8_t *p = &buffer[(x / 8) + y * ((WIDTH + 7) / 8)];
+  if (color)
+    *p |= 0x80 >> (x & 7);
+  else
+    *p &= ~(0x80 >> (x & 7));
+}
+
+bool GFXcanvas1::getPixel(int16_t x, int16_t y) const {
+  if (!buffer || !toPanel(x, y, _width, _height, rotation, WIDTH, HEIGHT))
+    return false;
+  return buffer[(x / 8) + y * ((WIDTH + 7) / 8)] & (0x80 >> (x & 7));
+}
+
+void GFXcanvas1::fillScreen(uint16_t color) {
+  if (buffer)
+    memset(buffer, color ? 0xFF : 0x00, ((WIDTH + 7) / 8) * HEIGHT);
+}
+
+// ============================================
+// ADAFRUIT_SSD1306
+// ============================================
+
+Adafruit_SSD1306::Adafruit_SSD1306(uint8_t w, uint8_t h, TwoWire *twi,
+                                   int8_t rst_pin, uint32_t clkDuring,
+                                   uint32_t clkAfter)
+    : Adafruit_GFX(w, h) {}
+
+Adafruit_SSD1306::~Adafruit_SSD1306() { free(buffer); }
+
+bool Adafruit_SSD1306::begin(uint8_t switchvcc, uint8_t i2caddr, bool reset,
+                             bool periphBegin) {
+  if (!buffer)
+    buffer = (uint8_t *)malloc(WIDTH * ((HEIGHT + 7) / 8));
+  if (!buffer)
+    return false;
+  clearDisplay();
+  return true;
+}
+
+void Adafruit_SSD1306::clearDisplay() {
+  if (buffer)
+    memset(buffer, 0, WIDTH * ((HEIGHT + 7) / 8));
+}
+
+void Adafruit_SSD1306::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  if (!buffer || !toPanel(x, y, _width, _height, rotation, WIDTH, HEIGHT))
+    return;
+  uint8_t *p = &buffer[x + (y / 8) * WIDTH];
+  uint8_t bit = 1 << (y & 7);
+  if (color == SSD1306_WHITE)
+    *p |= bit;
+  else if (color == SSD1306_BLACK)
+    *p &= ~bit;
+  else if (color == SSD1306_INVERSE)
+    *p ^= bit;
+}
+
+bool Adafruit_SSD1306::getPixel(int16_t x, int16_t y) {
+  if (!buffer || !toPanel(x, y, _width, _height, rotation, WIDTH, HEIGHT))
+    return false;
+  return buffer[x + (y / 8) * WIDTH] & (1 << (y & 7));
+}
+
+// ============================================
+// ADAFRUIT_SPITFT / ST7735
+// ============================================
+
+Adafruit_SPITFT::Adafruit_SPITFT(uint16_t w, uint16_t h) : Adafruit_GFX(w, h) {
+  panel = (uint16_t *)calloc(w * h, sizeof(uint16_t));
+}
+
+Adafruit_SPITFT::~Adafruit_SPITFT() { free(panel); }
+
+void Adafruit_SPITFT::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  if (toPanel(x, y, _width, _height, rotation, WIDTH, HEIGHT)) {
+    panel[y * WIDTH + x] = color;
+    pixelsWritten++;
+  }
+}
+
+uint16_t Adafruit_SPITFT::getPixel(int16_t x, int16_t y) const {
+  if (!toPanel(x, y, _width, _height, rotation, WIDTH, HEIGHT))
+    return 0;
+  return panel[y * WIDTH + x];
+}
+
+void Adafruit_SPITFT::drawRGBBitmap(int16_t x, int16_t y, uint16_t *pcolors,
+                                    int16_t w, int16_t h) {
+  Adafruit_GFX::drawRGBBitmap(x, y, pcolors, w, h);
+}
+
+Adafruit_ST7735::Adafruit_ST7735(int8_t cs, int8_t dc, int8_t rst)
+    : Adafruit_SPITFT(128, 160) {}
+
+Adafruit_ST7735::Adafruit_ST7735(int8_t cs, int8_t dc, int8_t mosi,
+                                 int8_t sclk, int8_t rst)
+    : Adafruit_SPITFT(128, 160) {}
+
+Adafruit_ST7735::Adafruit_ST7735(SPIClass *spiClass, int8_t cs, int8_t dc,
+                                 int8_t rst)
+    : Adafruit_SPITFT(128, 160) {}
+
+void Adafruit_ST7735::initR(uint8_t options) {
+  HEIGHT = options == INITR_144GREENTAB ? 128 : 160;
+  free(panel);
+  panel = (uint16_t *)calloc(WIDTH * HEIGHT, sizeof(uint16_t));
+  setRotation(0);
+}
+
+// ============================================
+// ADAFRUIT_NEOPIXEL
+// ============================================
+
+Adafruit_NeoPixel::Adafruit_NeoPixel(uint16_t n, int16_t pin,
+                                     neoPixelType type) {
+  updateLength(n);
+}
+
+Adafruit_NeoPixel::Adafruit_NeoPixel() {}
+
+Adafruit_NeoPixel::~Adafruit_NeoPixel() { free(pixels); }
+
+void Adafruit_NeoPixel::updateLength(uint16_t n) {
+  free(pixels);
+  pixels = (uint32_t *)calloc(n ? n : 1, sizeof(uint32_t));
+  count = n;
+}
+
+void Adafruit_NeoPixel::setPixelColor(uint16_t n, uint8_t r, uint8_t g,
+                                      uint8_t b) {
+  setPixelColor(n, Color(r, g, b));
+}
+
+void Adafruit_NeoPixel::setPixelColor(uint16_t n, uint32_t c) {
+  if (n < count)
+    pixels[n] = c & 0xFFFFFF;
+}
+
+void Adafruit_NeoPixel::fill(uint32_t c, uint16_t first, uint16_t n) {
+  if (first >= count)
+    return;
+  uint16_t end = n == 0 || first + n > count ? count : first + n;
+  for (uint16_t i = first; i < end; i++)
+    pixels[i] = c & 0xFFFFFF;
+}
+
+uint32_t Adafruit_NeoPixel::getPixelColor(uint16_t n) const {
+  return n < count ? pixels[n] : 0;
+}
@@ -0,0 +1,152 @@
+#include <HostHal.h>
+#include <Preferences.h>
+#include <map>
+#include <vector>
+
+// ============================================
+// IN-MEMORY NVS
+// Values are kept as raw bytes per namespace/key; getters with the wrong
+// size fall back to their default like the real typed NVS entries do.
+// ============================================
+
+typedef std::map<std::string, std::vector<uint8_t>> NvsSpace;
+static std::map<std::string, NvsSpace> nvs;
+static std::map<std::string, uint32_t> keyWrites;
+
+HostNvsStats hostNvsStats;
+bool hostNvsFailBegin = false;
+
+uint32_t hostNvsKeyWrites(const char *ns, const char *key) {
+  auto it = keyWrites.find(std::string(ns) + "/" + key);
+  return it == keyWrites.end() ? 0 : it->second;
+}
+
+bool hostNvsHasKey(const char *ns, const char *key) {
+  auto s = nvs.find(ns);
+  return s != nvs.end() && s->second.count(key);
+}
+
+void hostNvsReset() {
+  nvs.clear();
+  keyWrites.clear();
+  hostNvsStats = HostNvsStats();
+  hostNvsFailBegin = false;
+}
+
+bool Preferences::begin(const char *name, bool readOnly,
+                        const char *partition) {
+  if (hostNvsFailBegin)
+    return false;
+  ns = name;
+  open = true;
+  hostNvsStats.begins++;
+  return true;
+}
+
+void Preferences::end() { open = false; }
+
+bool Preferences::clear() {
+  if (!open)
+    return false;
+  nvs[ns].clear();
+  return true;
+}
+
+bool Preferences::remove(const char *key) {
+  return open && nvs[ns].erase(key) > 0;
+}
+
+bool Preferences::isKey(const char *key) {
+  return open && nvs[ns].count(key);
+}
+
+size_t Preferences::freeEntries() { return 500; }
+
+size_t Preferences::put(const char *key, const void *v, size_t len) {
+  if (!open)
+    return 0;
+  const uint8_t *p = (const uint8_t *)v;
+  nvs[ns][key].assign(p, p + len);
+  keyWrites[ns + "/" + key]++;
+  hostNvsStats.writes++;
+  return len;
+}
+
+bool Preferences::get(const char *key, void *v, size_t len) {
+  if (!open)
+    return false;
+  auto it = nvs[ns].find(key);
+  if (it == nvs[ns].end() || it->second.size() != len)
+    return false;
+  if (len)
+    memcpy(v, it->second.data(), len);
+  return true;
+}
+
+#define PREFS_TYPE(Name, T)                                                    \
+  size_t Preferences::put##Name(const char *key, T v) {                       \
+    return put(key, &v, sizeof(v));                                            \
+  }                                                                            \
+  T Preferences::get##Name(const char *key, T d) {                             \
+    T v;                                                                       \
+    return get(key, &v, sizeof(v)) ? v : d;                                    \
+  }
+
+PREFS_TYPE(Char, int8_t)
+PREFS_TYPE(UChar, uint8_t)
+PREFS_TYPE(Short, int16_t)
+PREFS_TYPE(UShort, uint16_t)
+PREFS_TYPE(Int, int32_t)
+PREFS_TYPE(UInt, uint32_t)
+PREFS_TYPE(Long, int32_t)
+PREFS_TYPE(ULong, uint32_t)
+PREFS_TYPE(Float, float)
+PREFS_TYPE(Bool, bool)
+
+size_t Preferences::putString(const char *key, const char *v) {
+  return put(key, v, strlen(v) + 1);
+}
+
+size_t Preferences::putString(const char *key, String v) {
+  return putString(key, v.c_str());
+}
+
+size_t Preferences::putBytes(const char *key, const void *v, size_t len) {
+  return put(key, v, len);
+}
+
+size_t Preferences::getString(const char *key, char *buf, size_t len) {
+  if (!open || !nvs[ns].count(key))
+    return 0;
+  const std::vector<uint8_t> &v = nvs[ns][key];
+  if (!buf)
+    return v.size();
+  if (v.size() > len)
+    return 0;
+  if (!v.empty()) // Empty values have no data()
+    memcpy(buf, v.data(), v.size());
+  return v.size();
+}
+
+String Preferences::getString(const char *key, String d) {
+  if (!open || !nvs[ns].count(key))
+    return d;
+  return String((const char *)nvs[ns][key].data());
+}
+
+size_t Preferences::getBytesLength(const char *key) {
+  if (!open || !nvs[ns].count(key))
+    return 0;
+  return nvs[ns][key].size();
+}
+
+size_t Preferences::getBytes(const char *key, void *buf, size_t len) {
+  if (!open || !nvs[ns].count(key))
+    return 0;
+  const std::vector<uint8_t> &v = nvs[ns][key];
+  if (v.size() > len)
+    return 0;
+  if (!v.empty()) // Empty values have no data()
+    memcpy(buf, v.data(), v.size());
+  return v.size();
+}
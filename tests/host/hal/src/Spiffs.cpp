@@ -0,0 +1,117 @@
+#include <HostHal.h>
+#include <SPIFFS.h>
+#include <map>
+
+// ============================================
+// IN-MEMORY SPIFFS
+// Open files share their node with the directory, so a write is visible
+// to later opens straight away (no caching, no flush needed).
+// ============================================
+
+typedef std::shared_ptr<std::vector<uint8_t>> FileNode;
+static std::map<std::string, FileNode> files;
+
+SPIFFSFS SPIFFS;
+
+std::vector<uint8_t> *hostFsFile(const char *path) {
+  auto it = files.find(path);
+  return it == files.end() ? nullptr : it->second.get();
+}
+
+void hostFsReset() { files.clear(); }
+
+namespace fs {
+
+size_t File::write(const uint8_t *buf, size_t len) {
+  if (!data || !writable)
+    return 0;
+  if (len == 0)
+    return 0; // An empty file's data() may be null
+  if (data->size() < pos + len)
+    data->resize(pos + len);
+  memcpy(data->data() + pos, buf, len);
+  pos += len;
+  return len;
+}
+
+int File::available() { return data ? (int)(data->size() - pos) : 0; }
+
+int File::read() {
+  if (!data || pos >= data->size())
+    return -1;
+  return (*data)[pos++];
+}
+
+int File::peek() {
+  if (!data || pos >= data->size())
+    return -1;
+  return (*data)[pos];
+}
+
+size_t File::read(uint8_t *buf, size_t len) {
+  if (!data || pos >= data->size() || len == 0)
+    return 0;
+  size_t n = std::min(len, data->size() - pos);
+  memcpy(buf, data->data() + pos, n);
+  pos += n;
+  return n;
+}
+
+bool File::seek(uint32_t off, SeekMode mode) {
+  if (!data)
+    return false;
+  size_t base = mode == SeekSet ? 0 : (mode == SeekCur ? pos : data->size());
+  if (base + off > data->size())
+    return false;
+  pos = base + off;
+  return true;
+}
+
+File FS::open(const char *path, const char *mode, bool create) {
+  auto it = files.find(path);
+  if (mode[0] == 'r') {
+    if (it == files.end())
+      return File();
+    return File(it->second, path, 0, mode[1] == '+');
+  }
+  if (mode[0] == 'w' || it == files.end()) {
+    FileNode node = std::make_shared<std::vector<uint8_t>>();
+    files[path] = node;
+    return File(node, path, 0, true);
+  }
+  return File(it->second, path, it->second->size(), true); // Append
+}
+
+bool FS::exists(const char *path) { return files.count(path) > 0; }
+
+bool FS::remove(const char *path) { return files.erase(path) > 0; }
+
+bool FS::rename(const char *from, const char *to) {
+  auto it = files.find(from);
+  if (it == files.end())
+    return false;
+  files[to] = it->second;
+  files.erase(from);
+  return true;
+}
+
+} // namespace fs
+
+bool SPIFFSFS::begin(bool formatOnFail, const char *basePath,
+                     uint8_t maxOpenFiles, const char *label) {
+  return true;
+}
+
+bool SPIFFSFS::format() {
+  files.clear();
+  return true;
+}
+
+size_t SPIFFSFS::totalBytes() { return 1441792; }
+
+size_t SPIFFSFS::usedBytes() {
+  size_t n = 0;
+  for (auto &f : files)
+    n += f.second->size();
+  return n;
+}
@@ -0,0 +1,86 @@
+#include "HostTest.h"
+#include "LedAnim.h"
+
+// LED animation engine (user-042) on a virtual clock: beat timing, frame
+// ticks, one-shot expiry, chase position and phase keeping.
+
+#define BASE 0x101010
+
+int main() {
+  // Beat blink at 120 BPM: on for LED_ANIM_BEAT_ON_MS at every beat
+  ledAnimSetTempo(500, 0);
+  ledAnimStart(0, LED_ANIM_BEAT, 0xFF0000, 0, 0, 0);
+  CHECK_EQ(ledAnimColor(0, BASE, 0, 1, 0), 0xFF0000);
+  CHECK_EQ(ledAnimColor(0, BASE, 0, 1, LED_ANIM_BEAT_ON_MS - 1), 0xFF0000);
+  CHECK_EQ(ledAnimColor(0, BASE, 0, 1, LED_ANIM_BEAT_ON_MS), BASE);
+  CHECK_EQ(ledAnimColor(0, BASE, 0, 1, 499), BASE);
+  CHECK_EQ(ledAnimColor(0, BASE, 0, 1, 500), 0xFF0000);
+  CHECK_EQ(ledAnimColor(0, BASE, 0, 1, 500 + LED_ANIM_BEAT_ON_MS), BASE);
+
+  // Start shows at once, then one redraw per frame
+  CHECK_EQ(ledAnimTick(0), 1);
+  CHECK_EQ(ledAnimTick(5), 0);
+  CHECK_EQ(ledAnimTick(LED_ANIM_FRAME_MS - 1), 0);
+  CHECK_EQ(ledAnimTick(LED_ANIM_FRAME_MS), 1);
+  CHECK_EQ(ledAnimTick(LED_ANIM_FRAME_MS + 1), 0);
+
+  // Restarting the running loop keeps its phase
+  ledAnimStart(0, LED_ANIM_BEAT, 0xFF0000, 0, 0, 250);
+  CHECK_EQ(ledAnimColor(0, BASE, 0, 1, 260), BASE);
+  CHECK_EQ(ledAnimColor(0, BASE, 0, 1, 500), 0xFF0000);
+
+  // Tempo change moves the beat
+  ledAnimSetTempo(1000, 1000);
+  CHECK_EQ(ledAnimColor(0, BASE, 0, 1, 1500), BASE);
+  CHECK_EQ(ledAnimColor(0, BASE, 0, 1, 2000), 0xFF0000);
+
+  // Fade: full color at the start, falling, gone after durationMs
+  ledAnimStart(1, LED_ANIM_FADE, 0xFFFFFF, 0, 100, 2000);
+  CHECK(ledAnimActive(1));
+  CHECK_EQ(ledAnimColor(1, 0, 0, 1, 2000), 0xFFFFFF);
+  uint32_t prev = 0xFFFFFF;
+  for (uint32_t t = 2020; t < 2100; t += 20) {
+    uint32_t c = ledAnimColor(1, 0, 0, 1, t);
+    CHECK(c < prev && c > 0);
+    prev = c;
+  }
+  ledAnimTick(2100);
+  CHECK_EQ(ledAnimColor(1, 0, 0, 1, 2100), 0);
+  ledAnimTick(2120);
+  CHECK(!ledAnimActive(1));
+
+  // Flash: the color for durationMs, then the base again
+  ledAnimStart(4, LED_ANIM_FLASH, 0x0000FF, 0, 60, 3000);
+  CHECK(ledAnimTick(3000) & (1 << 4)); // Shows without waiting a frame
+  CHECK_EQ(ledAnimColor(4, BASE, 0, 1, 3059), 0x0000FF);
+  CHECK_EQ(ledAnimColor(4, BASE, 0, 1, 3060), BASE);
+
+  // Chase: exactly one of four pixels lit, moving forward each quarter
+  ledAnimStart(2, LED_ANIM_CHASE, 0x00FF00, 400, 0, 0);
+  for (uint32_t t = 0; t < 400; t += 50) {
+    int lit = 0, at = -1;
+    for (int p = 0; p < 4; p++) {
+      if (ledAnimColor(2, 0, p, 4, t)) {
+        lit++;
+        at = p;
+      }
+    }
+    CHECK_EQ(lit, 1);
+    CHECK_EQ(at, (int)(t / 100));
+  }
+
+  // Pulse: dark at the ends of the period, full in the middle
+  ledAnimStart(3, LED_ANIM_PULSE, 0xFF0000, 1000, 0, 0);
+  CHECK_EQ(ledAnimColor(3, 0, 0, 1, 0), 0);
+  CHECK(ledAnimColor(3, 0, 0, 1, 500) >= 0xFE0000);
+  CHECK(ledAnimColor(3, 0, 0, 1, 250) < ledAnimColor(3, 0, 0, 1, 500));
+  CHECK(ledAnimColor(3, 0, 0, 1, 750) < ledAnimColor(3, 0, 0, 1, 500));
+
+  // Stop drops both layers
+  ledAnimStop(3);
+  CHECK(!ledAnimActive(3));
+  CHECK_EQ(ledAnimColor(3, BASE, 0, 1, 500), BASE);
+  CHECK_EQ(ledAnimLoopType(3), LED_ANIM_NONE);
+
+  return hostTestResult();
+}
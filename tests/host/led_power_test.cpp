@@ -0,0 +1,82 @@
+#include "HostTest.h"
+#include "LedPower.h"
+
+// LedPower limiter math (user-044): gamma/brightness LUT, budget clamping
+// and the guarantee that a limited frame never estimates above the budget.
+
+static uint32_t channelSum(const uint32_t *frame, int count) {
+  uint32_t sum = 0;
+  for (int i = 0; i < count; i++)
+    sum += (frame[i] & 0xFF) + ((frame[i] >> 8) & 0xFF) + (frame[i] >> 16);
+  return sum;
+}
+
+static void fill(uint32_t *frame, int count, uint32_t color) {
+  for (int i = 0; i < count; i++)
+    frame[i] = color;
+}
+
+int main() {
+  uint32_t f[16];
+
+  // Budget setting range
+  CHECK_EQ(ledPowerClampBudget(0), 0);
+  CHECK_EQ(ledPowerClampBudget(-5), 0);
+  CHECK_EQ(ledPowerClampBudget(10), LED_POWER_MIN_MA);
+  CHECK_EQ(ledPowerClampBudget(400), 400);
+  CHECK_EQ(ledPowerClampBudget(9999), LED_POWER_MAX_MA);
+
+  // Full brightness: gamma keeps the ends, small levels stay visible
+  ledPowerSetBrightness(255);
+  fill(f, 16, 0xFF0100);
+  ledPowerApply(f, 16, 0);
+  CHECK_EQ(f[0], 0xFF0100);
+  CHECK_EQ(ledPowerStats.lastScale, 256);
+
+  // Mid level is darkened by gamma, but not to black
+  fill(f, 16, 0x808080);
+  ledPowerApply(f, 16, 0);
+  CHECK((f[0] & 0xFF) > 1 && (f[0] & 0xFF) < 0x40);
+
+  // All white over a 400 mA budget is scaled down to within it
+  uint32_t limitedBefore = ledPowerStats.limited;
+  fill(f, 16, 0xFFFFFF);
+  ledPowerApply(f, 16, 400);
+  CHECK(ledPowerStats.lastScale < 256);
+  CHECK(ledPowerStats.lastMa > 400);
+  CHECK_EQ(ledPowerStats.limited, limitedBefore + 1);
+  CHECK(ledPowerEstimateMa(channelSum(f, 16), 16) <= 400);
+
+  // A frame under budget is left alone
+  fill(f, 16, 0x140000);
+  ledPowerApply(f, 16, 400);
+  CHECK_EQ(ledPowerStats.lastScale, 256);
+
+  // Scale never lets the estimate exceed the budget
+  for (uint32_t s = 1; s < 16 * 765; s += 7) {
+    for (int b = LED_POWER_MIN_MA; b < 1000; b += 37) {
+      uint16_t sc = ledPowerScale(s, 16, b);
+      CHECK(sc <= 256);
+      if (sc < 256)
+        CHECK(ledPowerEstimateMa(s * sc / 256, 16) <= (uint32_t)b);
+    }
+  }
+
+  // Dim master brightness: non-zero levels keep duty 1
+  ledPowerSetBrightness(1);
+  fill(f, 16, 0x010101);
+  ledPowerApply(f, 16, 0);
+  CHECK_EQ(f[0], 0x010101);
+  fill(f, 16, 0x000000);
+  ledPowerApply(f, 16, 0);
+  CHECK_EQ(f[0], 0);
+
+  // Master brightness 0 turns every level off
+  ledPowerSetBrightness(0);
+  fill(f, 16, 0xFFFFFF);
+  ledPowerApply(f, 16, 0);
+  for (int i = 0; i < 16; i++)
+    CHECK_EQ(f[i], 0);
+
+  return hostTestResult();
+}
@@ -0,0 +1,102 @@
+#include "HostTest.h"
+#include "Globals.h"
+#include "LedPower.h"
+#include "LedSegments.h"
+#include "LedTask.h"
+#include <chrono>
+
+// LED segments (user-045): text parsing and legacy fallback, and the
+// throughput of filling a 300-LED strip through the segment table and
+// the LED output path.
+
+#define BENCH_FRAMES 2000
+
+int main() {
+  LedRange r[LED_SEG_MAX_PER_OWNER];
+
+  // Legacy layout: one LED per button from ledMap
+  systemConfig.ledsPerButton = 1;
+  systemConfig.ledMap[2] = 7;
+  CHECK(ledSegmentsParse(""));
+  CHECK(!ledSegmentsCustom());
+  CHECK_EQ(ledSegmentsOf(2, r, LED_SEG_MAX_PER_OWNER), 1);
+  CHECK_EQ(r[0].start, 7);
+
+  // Custom table; owners are 1-based, case and spaces are tolerated
+  CHECK(ledSegmentsParse("B1:0-9,40-49;b2:10 ; A1:20-39;"));
+  CHECK(ledSegmentsCustom());
+  CHECK_EQ(ledSegmentsOf(0, r, LED_SEG_MAX_PER_OWNER), 2);
+  CHECK_EQ(r[1].start, 40);
+  CHECK_EQ(r[1].count, 10);
+  CHECK_EQ(ledSegmentsOf(1, r, LED_SEG_MAX_PER_OWNER), 1);
+  CHECK_EQ(r[0].count, 1);
+  CHECK_EQ(ledSegmentsOf(2, r, LED_SEG_MAX_PER_OWNER), 0); // Unlisted: dark
+  CHECK_EQ(ledSegmentsOf(LED_SEG_ANALOG, r, LED_SEG_MAX_PER_OWNER), 1);
+  CHECK_EQ(r[0].count, 20);
+
+  // Errors leave the table as it was
+  CHECK(!ledSegmentsParse("B1:0-300"));
+  CHECK(!ledSegmentsParse("C1:0"));
+  CHECK(!ledSegmentsParse("B1:5-2"));
+  CHECK_EQ(ledSegmentsOf(0, r, LED_SEG_MAX_PER_OWNER), 2);
+
+  // The longest table the limits allow still fits the text buffer: every
+  // owner with the widest indices, the first ones with two ranges
+  char full[LED_SEG_TEXT_LEN];
+  size_t fullLen = 0;
+  int ranges = 0;
+  for (int o = 0; o < LED_SEG_OWNERS && fullLen < sizeof(full); o++) {
+    int n = o < LED_MAX_SEGMENTS - LED_SEG_OWNERS ? 2 : 1;
+    fullLen += snprintf(full + fullLen, sizeof(full) - fullLen, "%c%d:",
+                        o < MAX_BUTTONS ? 'B' : 'A',
+                        (o < MAX_BUTTONS ? o : o - MAX_BUTTONS) + 1);
+    for (int i = 0; i < n && fullLen < sizeof(full); i++, ranges++)
+      fullLen += snprintf(full + fullLen, sizeof(full) - fullLen, "%d-%d%c",
+                          100 + i, 299, i + 1 < n ? ',' : ';');
+  }
+  CHECK_EQ(ranges, LED_MAX_SEGMENTS);
+  CHECK(fullLen < sizeof(full));
+  CHECK(ledSegmentsParse(full));
+
+  // 300 LEDs: ten buttons with three 10-LED ranges each
+  char text[LED_SEG_TEXT_LEN];
+  size_t len = 0;
+  for (int b = 0; b < 10 && len < sizeof(text); b++)
+    len += snprintf(text + len, sizeof(text) - len, "B%d:%d-%d,%d-%d,%d-%d;",
+                    b + 1, b * 10, b * 10 + 9, 100 + b * 10, 109 + b * 10,
+                    200 + b * 10, 209 + b * 10);
+  CHECK(len < sizeof(text));
+  CHECK(ledSegmentsParse(text));
+
+  strip.updateLength(MAX_LEDS);
+  startLedTask(MAX_LEDS); // No task on the host: ledShow() pushes inline
+  ledSetBrightness(255);
+  ledPowerBudgetMa = 0;
+
+  CHECK_EQ(ledSegmentsFill(3, 0x00FF00), 30);
+  ledShow();
+  CHECK_EQ(strip.getPixelColor(30), 0x00FF00);
+  CHECK_EQ(strip.getPixelColor(139), 0x00FF00);
+  CHECK_EQ(strip.getPixelColor(239), 0x00FF00);
+  CHECK_EQ(strip.getPixelColor(240), 0);
+
+  // Full-strip frames: every owner filled, then the gamma/limit pass and
+  // the strip copy. Must stay far inside the LED frame on the host.
+  ledPowerBudgetMa = LED_POWER_DEFAULT_MA;
+  uint32_t showsBefore = strip.shows;
+  auto t0 = std::chrono::steady_clock::now();
+  for (int f = 0; f < BENCH_FRAMES; f++) {
+    for (int b = 0; b < 10; b++)
+      ledSegmentsFill(b, 0x203040 * ((f + b) & 7));
+    ledShow();
+  }
+  double us = std::chrono::duration<double, std::micro>(
+                  std::chrono::steady_clock::now() - t0)
+                  .count() /
+              BENCH_FRAMES;
+  printf("300-LED segment frame: %.1f us on the host\n", us);
+  CHECK_EQ(strip.shows - showsBefore, BENCH_FRAMES);
+  CHECK(us < LED_MIN_FRAME_MS * 1000 / 10);
+
+  return hostTestResult();
+}
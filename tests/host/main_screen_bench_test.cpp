@@ -0,0 +1,63 @@
+#include "HostTest.h"
+#include "DisplayCapture.h"
+#include "Globals.h"
+#include "Storage.h"
+#include "UI_Display.h"
+#include <HostHal.h>
+#include <chrono>
+
+// Main screen CPU per frame (user-034): the compiled row layout against
+// re-parsing the row maps every frame (the pre-compile behavior, forced
+// with invalidateDisplayLayout()), on the OLED and the TFT palette frame.
+// Both must draw the same thing; timings are host figures for comparison.
+
+#define BENCH_FRAMES 2000
+
+// Host microseconds per displayOLED(); recompile = parse rows every frame
+static double bench(bool recompile) {
+  auto t0 = std::chrono::steady_clock::now();
+  for (int i = 0; i < BENCH_FRAMES; i++) {
+    if (recompile)
+      invalidateDisplayLayout();
+    currentBPM = 100.0f + (i & 7); // Keep the frame from being a no-op
+    displayOLED();
+  }
+  auto t1 = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::micro>(t1 - t0).count() /
+         BENCH_FRAMES;
+}
+
+int main() {
+  hostFsReset();
+  loadPresets(); // Factory presets
+  const OledType types[] = {OLED_128X64, TFT_128X160};
+
+  for (OledType type : types) {
+    oledConfig.type = type;
+    oledConfig.rotation = 0;
+    initDisplayHardware();
+    displayOLED();
+
+    DisplayProfile compiledProfile, parsedProfile;
+    uint32_t compiles = mainScreenStats.compiles;
+    double compiled = bench(false);
+    CHECK_EQ(mainScreenStats.compiles, compiles); // Plan reused
+    CHECK(profileDisplay(CAPTURE_MAIN, &compiledProfile));
+
+    compiles = mainScreenStats.compiles;
+    double parsed = bench(true);
+    CHECK_EQ(mainScreenStats.compiles, compiles + BENCH_FRAMES);
+    invalidateDisplayLayout();
+    CHECK(profileDisplay(CAPTURE_MAIN, &parsedProfile));
+
+    // Same screen either way
+    CHECK_EQ(compiledProfile.calls, parsedProfile.calls);
+    CHECK_EQ(compiledProfile.pixels, parsedProfile.pixels);
+    CHECK(compiledProfile.calls > 0);
+    printf("%s main screen: %.2f us/frame compiled, %.2f us/frame parsing "
+           "rows; %u draw calls, %u pixels per frame\n",
+           type == OLED_128X64 ? "OLED 128x64" : "TFT 128x160", compiled,
+           parsed, compiledProfile.calls, compiledProfile.pixels);
+  }
+  return hostTestResult();
+}
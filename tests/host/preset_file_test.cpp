@@ -0,0 +1,69 @@
+#include "HostTest.h"
+#include "PresetFixture.h"
+
+// TLV preset file (user-047): round trip of every record, and recovery
+// from a damaged, truncated or newer-firmware file.
+
+int main() {
+  const uint8_t check[] = "123456789";
+  CHECK_EQ(tlvCrc32(0, check, 9), 0xCBF43926u);
+
+  fillTestPresets();
+  PresetSnapshot want;
+  want.take();
+  MemFile file;
+  CHECK(writePresetFile(file, 1));
+  CHECK(file.bytes.size() < sizeof(buttonConfigs)); // Smaller than raw
+
+  // Round trip
+  clearPresets();
+  PresetFileResult r = readPresetFile(file);
+  CHECK(r.valid);
+  CHECK_EQ(r.version, PRESET_FILE_VERSION);
+  CHECK_EQ(r.damaged, 0);
+  CHECK_EQ(r.unknown, 0);
+  CHECK(!r.truncated);
+  CHECK_EQ(r.generation, 1);
+  CHECK_EQ(want.diff(), 0);
+  CHECK(strcmp(configProfileName, "prof") == 0);
+
+  // A flipped byte in the buttons section (the first one) only loses
+  // that section
+  MemFile corrupt = file;
+  corrupt.bytes[TLV_FILE_HEADER + TLV_SECTION_HEADER + 100] ^= 0xFF;
+  clearPresets();
+  r = readPresetFile(corrupt);
+  CHECK(r.valid);
+  CHECK_EQ(r.damaged, 1);
+  CHECK(strcmp(presetNames[2], "Preset 2") == 0);
+  CHECK(buttonConfigs[1][1].name[0] == 0);
+
+  // Cut short: what precedes the cut still loads
+  MemFile cut = file;
+  cut.bytes.resize(cut.bytes.size() - 5);
+  clearPresets();
+  r = readPresetFile(cut);
+  CHECK(r.truncated);
+  CHECK(r.sections >= 5);
+  CHECK(strcmp(buttonConfigs[3][7].name, "B3-7") == 0);
+
+  // A section from newer firmware is skipped, the rest still loads
+  MemFile newer = file;
+  uint8_t extra[TLV_SECTION_HEADER + 2] = {99, 2, 0, 0, 0, 0, 0, 0, 0, 1, 2};
+  uint32_t crc = tlvCrc32(0, extra + TLV_SECTION_HEADER, 2);
+  memcpy(extra + 5, &crc, 4);
+  newer.bytes.insert(newer.bytes.begin() + TLV_FILE_HEADER, extra,
+                     extra + sizeof(extra));
+  clearPresets();
+  r = readPresetFile(newer);
+  CHECK_EQ(r.unknown, 1);
+  CHECK_EQ(r.damaged, 0);
+  CHECK_EQ(want.diff(), 0);
+
+  // Not a preset file
+  MemFile other = file;
+  other.bytes[0] = 'X';
+  CHECK(!readPresetFile(other).valid);
+
+  return hostTestResult();
+}
@@ -0,0 +1,107 @@
+#include "HostTest.h"
+#include "PresetFixture.h"
+#include "Storage.h"
+#include <HostHal.h>
+#include <SPIFFS.h>
+
+// Incremental preset saves (user-049): bytes written per edit, replay on
+// boot, and a torn last entry at every byte.
+
+static size_t fileSize(const char *path) {
+  std::vector<uint8_t> *f = hostFsFile(path);
+  return f ? f->size() : 0;
+}
+
+// Bytes savePresets() appends to the log for the edit just made
+static size_t saveBytes() {
+  size_t before = fileSize("/presets.log");
+  savePresets();
+  return fileSize("/presets.log") - before;
+}
+
+int main() {
+  // Boot from a full save in slot A
+  hostFsReset();
+  fillTestPresets();
+  MemFile image;
+  writePresetFile(image, 1);
+  File a = SPIFFS.open("/presets_a.bin", FILE_WRITE);
+  a.write(image.bytes.data(), image.bytes.size());
+  a.close();
+  clearPresets();
+  loadPresets();
+  size_t slotBytes = fileSize("/presets_a.bin");
+  CHECK(slotBytes > 4000);
+
+  CHECK_EQ(saveBytes(), 0); // No change, no write
+  CHECK_EQ(fileSize("/presets_b.bin"), 0);
+
+  // One record per edit, each a small fraction of a full save
+  strcpy(buttonConfigs[2][5].name, "DRIVE");
+  size_t rename = saveBytes();
+  buttonConfigs[0][1].messages[0].data2 = 99;
+  size_t cc = saveBytes();
+  strcpy(presetNames[3], "Live");
+  size_t preset = saveBytes();
+  globalSpecialActions[4].hasCombo = !globalSpecialActions[4].hasCombo;
+  size_t special = saveBytes();
+  printf("slot %zu bytes; per edit: button %zu, cc %zu, preset %zu, "
+         "special %zu\n",
+         slotBytes, rename, cc, preset, special);
+  CHECK(rename > 0 && rename <= 160);
+  CHECK(cc > 0 && cc <= 160);
+  CHECK(preset > 0 && preset <= 100);
+  CHECK(special > 0 && special <= 100);
+  CHECK_EQ(fileSize("/presets_b.bin"), 0); // Still on slot A
+
+  // Reboot: slot + log give back the edited state
+  PresetSnapshot want;
+  want.take();
+  clearPresets();
+  loadPresets();
+  CHECK_EQ(want.diff(), 0);
+  CHECK_EQ(saveBytes(), 0); // Loaded state counts as saved
+
+  // Codec level: a log entry torn at any byte leaves the entries before
+  // it applied and the torn one ignored
+  fillTestPresets();
+  MemFile slot;
+  writePresetFile(slot, 1);
+  PresetCrcs saved, now;
+  PresetDirty dirty;
+  presetFileCrcs(&saved);
+  MemFile log;
+  strcpy(buttonConfigs[1][2].name, "ONE");
+  presetFileCrcs(&now);
+  presetFileDiff(saved, now, &dirty);
+  writePresetLogEntry(log, dirty, 1, true);
+  saved = now;
+  PresetSnapshot beforeTorn;
+  beforeTorn.take();
+
+  buttonConfigs[3][3].ledMode = (LedMode)!buttonConfigs[3][3].ledMode;
+  presetFileCrcs(&now);
+  CHECK_EQ(presetFileDiff(saved, now, &dirty), 1);
+  MemFile entry;
+  writePresetLogEntry(entry, dirty, 1, false);
+  int bad = 0;
+  for (size_t cut = 0; cut < entry.bytes.size(); cut++) {
+    MemFile torn = log;
+    torn.bytes.insert(torn.bytes.end(), entry.bytes.begin(),
+                      entry.bytes.begin() + cut);
+    clearPresets();
+    readPresetFile(slot);
+    PresetLogResult r = replayPresetLog(torn, 1);
+    bad += r.entries != 1 || beforeTorn.diff() != 0 || r.torn != (cut > 0);
+  }
+  CHECK_EQ(bad, 0);
+
+  // Entries written against another slot generation are not applied
+  clearPresets();
+  readPresetFile(slot);
+  PresetLogResult r = replayPresetLog(log, 2);
+  CHECK_EQ(r.entries, 0);
+  CHECK_EQ(r.stale, 1);
+
+  return hostTestResult();
+}
@@ -0,0 +1,132 @@
+#include "HostTest.h"
+#include "LedSegments.h"
+#include "SettingsCache.h"
+#include "Storage.h"
+#include <HostHal.h>
+
+// Write-behind NVS (user-050): NVS writes per user action, counted by the
+// in-memory Preferences.
+
+static uint32_t writes() { return hostNvsStats.writes; }
+
+// Let the virtual clock run with the loop calling settingsService()
+static void runFor(unsigned long ms) {
+  for (unsigned long t = 0; t < ms; t += 100) {
+    hostAdvanceMillis(100);
+    settingsService();
+  }
+}
+
+int main() {
+  hostNvsReset();
+  hostSetMillis(1000);
+  loadSystemSettings();
+  loadCurrentPresetIndex();
+  uint32_t base = writes();
+  CHECK_EQ(base, 0); // Boot writes nothing
+
+  // Unchanged save: nothing pending, nothing written
+  saveSystemSettings();
+  CHECK_EQ(settingsPending(), 0);
+  runFor(5000);
+  CHECK_EQ(writes(), base);
+
+  // Tap tempo rhythm change: one key, written once things go quiet
+  rhythmPattern = (rhythmPattern + 1) % 4;
+  saveSystemSettings();
+  CHECK_EQ(settingsPending(), 1);
+  runFor(SETTINGS_QUIET_MS - 500);
+  CHECK_EQ(writes(), base);
+  runFor(1000);
+  CHECK_EQ(writes(), base + 1);
+  CHECK_EQ(hostNvsKeyWrites("midi_presets", "s_rhythm"), 1);
+
+  // Ten preset switches 300 ms apart: one write of the last preset
+  base = writes();
+  for (int i = 1; i <= 10; i++) {
+    currentPreset = i % 4;
+    saveCurrentPresetIndex();
+    runFor(300);
+  }
+  runFor(SETTINGS_QUIET_MS + 500);
+  CHECK_EQ(writes(), base + 1);
+  currentPreset = -1;
+  loadCurrentPresetIndex();
+  CHECK_EQ(currentPreset, 10 % 4);
+
+  // Battery calibration changing every 5 s for 5 minutes: one lazy write
+  base = writes();
+  for (int i = 0; i < 60; i++) {
+    settingsPutInt("midi_presets", "s_batMax", 3000 + i, SETTINGS_LAZY);
+    runFor(5000);
+  }
+  CHECK_EQ(writes(), base + 1);
+  CHECK_EQ(hostNvsKeyWrites("midi_presets", "s_batMax"), 1);
+
+  // A normal batch takes pending lazy keys along
+  base = writes();
+  settingsPutInt("midi_presets", "s_batMax", 4000, SETTINGS_LAZY);
+  saveCurrentPresetIndex(); // Unchanged - no write
+  currentPreset = 1;
+  saveCurrentPresetIndex();
+  runFor(SETTINGS_QUIET_MS + 500);
+  CHECK_EQ(writes(), base + 2);
+
+  // NVS that cannot be opened: keys stay dirty and go out on the retry
+  base = writes();
+  currentPreset = 2;
+  saveCurrentPresetIndex();
+  hostNvsFailBegin = true;
+  runFor(SETTINGS_QUIET_MS + 500);
+  CHECK_EQ(writes(), base);
+  CHECK_EQ(settingsPending(), 1);
+  hostNvsFailBegin = false;
+  runFor(SETTINGS_QUIET_MS + 500);
+  CHECK_EQ(writes(), base + 1);
+
+  // settingsFlush() (before a restart) writes without waiting
+  base = writes();
+  currentPreset = 3;
+  saveCurrentPresetIndex();
+  settingsFlush();
+  CHECK_EQ(writes(), base + 1);
+  CHECK_EQ(settingsPending(), 0);
+
+  // A string that grows past its first value: written once, then skipped
+  saveSystemSettings(); // Settle the keys put directly above
+  settingsFlush();
+  base = writes();
+  strcpy(systemConfig.bleDeviceName, "ChocoNameOfMaximumLen");
+  saveSystemSettings();
+  settingsFlush();
+  CHECK_EQ(writes(), base + 1);
+  for (int i = 0; i < 5; i++) {
+    saveSystemSettings();
+    settingsFlush();
+  }
+  CHECK_EQ(writes(), base + 1);
+
+  // Same for the LED segment table, up to LED_SEG_TEXT_LEN
+  char segs[LED_SEG_TEXT_LEN];
+  size_t len = 0;
+  for (int b = 0; b < MAX_BUTTONS; b++)
+    len += snprintf(segs + len, sizeof(segs) - len, "%sB%d:%d-%d",
+                    b ? ";" : "", b + 1, b * 8, b * 8 + 7);
+  CHECK(len < sizeof(segs));
+  CHECK(ledSegmentsParse(segs));
+  CHECK(strlen(ledSegmentsText()) > 32);
+  base = writes();
+  saveSystemSettings();
+  settingsFlush();
+  CHECK_EQ(hostNvsKeyWrites("midi_presets", "s_ledSegs"), 1);
+  for (int i = 0; i < 5; i++) {
+    saveSystemSettings();
+    settingsFlush();
+  }
+  CHECK_EQ(writes(), base + 1);
+  CHECK_EQ(hostNvsKeyWrites("midi_presets", "s_ledSegs"), 1);
+  printf("Settings pool: %u / %u bytes, %u keys\n", settingsCacheStats.pool,
+         SETTINGS_POOL_BYTES, settingsCacheStats.keys);
+
+  return hostTestResult();
+}
@@ -0,0 +1,114 @@
+#include "HostTest.h"
+#include "AnalogInput.h"
+#include "SysexScrollData.h"
+#include <HostHal.h>
+#include <chrono>
+
+// SYSEX_SCROLL analog input (user-028): full pedal sweeps up and down
+// through a scroll list, read through readAnalogInputs() on the virtual
+// clock. Every list index is sent exactly once per pass, and a pedal
+// resting on an entry sends nothing more.
+
+#define PEDAL_PIN 34
+#define SWEEP_MS 8192 // One ADC count per read
+
+static void setup(SysexScrollParamId param, uint8_t hysteresis) {
+  AnalogInputConfig &cfg = analogInputs[0];
+  cfg.enabled = true;
+  cfg.pin = PEDAL_PIN;
+  cfg.emaAlpha = 1.0f;
+  cfg.hysteresis = hysteresis;
+  cfg.messageCount = 1;
+  ActionMessage &m = cfg.messages[0];
+  m.type = SYSEX_SCROLL;
+  m.data1 = param;
+  m.minInput = 0;
+  m.maxInput = 100;
+  m.minOut = 0;
+  m.maxOut = 127;
+  hostSetAnalog(PEDAL_PIN, 0);
+  setupAnalogInputs();
+}
+
+static int sweepUp(unsigned long t) {
+  return min(t * 4095 / (SWEEP_MS - 2), 4095UL); // Last read lands on 4095
+}
+static int sweepDown(unsigned long t) { return 4095 - sweepUp(t); }
+static int rest(unsigned long t) { return 2000 + (int)(t % 9) - 4; }
+
+// Steps the pedal through trace for ms; returns host CPU time in us
+static double run(int (*trace)(unsigned long), unsigned long ms) {
+  auto t0 = std::chrono::steady_clock::now();
+  for (unsigned long t = 0; t < ms; t++) {
+    hostSetAnalog(PEDAL_PIN, trace(t));
+    readAnalogInputs();
+    hostAdvanceMillis(1);
+  }
+  auto t1 = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::micro>(t1 - t0).count();
+}
+
+// List indices of the SysEx frames logged since from, matched by content
+// (-1 = not a list entry)
+static std::vector<int> sentIndices(const SysexScrollList *list,
+                                    size_t from) {
+  std::vector<int> out;
+  for (size_t i = from; i < hostMidiLog.size(); i++) {
+    const HostMidiEvent &e = hostMidiLog[i];
+    if (e.kind != HOST_MIDI_SYSEX)
+      continue;
+    int index = -1;
+    for (int k = 0; k < list->msgCount && index < 0; k++) {
+      size_t len;
+      const uint8_t *frame = getSysexScrollFrame(list, k, &len);
+      if (frame && len == e.a && memcmp(frame, e.data, len) == 0)
+        index = k;
+    }
+    out.push_back(index);
+  }
+  return out;
+}
+
+static void checkPass(const std::vector<int> &idx, int count, bool up) {
+  CHECK_EQ(idx.size(), up ? count : count - 1);
+  for (size_t i = 0; i < idx.size(); i++)
+    CHECK_EQ(idx[i], up ? (int)i : count - 2 - (int)i);
+}
+
+int main() {
+  hostSetMillis(10000);
+  const SysexScrollParamId params[] = {SYSEX_PARAM_RVB_MIX,
+                                       SYSEX_PARAM_PITCH_HIGH};
+
+  for (SysexScrollParamId param : params) {
+    const SysexScrollList *list = getSysexScrollList(param);
+    CHECK(list != nullptr);
+    if (!list)
+      continue;
+
+    // Hysteresis 0: every 7-bit step triggers, only index changes go out
+    setup(param, 0);
+    size_t from = hostMidiLog.size();
+    uint32_t emits = analogEmitCount;
+    double us = run(sweepUp, SWEEP_MS);
+    uint32_t triggers = analogEmitCount - emits;
+    std::vector<int> up = sentIndices(list, from);
+    checkPass(up, list->msgCount, true);
+    CHECK(triggers >= 128);
+
+    from = hostMidiLog.size();
+    us += run(sweepDown, SWEEP_MS);
+    checkPass(sentIndices(list, from), list->msgCount, false);
+    printf("SYSEX_SCROLL %d entries: %u triggers per sweep, %d + %d frames, "
+           "%.2f us per read\n",
+           list->msgCount, triggers, list->msgCount, list->msgCount - 1,
+           us / (2 * SWEEP_MS / ANALOG_READ_INTERVAL_MS));
+
+    // Resting with noise on one entry: nothing after the first frame
+    setup(param, DEFAULT_HYSTERESIS);
+    from = hostMidiLog.size();
+    run(rest, 2000);
+    CHECK_EQ(sentIndices(list, from).size(), 1);
+  }
+  return hostTestResult();
+}